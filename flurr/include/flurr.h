@@ -3,6 +3,9 @@
 #include "flurr/FlurrCore.h"
 #include "flurr/FlurrDefines.h"
 #include "flurr/FlurrLog.h"
+#include "flurr/renderer/FramePacket.h"
+#include "flurr/renderer/MeshOptimizer.h"
+#include "flurr/renderer/NullRenderBackend.h"
 #include "flurr/renderer/Renderer.h"
 #include "flurr/resource/ResourceManager.h"
 #include "flurr/resource/ShaderResource.h"
@@ -10,11 +13,15 @@
 #include "flurr/scene/Node.h"
 #include "flurr/scene/NodeComponent.h"
 #include "flurr/scene/CameraComponent.h"
+#include "flurr/scene/ModelComponent.h"
 #include "flurr/scene/SceneManager.h"
+#include "flurr/scene/StaticBatch.h"
 #include "flurr/utils/ConfigFile.h"
 #include "flurr/utils/FileUtils.h"
+#include "flurr/utils/FreeListAllocator.h"
 #include "flurr/utils/MathUtils.h"
 #include "flurr/utils/ObjectFactory.h"
+#include "flurr/utils/SlotMap.h"
 #include "flurr/utils/StringUtils.h"
 #include "flurr/utils/TimeUtils.h"
 #include "flurr/utils/TypeCasts.h"
@@ -1,16 +1,29 @@
 #pragma once
 
 #include "flurr/FlurrDefines.h"
+#include "flurr/renderer/FramePacket.h"
+#include "flurr/renderer/HeadlessContext.h"
 #include "flurr/renderer/Renderer.h"
 #include "flurr/resource/ResourceManager.h"
 #include "flurr/scene/SceneManager.h"
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <string>
+#include <thread>
 
 namespace flurr
 {
 
+/** Called on the render thread, e.g. to make the window's GL context current on start and present each frame. */
+struct RenderThreadCallbacks
+{
+  std::function<void()> onStart;
+  std::function<void()> onFrame; // after each frame packet has been rendered
+  std::function<void()> onStop;
+};
+
 class FLURR_DLL_EXPORT FlurrCore
 {
 
@@ -26,21 +39,48 @@ private:
 public:
 
   Status init(const std::string& a_configPath = "flurr.cfg");
+  Status initHeadless(uint32_t a_width, uint32_t a_height, const std::string& a_configPath = "flurr.cfg"); // creates its own context, renders offscreen
   void shutdown();
   Status update(float a_deltaTime);
   bool isInitialized() const { return m_initialized; }
+  bool isHeadless() const { return m_headlessContext && m_headlessContext->isCreated(); }
   ResourceManager* getResourceManager() const { return m_resourceManager.get(); }
   SceneManager* getSceneManager() const { return m_sceneManager.get(); }
   Renderer* getRenderer() const { return m_renderer.get(); }
+  FramePacket* getFramePacket(); // packet recorded this frame, submitted by the next update
+  RenderCommandList& getFrameCommandList() { return getFramePacket()->getCommandList(); }
+
+  /**
+   * Render thread mode: update records each frame into a frame packet and hands it to the render thread,
+   * then moves on to the next frame while the render thread submits it. The GL context must not be current
+   * on the calling thread, and the callbacks should make it current on the render thread.
+   * Renderer resources can only be created or destroyed while the render thread is stopped.
+   */
+  Status startRenderThread(const RenderThreadCallbacks& a_callbacks = RenderThreadCallbacks());
+  void stopRenderThread(); // renders frame packets already handed over, then joins the thread
+  bool isRenderThreadRunning() const { return m_renderThread.joinable(); }
 
   static FlurrCore& Get();
 
 private:
 
+  Status renderFramePacket(const FramePacket& a_framePacket);
+  void renderThread();
+
   bool m_initialized;
   std::unique_ptr<ResourceManager> m_resourceManager;
   std::unique_ptr<SceneManager> m_sceneManager;
   std::unique_ptr<Renderer> m_renderer;
+  std::unique_ptr<HeadlessContext> m_headlessContext;
+  // Frame packets
+  uint64_t m_frameIndex;
+  FramePacket* m_recordingPacket; // nullptr until first requested in a frame
+  FramePacket m_framePacket; // without a render thread
+  FramePacketExchange m_framePacketExchange; // with a render thread
+  // Render thread
+  std::thread m_renderThread;
+  RenderThreadCallbacks m_renderThreadCallbacks;
+  std::atomic<Status> m_renderThreadStatus; // last failure, reported by the next update
 };
 
 } // namespace flurr
@@ -24,17 +24,6 @@ namespace flurr
 using FlurrHandle = uint32_t;
 constexpr FlurrHandle INVALID_HANDLE = 0;
 
-// Generate an object handle given the next expected available object handle
-// and a function to check handle availability
-template <typename F>
-FlurrHandle GenerateHandle(FlurrHandle& a_nh, const F& a_hasObj)
-{
-  while (INVALID_HANDLE != a_nh && a_hasObj(a_nh) || INVALID_HANDLE == a_nh)
-    ++a_nh;
-
-  return a_nh;
-}
-
 // flurr status codes
 enum class Status : uint16_t
 {
@@ -77,6 +66,13 @@ constexpr Priority MIN_PRIORITY = 50;
 
 // Shader uniforms
 constexpr char* const MODEL_TRANSFORM_UNIFORM_NAME = "modelTransf";
-constexpr char* const VIEW_PROJECTION_TRANSFORM_UNIFORM_NAME = "viewProjTransf";
+constexpr char* const TEXTURE_LAYER_UNIFORM_NAME = "textureLayer"; // set for textures allocated in texture arrays
+constexpr char* const DRAW_PARAMS_UNIFORM_NAME = "drawParams"; // per-draw vec4, like the params of instanced draws
+constexpr char* const FRAME_UNIFORM_BLOCK_NAME = "FrameUniforms";
+constexpr uint32_t FRAME_UNIFORM_BLOCK_BINDING = 0;
+
+// Frame pacing
+constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 4;
+constexpr uint32_t DEFAULT_FRAMES_IN_FLIGHT = 2;
 
 } // namespace flurr
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+#include "flurr/renderer/RenderCommandList.h"
+#include "flurr/renderer/Renderer.h"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace flurr
+{
+
+/** Write into a vertex or index buffer, applied before the packet's draws. */
+struct FramePacketBufferUpdate
+{
+  FlurrHandle bufferHandle;
+  std::size_t offset; // in the buffer, in bytes
+  std::size_t dataOffset; // in the packet's update data, in bytes
+  std::size_t dataSize;
+};
+
+/**
+ * Everything the renderer needs to draw one frame: camera data, buffer updates and the draw list.
+ * Recorded by the simulation and copied by value, so it no longer refers to scene state once recorded.
+ */
+class FLURR_DLL_EXPORT FramePacket
+{
+
+public:
+
+  FramePacket();
+  FramePacket(const FramePacket&) = delete;
+  FramePacket(FramePacket&&) = default;
+  FramePacket& operator=(const FramePacket&) = delete;
+  FramePacket& operator=(FramePacket&&) = default;
+  ~FramePacket() = default;
+
+  void reset(uint64_t a_frameIndex); // keeps capacity, so packets can be reused every frame
+  uint64_t getFrameIndex() const { return m_frameIndex; }
+  float getDeltaTime() const { return m_deltaTime; }
+  void setDeltaTime(float a_deltaTime) { m_deltaTime = a_deltaTime; }
+
+  bool hasFrameUniforms() const { return m_hasFrameUniforms; }
+  const FrameUniforms& getFrameUniforms() const { return m_frameUniforms; }
+  void setFrameUniforms(const FrameUniforms& a_frameUniforms);
+  bool hasViewport() const { return m_viewport.z > 0 && m_viewport.w > 0; }
+  const glm::ivec4& getViewport() const { return m_viewport; }
+  void setViewport(int a_x, int a_y, uint32_t a_width, uint32_t a_height);
+
+  void addBufferUpdate(FlurrHandle a_bufferHandle, const void* a_data, std::size_t a_dataSize, std::size_t a_offset);
+  std::size_t getBufferUpdateCount() const { return m_bufferUpdates.size(); }
+  const FramePacketBufferUpdate& getBufferUpdate(std::size_t a_updateIndex) const { return m_bufferUpdates[a_updateIndex]; }
+  const uint8_t* getBufferUpdateData(const FramePacketBufferUpdate& a_update) const { return m_bufferUpdateData.data() + a_update.dataOffset; }
+
+  RenderCommandList& getCommandList() { return m_commandList; }
+  const RenderCommandList& getCommandList() const { return m_commandList; }
+
+private:
+
+  uint64_t m_frameIndex;
+  float m_deltaTime;
+  bool m_hasFrameUniforms;
+  FrameUniforms m_frameUniforms;
+  glm::ivec4 m_viewport; // zero size if unchanged
+  std::vector<FramePacketBufferUpdate> m_bufferUpdates;
+  std::vector<uint8_t> m_bufferUpdateData;
+  RenderCommandList m_commandList;
+};
+
+/**
+ * Lock-free hand-off of frame packets from a single writer (simulation) thread to a single reader (render) thread.
+ * Packets are double buffered: the writer records frame N+1 while the reader renders frame N,
+ * and cannot get further ahead than that. Polling is lock-free, waiting threads sleep on a condition variable.
+ */
+class FLURR_DLL_EXPORT FramePacketExchange
+{
+
+public:
+
+  static constexpr std::size_t kPacketCount = 2;
+
+  FramePacketExchange();
+  FramePacketExchange(const FramePacketExchange&) = delete;
+  FramePacketExchange(FramePacketExchange&&) = delete;
+  FramePacketExchange& operator=(const FramePacketExchange&) = delete;
+  FramePacketExchange& operator=(FramePacketExchange&&) = delete;
+  ~FramePacketExchange() = default;
+
+  FramePacket* beginWrite(); // nullptr while the reader still owns all packets
+  FramePacket* waitWrite(); // blocks until the reader returns a packet
+  void endWrite(); // publishes the packet to the reader
+  FramePacket* beginRead(); // oldest published packet, or nullptr if there is none
+  FramePacket* waitRead(); // blocks until a packet is published, nullptr once closed and all packets are read
+  void endRead(); // returns the packet to the writer
+  void close(); // wakes the reader, no packets are published afterwards
+  void reset(); // only while neither thread is using the exchange
+
+private:
+
+  void notifyWaiters();
+
+  std::array<FramePacket, kPacketCount> m_packets;
+  std::atomic<uint64_t> m_writeCount; // packets published
+  std::atomic<uint64_t> m_readCount; // packets returned
+  std::mutex m_waitMutex;
+  std::condition_variable m_waitCondition;
+  bool m_closed; // guarded by m_waitMutex
+};
+
+} // namespace flurr
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+#include "flurr/renderer/VertexBuffer.h"
+#include "flurr/renderer/VertexLayout.h"
+#include "flurr/utils/FreeListAllocator.h"
+#include "flurr/utils/SlotMap.h"
+
+#include <GL/glew.h>
+
+#include <vector>
+
+namespace flurr
+{
+
+class RenderBackend;
+
+/** Mesh sub-allocated from a geometry arena; indices are relative to firstVertex. */
+struct ArenaMesh
+{
+  std::size_t firstVertex;
+  std::size_t vertexCount;
+  std::size_t firstIndex;
+  std::size_t indexCount;
+};
+
+/**
+ * Large shared vertex and index buffer for meshes with the same vertex format.
+ * Meshes are sub-allocated from free lists and drawn with base-vertex draws
+ * from a single VAO, so no buffers or VAOs are rebound between meshes.
+ * The vertex layout must have a single (interleaved) stream.
+ * Mesh bookkeeping is done here, GPU uploads, copies and draws go through the render backend.
+ */
+class FLURR_DLL_EXPORT GeometryArena
+{
+  friend class Renderer;
+  friend class OGLRenderBackend;
+
+public:
+
+  GeometryArena(FlurrHandle a_arenaHandle, RenderBackend* a_backend);
+  GeometryArena(const GeometryArena&) = delete;
+  GeometryArena(GeometryArena&&) = default;
+  GeometryArena& operator=(const GeometryArena&) = delete;
+  GeometryArena& operator=(GeometryArena&&) = default;
+  ~GeometryArena() = default;
+
+  FlurrHandle getArenaHandle() const { return m_arenaHandle; }
+  const VertexLayout& getVertexLayout() const { return m_vertexLayout; }
+  std::size_t getVertexStride() const { return m_vertexStride; }
+  IndexType getIndexType() const { return m_indexType; }
+  std::size_t getVertexCapacity() const { return m_vertexAllocator.getCapacity(); }
+  std::size_t getIndexCapacity() const { return m_indexAllocator.getCapacity(); }
+  std::size_t getFreeVertexCount() const { return m_vertexAllocator.getFreeSize(); }
+  std::size_t getFreeIndexCount() const { return m_indexAllocator.getFreeSize(); }
+  bool isCreated() const { return getVertexCapacity() > 0; }
+
+  Status addMesh(FlurrHandle& a_meshHandle, const void* a_vertexData, std::size_t a_vertexCount, const uint32_t* a_indexData, std::size_t a_indexCount);
+  void removeMesh(FlurrHandle a_meshHandle);
+  bool hasMesh(FlurrHandle a_meshHandle) const { return m_meshes.contains(a_meshHandle); }
+  const ArenaMesh* getMesh(FlurrHandle a_meshHandle) const { return m_meshes.get(a_meshHandle); }
+  std::size_t getMeshCount() const { return m_meshes.size(); }
+  std::vector<FlurrHandle> getMeshHandles() const { return m_meshes.getHandles(); }
+  Status defragment(); // pack all meshes at the start of the buffers
+  Status drawMesh(FlurrHandle a_meshHandle);
+  Status drawMeshes(const std::vector<FlurrHandle>& a_meshHandles); // single multi-draw call
+
+  GLuint getOGLVertexArrayObjectId() const { return m_oglVaoId; }
+  GLuint getOGLVertexBufferObjectId() const { return m_oglVboId; }
+  GLuint getOGLIndexBufferObjectId() const { return m_oglIboId; }
+
+private:
+
+  // Validate layout and capacities and keep them, without touching the GPU
+  Status setArenaProperties(const VertexLayout& a_vertexLayout, std::size_t a_vertexCapacity, std::size_t a_indexCapacity, IndexType a_indexType);
+  Status initArena();
+  void destroyArena();
+  Status uploadMesh(const ArenaMesh& a_mesh, const void* a_vertexData, const uint32_t* a_indexData);
+  Status copyMeshes(const std::vector<ArenaMesh>& a_packedMeshes); // packed ranges in mesh order
+  Status drawOGLMesh(const ArenaMesh& a_mesh);
+  Status drawOGLMeshes(const std::vector<FlurrHandle>& a_meshHandles);
+  void setVertexArrayBuffers();
+  std::size_t getIndexSize() const { return IndexType::kUnsigned16 == m_indexType ? sizeof(uint16_t) : sizeof(uint32_t); }
+  GLenum getOGLIndexType() const { return IndexType::kUnsigned16 == m_indexType ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT; }
+
+  FlurrHandle m_arenaHandle;
+  RenderBackend* m_backend;
+  VertexLayout m_vertexLayout;
+  std::size_t m_vertexStride;
+  IndexType m_indexType;
+  FreeListAllocator m_vertexAllocator;
+  FreeListAllocator m_indexAllocator;
+  SlotMap<ArenaMesh> m_meshes;
+
+  // Multi-draw scratch arrays
+  std::vector<GLsizei> m_drawIndexCounts;
+  std::vector<const void*> m_drawIndexOffsets;
+  std::vector<GLint> m_drawBaseVertices;
+
+  GLuint m_oglVboId;
+  GLuint m_oglIboId;
+  GLuint m_oglVaoId;
+};
+
+} // namespace flurr
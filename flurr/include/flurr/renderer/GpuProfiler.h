@@ -0,0 +1,121 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+
+#include <GL/glew.h>
+
+#include <array>
+#include <vector>
+
+#define FLURR_GPU_ZONE_CONCAT_IMPL(a, b) a##b
+#define FLURR_GPU_ZONE_CONCAT(a, b) FLURR_GPU_ZONE_CONCAT_IMPL(a, b)
+#define FLURR_GPU_ZONE(profiler, name) \
+  flurr::GpuProfileScope FLURR_GPU_ZONE_CONCAT(gpuProfileScope, __LINE__)(profiler, name)
+
+namespace flurr
+{
+
+/** GPU time measured for a zone, in a frame some frames back. */
+struct GpuZoneTiming
+{
+  const char* name; // must be a string literal or otherwise outlive the profiler
+  uint32_t depth; // nesting level, 0 = top level
+  double timeMs;
+};
+
+/**
+ * Measures GPU time of nested zones with timestamp queries (glQueryCounter).
+ * Each frame writes into its own set of query objects from a ring, and results are
+ * read back kFrameLatency frames later, so the CPU does not wait for the GPU.
+ * OpenGL only; left uninitialized (and inert) when the render backend has no GPU context.
+ */
+class FLURR_DLL_EXPORT GpuProfiler
+{
+
+public:
+
+  static constexpr uint32_t kFrameLatency = 3;
+
+  GpuProfiler();
+  GpuProfiler(const GpuProfiler&) = delete;
+  GpuProfiler(GpuProfiler&&) = delete;
+  GpuProfiler& operator=(const GpuProfiler&) = delete;
+  GpuProfiler& operator=(GpuProfiler&&) = delete;
+  ~GpuProfiler() = default;
+
+  void init();
+  void shutdown();
+  void beginFrame();
+  void endFrame();
+  void beginZone(const char* a_zoneName);
+  void endZone();
+
+  bool isEnabled() const { return m_enabled; }
+  void setEnabled(bool a_enabled) { m_enabled = a_enabled; }
+  uint32_t getLogInterval() const { return m_logInterval; }
+  void setLogInterval(uint32_t a_logInterval) { m_logInterval = a_logInterval; } // in frames, 0 = never log
+  const std::vector<GpuZoneTiming>& getZoneTimings() const { return m_zoneTimings; } // latest available frame
+  double getZoneTimeMs(const char* a_zoneName) const; // sum over zones with the name, 0 if not found
+  uint64_t getTimingsFrameIndex() const { return m_timingsFrameIndex; }
+  void logZoneTimings() const;
+
+private:
+
+  struct Zone
+  {
+    const char* name;
+    uint32_t depth;
+    uint32_t beginQueryIndex;
+    uint32_t endQueryIndex;
+  };
+
+  struct FrameQueries
+  {
+    uint64_t frameIndex = 0;
+    std::vector<GLuint> oglQueryIds;
+    uint32_t usedQueryCount = 0;
+    std::vector<Zone> zones;
+    bool pending = false; // results not read back yet
+  };
+
+  uint32_t issueTimestampQuery();
+  void readFrameResults(FrameQueries& a_frame);
+
+  bool m_initialized;
+  bool m_enabled;
+  bool m_frameActive;
+  uint32_t m_logInterval;
+  uint64_t m_frameIndex;
+  std::array<FrameQueries, kFrameLatency> m_frames;
+  std::vector<uint32_t> m_openZoneIndices;
+  std::vector<GpuZoneTiming> m_zoneTimings;
+  uint64_t m_timingsFrameIndex;
+  std::vector<GLuint64> m_queryResults;
+};
+
+/** Times the GPU work issued during its lifetime as a profiler zone. */
+class GpuProfileScope
+{
+
+public:
+
+  GpuProfileScope(GpuProfiler& a_profiler, const char* a_zoneName)
+    : m_profiler(a_profiler)
+  {
+    m_profiler.beginZone(a_zoneName);
+  }
+
+  GpuProfileScope(const GpuProfileScope&) = delete;
+  GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+  ~GpuProfileScope()
+  {
+    m_profiler.endZone();
+  }
+
+private:
+
+  GpuProfiler& m_profiler;
+};
+
+} // namespace flurr
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+
+namespace flurr
+{
+
+/**
+ * OpenGL context without a window, created through EGL (build with FLURR_HEADLESS_EGL and link libEGL).
+ * Prefers the Mesa surfaceless platform and EGL_KHR_surfaceless_context, so it runs on machines
+ * without a display server or GPU (e.g. llvmpipe); otherwise falls back to a 1x1 pbuffer surface.
+ * The default framebuffer is not usable for rendering, so draws go to the renderer's offscreen framebuffer.
+ */
+class FLURR_DLL_EXPORT HeadlessContext
+{
+
+public:
+
+  HeadlessContext();
+  HeadlessContext(const HeadlessContext&) = delete;
+  HeadlessContext(HeadlessContext&&) = delete;
+  HeadlessContext& operator=(const HeadlessContext&) = delete;
+  HeadlessContext& operator=(HeadlessContext&&) = delete;
+  ~HeadlessContext();
+
+  Status init(int a_glMajorVersion = 3, int a_glMinorVersion = 3); // creates a core profile context and makes it current
+  void shutdown();
+  bool isCreated() const { return nullptr != m_eglContext; }
+  bool isSurfaceless() const { return isCreated() && nullptr == m_eglSurface; }
+  Status makeCurrent();
+
+private:
+
+  // EGL handles (EGLDisplay, EGLContext, EGLSurface), kept opaque so EGL headers stay out of the public API
+  void* m_eglDisplay;
+  void* m_eglContext;
+  void* m_eglSurface;
+};
+
+} // namespace flurr
@@ -2,6 +2,9 @@
 
 #include "flurr/FlurrDefines.h"
 #include "flurr/renderer/VertexBuffer.h"
+#include "flurr/renderer/VertexLayout.h"
+
+#include <glm/glm.hpp>
 
 #include <memory>
 #include <vector>
@@ -9,9 +12,25 @@
 namespace flurr
 {
 
+// Per-instance vertex attributes; an instance buffer may omit trailing members,
+// so its attribute size must be sizeof(InstanceData), or end after color or modelTransf
+struct InstanceData
+{
+  glm::mat4 modelTransf;
+  glm::vec4 color;
+  glm::vec4 params;
+};
+static_assert(sizeof(InstanceData) == 24 * sizeof(float), "InstanceData must be tightly packed!");
+
+// Vertex attribute locations of per-instance data (the transform takes up 4 locations)
+constexpr GLuint INSTANCE_TRANSFORM_ATTRIBUTE_LOCATION = 8;
+constexpr GLuint INSTANCE_COLOR_ATTRIBUTE_LOCATION = 12;
+constexpr GLuint INSTANCE_PARAMS_ATTRIBUTE_LOCATION = 13;
+
 class FLURR_DLL_EXPORT IndexedGeometry
 {
   friend class Renderer;
+  friend class OGLRenderBackend;
 
 public:
 
@@ -26,22 +45,32 @@ public:
   VertexBuffer* getAttributeBuffer(std::size_t a_attributeIndex) const;
   std::size_t getAttributeBuffersCount() const { return m_attributeBufferHandles.size(); }
   VertexBuffer* getIndexBuffer() const;
+  const VertexLayout& getVertexLayout() const { return m_vertexLayout; }
+  std::size_t getVertexCount() const { return m_vertexCount; }
+  FlurrHandle getInstanceBufferHandle() const { return m_instanceBufferHandle; }
   bool isGeometryInitialized() const { return m_geometryInitialized; }
 
   GLuint getOGLVertexArrayObjectId() const { return m_oglVaoId; }
 
 private:
 
-  Status initGeometry(const std::vector<FlurrHandle>& a_attributeBufferHandles, FlurrHandle a_indexBufferHandle);
+  // Validate buffers and layout and keep them, without touching the GPU
+  Status setBuffers(const std::vector<FlurrHandle>& a_attributeBufferHandles, const std::vector<const VertexBuffer*>& a_attributeBuffers,
+    FlurrHandle a_indexBufferHandle, const VertexBuffer& a_indexBuffer, const VertexLayout* a_vertexLayout = nullptr);
+  Status initGeometry();
   void destroyGeometry();
   Status drawGeometry();
-  Status addAttributeBuffer(FlurrHandle a_bufferHandle);
-  Status setIndexBuffer(FlurrHandle a_bufferHandle);
+  Status drawGeometryInstanced(FlurrHandle a_instanceBufferHandle, uint32_t a_instanceCount);
+  Status setInstanceBuffer(FlurrHandle a_bufferHandle);
+  std::size_t getStreamStride(uint32_t a_streamIndex) const;
 
   FlurrHandle m_geometryHandle;
   bool m_geometryInitialized;
   std::vector<FlurrHandle> m_attributeBufferHandles;
+  VertexLayout m_vertexLayout;
+  std::size_t m_vertexCount;
   FlurrHandle m_indexBufferHandle;
+  FlurrHandle m_instanceBufferHandle; // instance buffer attached to the VAO
 
   GLuint m_oglVaoId;
 };
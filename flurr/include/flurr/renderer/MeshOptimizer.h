@@ -0,0 +1,71 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+
+#include <vector>
+
+namespace flurr
+{
+
+constexpr uint32_t DEFAULT_VERTEX_CACHE_SIZE = 16;
+constexpr float DEFAULT_OVERDRAW_THRESHOLD = 1.05f; // max. ACMR increase allowed by overdraw optimization
+
+/** Post-transform vertex cache efficiency of a triangle list, simulated with a FIFO cache. */
+struct VertexCacheStats
+{
+  uint32_t vertexTransformCount = 0; // cache misses
+  float acmr = 0.0f; // average cache miss ratio (transforms per triangle, 0.5 - 3)
+  float atvr = 0.0f; // average transform to vertex ratio (transforms per referenced vertex, >= 1)
+};
+
+/** Attribute buffer of a mesh, reordered along with the indices. */
+struct MeshVertexStream
+{
+  void* data;
+  std::size_t vertexSize; // in bytes
+};
+
+struct MeshOptimizationSettings
+{
+  bool optimizeVertexCache = true;
+  bool optimizeOverdraw = true; // requires positions
+  bool optimizeVertexFetch = true;
+  uint32_t vertexCacheSize = DEFAULT_VERTEX_CACHE_SIZE;
+  float overdrawThreshold = DEFAULT_OVERDRAW_THRESHOLD;
+  std::size_t positionStreamIndex = 0; // stream with float XYZ positions
+  std::size_t positionOffset = 0; // in bytes, from the start of the vertex
+};
+
+struct MeshOptimizationStats
+{
+  VertexCacheStats statsBefore;
+  VertexCacheStats statsAfter;
+  std::size_t vertexCountBefore = 0;
+  std::size_t vertexCountAfter = 0;
+};
+
+FLURR_DLL_EXPORT VertexCacheStats AnalyzeVertexCache(const uint32_t* a_indices, std::size_t a_indexCount, std::size_t a_vertexCount, uint32_t a_cacheSize = DEFAULT_VERTEX_CACHE_SIZE);
+
+/** Reorder triangles for the post-transform vertex cache (Tipsify). */
+FLURR_DLL_EXPORT void OptimizeVertexCache(uint32_t* a_indices, std::size_t a_indexCount, std::size_t a_vertexCount, uint32_t a_cacheSize = DEFAULT_VERTEX_CACHE_SIZE);
+
+/**
+ * Reorder clusters of cache-optimized triangles so that outward-facing clusters are drawn first,
+ * reducing overdraw while keeping ACMR within the threshold. Positions are read as 3 floats
+ * at a_positionStride byte intervals.
+ */
+FLURR_DLL_EXPORT void OptimizeOverdraw(uint32_t* a_indices, std::size_t a_indexCount, const float* a_positions, std::size_t a_positionStride, std::size_t a_vertexCount,
+  uint32_t a_cacheSize = DEFAULT_VERTEX_CACHE_SIZE, float a_threshold = DEFAULT_OVERDRAW_THRESHOLD);
+
+/**
+ * Renumber vertices in order of first use and rewrite indices accordingly.
+ * Fills a_remap with the new index of each old vertex (~0u if unused) and returns the new vertex count.
+ */
+FLURR_DLL_EXPORT std::size_t OptimizeVertexFetchRemap(uint32_t* a_indices, std::size_t a_indexCount, std::size_t a_vertexCount, std::vector<uint32_t>& a_remap);
+FLURR_DLL_EXPORT void RemapVertexStream(void* a_vertexData, std::size_t a_vertexSize, std::size_t a_vertexCount, const std::vector<uint32_t>& a_remap);
+
+/** Run all enabled optimizations on a mesh in place; a_vertexCount receives the new vertex count. */
+FLURR_DLL_EXPORT Status OptimizeMesh(uint32_t* a_indices, std::size_t a_indexCount, const std::vector<MeshVertexStream>& a_vertexStreams, std::size_t& a_vertexCount,
+  const MeshOptimizationSettings& a_settings, MeshOptimizationStats* a_stats = nullptr);
+
+} // namespace flurr
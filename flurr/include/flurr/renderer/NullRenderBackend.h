@@ -0,0 +1,141 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+#include "flurr/renderer/RenderBackend.h"
+
+#include <array>
+#include <vector>
+
+namespace flurr
+{
+
+enum class RenderBackendCallType : uint8_t
+{
+  kBeginFrame = 0,
+  kEndFrame,
+  kSetViewport,
+  kUpdateFrameUniforms,
+  kInsertFrameFence,
+  kWaitFrameFence,
+  kCompileShader,
+  kLinkProgram,
+  kDestroyProgram,
+  kUseProgram,
+  kSetUniform,
+  kInitTexture,
+  kDestroyTexture,
+  kUseTexture,
+  kInitTextureArray,
+  kDestroyTextureArray,
+  kInitVertexBuffer,
+  kDestroyVertexBuffer,
+  kUseVertexBuffer,
+  kUpdateVertexBuffer,
+  kMapTransient,
+  kUnmapTransient,
+  kFenceTransients,
+  kInitGeometry,
+  kDestroyGeometry,
+  kDrawGeometry,
+  kDrawGeometryInstanced,
+  kInitArena,
+  kDestroyArena,
+  kUpdateArena,
+  kCopyArena,
+  kDrawArena,
+  kInitRenderTarget,
+  kDestroyRenderTarget,
+  kReadPixels,
+  kCount
+};
+
+struct RenderBackendCall
+{
+  RenderBackendCallType callType;
+  FlurrHandle handle; // object the call operates on, INVALID_HANDLE if none
+  uint32_t arg; // uniform handle, texture unit, instance count, data size, mesh count, layer capacity or frame slot, otherwise 0
+};
+
+/**
+ * Backend that touches no GPU state and needs no context. Every call succeeds and is recorded,
+ * so renderer logic can be unit tested and its CPU cost profiled in isolation.
+ */
+class FLURR_DLL_EXPORT NullRenderBackend : public RenderBackend
+{
+
+public:
+
+  NullRenderBackend();
+  ~NullRenderBackend() override = default;
+
+  const std::vector<RenderBackendCall>& getCalls() const { return m_calls; }
+  std::size_t getCallCount(RenderBackendCallType a_callType) const { return m_callCounts[static_cast<std::size_t>(a_callType)]; }
+  void clearCalls();
+  bool isRecording() const { return m_recording; }
+  void setRecording(bool a_recording) { m_recording = a_recording; } // when off, only call counts are kept
+
+  RenderBackendType getBackendType() const override { return RenderBackendType::kNull; }
+  bool hasGpuContext() const override { return false; }
+  bool hasParallelShaderCompile() const override { return false; }
+  Status init() override { return Status::kSuccess; }
+  void shutdown() override {}
+
+  void beginFrame(const RenderTarget* a_renderTarget, const glm::ivec4& a_viewport) override;
+  void endFrame(RenderTarget* a_renderTarget) override;
+  void setViewport(int a_x, int a_y, uint32_t a_width, uint32_t a_height) override;
+  void updateFrameUniforms(const FrameUniforms& a_frameUniforms) override;
+  void insertFrameFence(uint32_t a_frameSlot) override;
+  Status waitFrameFence(uint32_t a_frameSlot) override;
+
+  Status compileShader(ShaderProgram& a_program, ShaderType a_shaderType, FlurrHandle a_shaderResourceHandle) override;
+  Status linkProgram(ShaderProgram& a_program, bool a_async) override;
+  bool isLinkComplete(const ShaderProgram& a_program) const override { return true; }
+  Status finishLink(ShaderProgram& a_program) override { return Status::kSuccess; }
+  void destroyProgram(ShaderProgram& a_program) override;
+  Status useProgram(ShaderProgram& a_program) override;
+  void setIntUniform(ShaderProgram& a_program, UniformHandle a_uniform, int a_value) override;
+  void setVec4Uniform(ShaderProgram& a_program, UniformHandle a_uniform, const glm::vec4& a_value) override;
+  void setMat4Uniform(ShaderProgram& a_program, UniformHandle a_uniform, const glm::mat4& a_value) override;
+
+  Status initTexture(Texture& a_texture, FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode, bool a_asyncUpload) override;
+  Status initTextureInArray(Texture& a_texture, FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode) override;
+  void destroyTexture(Texture& a_texture) override;
+  Status useTexture(Texture& a_texture, TextureUnitIndex a_texUnit) override;
+  Status initTextureArray(TextureArray& a_textureArray, uint32_t a_width, uint32_t a_height, TextureFormat a_texFormat, uint32_t a_mipLevelCount, uint32_t a_layerCapacity,
+    TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode) override;
+  void destroyTextureArray(TextureArray& a_textureArray) override;
+
+  Status initVertexBuffer(VertexBuffer& a_buffer, const void* a_data) override;
+  void destroyVertexBuffer(VertexBuffer& a_buffer) override;
+  Status useVertexBuffer(VertexBuffer& a_buffer) override;
+  Status updateVertexBuffer(VertexBuffer& a_buffer, const void* a_data, std::size_t a_dataSize, std::size_t a_offset) override;
+  Status mapTransient(VertexBuffer& a_buffer, std::size_t a_dataSize, void** a_writePtr, std::size_t& a_offset) override;
+  Status unmapTransient(VertexBuffer& a_buffer) override;
+  void fenceTransients(VertexBuffer& a_buffer) override;
+
+  Status initGeometry(IndexedGeometry& a_geometry) override;
+  void destroyGeometry(IndexedGeometry& a_geometry) override;
+  Status drawGeometry(IndexedGeometry& a_geometry) override;
+  Status drawGeometryInstanced(IndexedGeometry& a_geometry, FlurrHandle a_instanceBufferHandle, uint32_t a_instanceCount) override;
+  Status initArena(GeometryArena& a_arena) override;
+  void destroyArena(GeometryArena& a_arena) override;
+  Status updateArena(GeometryArena& a_arena, const ArenaMesh& a_mesh, const void* a_vertexData, const uint32_t* a_indexData) override;
+  Status copyArena(GeometryArena& a_arena, const std::vector<ArenaMesh>& a_packedMeshes) override;
+  Status drawArenaMesh(GeometryArena& a_arena, const ArenaMesh& a_mesh) override;
+  Status drawArenaMeshes(GeometryArena& a_arena, const std::vector<FlurrHandle>& a_meshHandles) override;
+
+  Status initRenderTarget(RenderTarget& a_renderTarget, uint32_t a_width, uint32_t a_height, RenderTargetFormat a_colorFormat, bool a_hasDepth, uint32_t a_sampleCount) override;
+  void destroyRenderTarget(RenderTarget& a_renderTarget) override;
+  Status readPixels(const RenderTarget& a_renderTarget, std::vector<uint8_t>& a_pixels) override;
+
+private:
+
+  void recordCall(RenderBackendCallType a_callType, FlurrHandle a_handle = INVALID_HANDLE, uint32_t a_arg = 0);
+
+  std::vector<RenderBackendCall> m_calls;
+  std::array<std::size_t, static_cast<std::size_t>(RenderBackendCallType::kCount)> m_callCounts;
+  bool m_recording;
+  std::vector<uint8_t> m_transientData; // written through mapTransient, never read
+};
+
+} // namespace flurr
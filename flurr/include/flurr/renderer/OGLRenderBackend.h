@@ -0,0 +1,87 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+#include "flurr/renderer/RenderBackend.h"
+
+#include <GL/glew.h>
+
+#include <array>
+
+namespace flurr
+{
+
+/** Renders through the current OpenGL context, using the renderer objects' OGL implementations. */
+class FLURR_DLL_EXPORT OGLRenderBackend : public RenderBackend
+{
+
+public:
+
+  OGLRenderBackend();
+  ~OGLRenderBackend() override = default;
+
+  RenderBackendType getBackendType() const override { return RenderBackendType::kOpenGL; }
+  bool hasGpuContext() const override { return true; }
+  bool hasParallelShaderCompile() const override { return m_parallelShaderCompile; }
+  Status init() override;
+  void shutdown() override;
+
+  void beginFrame(const RenderTarget* a_renderTarget, const glm::ivec4& a_viewport) override;
+  void endFrame(RenderTarget* a_renderTarget) override;
+  void setViewport(int a_x, int a_y, uint32_t a_width, uint32_t a_height) override;
+  void updateFrameUniforms(const FrameUniforms& a_frameUniforms) override;
+  void insertFrameFence(uint32_t a_frameSlot) override;
+  Status waitFrameFence(uint32_t a_frameSlot) override;
+
+  Status compileShader(ShaderProgram& a_program, ShaderType a_shaderType, FlurrHandle a_shaderResourceHandle) override;
+  Status linkProgram(ShaderProgram& a_program, bool a_async) override;
+  bool isLinkComplete(const ShaderProgram& a_program) const override;
+  Status finishLink(ShaderProgram& a_program) override;
+  void destroyProgram(ShaderProgram& a_program) override;
+  Status useProgram(ShaderProgram& a_program) override;
+  void setIntUniform(ShaderProgram& a_program, UniformHandle a_uniform, int a_value) override;
+  void setVec4Uniform(ShaderProgram& a_program, UniformHandle a_uniform, const glm::vec4& a_value) override;
+  void setMat4Uniform(ShaderProgram& a_program, UniformHandle a_uniform, const glm::mat4& a_value) override;
+
+  Status initTexture(Texture& a_texture, FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode, bool a_asyncUpload) override;
+  Status initTextureInArray(Texture& a_texture, FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode) override;
+  void destroyTexture(Texture& a_texture) override;
+  Status useTexture(Texture& a_texture, TextureUnitIndex a_texUnit) override;
+  Status initTextureArray(TextureArray& a_textureArray, uint32_t a_width, uint32_t a_height, TextureFormat a_texFormat, uint32_t a_mipLevelCount, uint32_t a_layerCapacity,
+    TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode) override;
+  void destroyTextureArray(TextureArray& a_textureArray) override;
+
+  Status initVertexBuffer(VertexBuffer& a_buffer, const void* a_data) override;
+  void destroyVertexBuffer(VertexBuffer& a_buffer) override;
+  Status useVertexBuffer(VertexBuffer& a_buffer) override;
+  Status updateVertexBuffer(VertexBuffer& a_buffer, const void* a_data, std::size_t a_dataSize, std::size_t a_offset) override;
+  Status mapTransient(VertexBuffer& a_buffer, std::size_t a_dataSize, void** a_writePtr, std::size_t& a_offset) override;
+  Status unmapTransient(VertexBuffer& a_buffer) override;
+  void fenceTransients(VertexBuffer& a_buffer) override;
+
+  Status initGeometry(IndexedGeometry& a_geometry) override;
+  void destroyGeometry(IndexedGeometry& a_geometry) override;
+  Status drawGeometry(IndexedGeometry& a_geometry) override;
+  Status drawGeometryInstanced(IndexedGeometry& a_geometry, FlurrHandle a_instanceBufferHandle, uint32_t a_instanceCount) override;
+  Status initArena(GeometryArena& a_arena) override;
+  void destroyArena(GeometryArena& a_arena) override;
+  Status updateArena(GeometryArena& a_arena, const ArenaMesh& a_mesh, const void* a_vertexData, const uint32_t* a_indexData) override;
+  Status copyArena(GeometryArena& a_arena, const std::vector<ArenaMesh>& a_packedMeshes) override;
+  Status drawArenaMesh(GeometryArena& a_arena, const ArenaMesh& a_mesh) override;
+  Status drawArenaMeshes(GeometryArena& a_arena, const std::vector<FlurrHandle>& a_meshHandles) override;
+
+  Status initRenderTarget(RenderTarget& a_renderTarget, uint32_t a_width, uint32_t a_height, RenderTargetFormat a_colorFormat, bool a_hasDepth, uint32_t a_sampleCount) override;
+  void destroyRenderTarget(RenderTarget& a_renderTarget) override;
+  Status readPixels(const RenderTarget& a_renderTarget, std::vector<uint8_t>& a_pixels) override;
+
+private:
+
+  static constexpr GLuint64 kFrameFenceTimeout = 1000000000; // ns
+
+  bool m_parallelShaderCompile;
+  GLuint m_oglFrameUniformBufferId;
+  std::array<GLsync, MAX_FRAMES_IN_FLIGHT> m_oglFrameFences;
+  glm::ivec4 m_defaultViewport; // last viewport of the default framebuffer, restored when switching back to it
+  bool m_renderTargetBound;
+};
+
+} // namespace flurr
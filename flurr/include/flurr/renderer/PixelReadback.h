@@ -0,0 +1,83 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+
+#include <GL/glew.h>
+
+#include <functional>
+#include <vector>
+
+namespace flurr
+{
+
+// Receives RGBA8 pixels, bottom row first; the pixel data is only valid during the call
+using PixelReadbackCallback = std::function<void(const uint8_t* a_pixels, uint32_t a_width, uint32_t a_height)>;
+
+/**
+ * Reads back rendered frames without stalling the pipeline.
+ * At the end of the frame, glReadPixels copies the render target into a pixel pack buffer
+ * and the copy is fenced; once the fence signals on a later frame, the PBO is mapped
+ * and its contents are handed to the callback.
+ */
+class FLURR_DLL_EXPORT PixelReadback
+{
+
+public:
+
+  static constexpr std::size_t kMaxPixelBufferCount = 4;
+
+  PixelReadback();
+  PixelReadback(const PixelReadback&) = delete;
+  PixelReadback(PixelReadback&&) = delete;
+  PixelReadback& operator=(const PixelReadback&) = delete;
+  PixelReadback& operator=(PixelReadback&&) = delete;
+  ~PixelReadback() = default;
+
+  void init();
+  void shutdown();
+  void update(); // delivers finished readbacks; call on the GL thread once per frame
+  void issueReadbacks(FlurrHandle a_currentTargetHandle); // call after the frame is drawn and resolved
+
+  Status queueReadback(FlurrHandle a_targetHandle, PixelReadbackCallback a_callback); // INVALID_HANDLE = current target at end of frame
+  std::size_t getPendingReadbackCount() const { return m_readbacks.size(); }
+  std::size_t getPixelBufferCount() const { return m_pixelBuffers.size(); }
+
+private:
+
+  enum class ReadbackState : uint8_t
+  {
+    kQueued = 0, // waiting for the end of the frame
+    kReading, // framebuffer to PBO copy fenced on the GPU
+    kDone // delivered or dropped, removed on update
+  };
+
+  struct PixelBuffer
+  {
+    GLuint oglBufferId;
+    std::size_t size;
+    bool inUse;
+  };
+
+  struct Readback
+  {
+    FlurrHandle targetHandle;
+    PixelReadbackCallback callback;
+    uint32_t width;
+    uint32_t height;
+    std::size_t pixelBufferIndex;
+    GLsync oglFence;
+    ReadbackState state;
+  };
+
+  bool startReadback(Readback& a_readback, FlurrHandle a_currentTargetHandle);
+  std::size_t acquirePixelBuffer(std::size_t a_dataSize);
+  void releasePixelBuffer(std::size_t a_pixelBufferIndex);
+
+  static constexpr std::size_t kInvalidPixelBufferIndex = ~static_cast<std::size_t>(0);
+
+  bool m_initialized;
+  std::vector<PixelBuffer> m_pixelBuffers;
+  std::vector<Readback> m_readbacks; // in submission order
+};
+
+} // namespace flurr
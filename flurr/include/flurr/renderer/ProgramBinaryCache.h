@@ -0,0 +1,74 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+
+#include <GL/glew.h>
+
+#include <string>
+
+namespace flurr
+{
+
+/**
+ * On-disk cache of linked shader program binaries (glGetProgramBinary/glProgramBinary).
+ * Entries are stored per hash of all program stage sources, and are only valid for the
+ * OGL vendor, renderer and version they were created with; stale or rejected entries
+ * are deleted, so the program is compiled and cached again.
+ */
+class FLURR_DLL_EXPORT ProgramBinaryCache
+{
+
+public:
+
+  static constexpr const char* kDefaultCacheDirectory = "shadercache";
+  static constexpr uint64_t kHashSeed = 14695981039346656037ull; // FNV-1a offset basis
+
+  ProgramBinaryCache();
+  ProgramBinaryCache(const ProgramBinaryCache&) = delete;
+  ProgramBinaryCache(ProgramBinaryCache&&) = delete;
+  ProgramBinaryCache& operator=(const ProgramBinaryCache&) = delete;
+  ProgramBinaryCache& operator=(ProgramBinaryCache&&) = delete;
+  ~ProgramBinaryCache() = default;
+
+  static uint64_t Hash(const void* a_data, std::size_t a_dataSize, uint64_t a_hash = kHashSeed);
+
+  void init(); // requires OGL context
+  bool isEnabled() const { return m_enabled && m_supported; }
+  void setEnabled(bool a_enabled) { m_enabled = a_enabled; }
+  const std::string& getCacheDirectory() const { return m_cacheDirectory; }
+  void setCacheDirectory(const std::string& a_cacheDirectory) { m_cacheDirectory = a_cacheDirectory; }
+  uint32_t getHitCount() const { return m_hitCount; }
+  uint32_t getMissCount() const { return m_missCount; }
+
+  Status loadProgram(uint64_t a_sourceHash, GLuint a_oglProgramId); // kSuccess if program was linked from the cached binary
+  Status storeProgram(uint64_t a_sourceHash, GLuint a_oglProgramId); // program must be linked
+  void removeProgram(uint64_t a_sourceHash);
+  void clear();
+
+private:
+
+  struct EntryHeader
+  {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceHash;
+    uint64_t contextHash;
+    uint32_t oglBinaryFormat;
+    uint32_t binarySize;
+  };
+
+  static constexpr uint32_t kEntryMagic = 0x43425046; // "FPBC"
+  static constexpr uint32_t kEntryVersion = 1;
+  static constexpr const char* kEntryExtension = ".bin";
+
+  std::string getEntryPath(uint64_t a_sourceHash) const;
+
+  bool m_enabled;
+  bool m_supported;
+  std::string m_cacheDirectory;
+  uint64_t m_contextHash;
+  uint32_t m_hitCount;
+  uint32_t m_missCount;
+};
+
+} // namespace flurr
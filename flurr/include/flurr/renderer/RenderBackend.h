@@ -0,0 +1,110 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+#include "flurr/renderer/IndexedGeometry.h"
+#include "flurr/renderer/GeometryArena.h"
+#include "flurr/renderer/RenderTarget.h"
+#include "flurr/renderer/ShaderProgram.h"
+#include "flurr/renderer/Texture.h"
+#include "flurr/renderer/TextureArray.h"
+#include "flurr/renderer/VertexBuffer.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace flurr
+{
+
+struct FrameUniforms;
+
+enum class RenderBackendType : uint8_t
+{
+  kOpenGL = 0,
+  kNull // records calls instead of rendering, needs no context
+};
+
+/**
+ * GPU side of the renderer. Renderer keeps the handle tables, validates arguments and sorts
+ * render commands, then hands every operation that touches the GPU to its backend.
+ * Backends receive renderer objects, whose GPU state they own.
+ */
+class FLURR_DLL_EXPORT RenderBackend
+{
+
+public:
+
+  RenderBackend() = default;
+  RenderBackend(const RenderBackend&) = delete;
+  RenderBackend(RenderBackend&&) = delete;
+  RenderBackend& operator=(const RenderBackend&) = delete;
+  RenderBackend& operator=(RenderBackend&&) = delete;
+  virtual ~RenderBackend() = default;
+
+  virtual RenderBackendType getBackendType() const = 0;
+  virtual bool hasGpuContext() const = 0; // false if GPU-side helpers (profiler, uploader...) must stay off
+  virtual bool hasParallelShaderCompile() const = 0;
+  virtual Status init() = 0;
+  virtual void shutdown() = 0;
+
+  // Frame
+  virtual void beginFrame(const RenderTarget* a_renderTarget, const glm::ivec4& a_viewport) = 0; // null target = default framebuffer
+  virtual void endFrame(RenderTarget* a_renderTarget) = 0;
+  virtual void setViewport(int a_x, int a_y, uint32_t a_width, uint32_t a_height) = 0;
+  virtual void updateFrameUniforms(const FrameUniforms& a_frameUniforms) = 0;
+  virtual void insertFrameFence(uint32_t a_frameSlot) = 0; // end of frame, signals once the GPU has finished the frame; slot < MAX_FRAMES_IN_FLIGHT
+  virtual Status waitFrameFence(uint32_t a_frameSlot) = 0; // blocks until the slot's last frame has finished, then releases its fence
+
+  // Shader programs
+  virtual Status compileShader(ShaderProgram& a_program, ShaderType a_shaderType, FlurrHandle a_shaderResourceHandle) = 0;
+  virtual Status linkProgram(ShaderProgram& a_program, bool a_async) = 0;
+  virtual bool isLinkComplete(const ShaderProgram& a_program) const = 0;
+  virtual Status finishLink(ShaderProgram& a_program) = 0;
+  virtual void destroyProgram(ShaderProgram& a_program) = 0;
+  virtual Status useProgram(ShaderProgram& a_program) = 0;
+  virtual void setIntUniform(ShaderProgram& a_program, UniformHandle a_uniform, int a_value) = 0;
+  virtual void setVec4Uniform(ShaderProgram& a_program, UniformHandle a_uniform, const glm::vec4& a_value) = 0;
+  virtual void setMat4Uniform(ShaderProgram& a_program, UniformHandle a_uniform, const glm::mat4& a_value) = 0;
+
+  // Textures
+  virtual Status initTexture(Texture& a_texture, FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode, bool a_asyncUpload) = 0;
+  virtual Status initTextureInArray(Texture& a_texture, FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode) = 0;
+  virtual void destroyTexture(Texture& a_texture) = 0;
+  virtual Status useTexture(Texture& a_texture, TextureUnitIndex a_texUnit) = 0;
+
+  // Texture arrays
+  virtual Status initTextureArray(TextureArray& a_textureArray, uint32_t a_width, uint32_t a_height, TextureFormat a_texFormat, uint32_t a_mipLevelCount, uint32_t a_layerCapacity,
+    TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode) = 0;
+  virtual void destroyTextureArray(TextureArray& a_textureArray) = 0;
+
+  // Vertex buffers
+  virtual Status initVertexBuffer(VertexBuffer& a_buffer, const void* a_data) = 0; // properties already set, index data as 32-bit indices
+  virtual void destroyVertexBuffer(VertexBuffer& a_buffer) = 0;
+  virtual Status useVertexBuffer(VertexBuffer& a_buffer) = 0;
+  virtual Status updateVertexBuffer(VertexBuffer& a_buffer, const void* a_data, std::size_t a_dataSize, std::size_t a_offset) = 0;
+  virtual Status mapTransient(VertexBuffer& a_buffer, std::size_t a_dataSize, void** a_writePtr, std::size_t& a_offset) = 0;
+  virtual Status unmapTransient(VertexBuffer& a_buffer) = 0;
+  virtual void fenceTransients(VertexBuffer& a_buffer) = 0; // end of frame, stream buffers only
+
+  // Geometry
+  virtual Status initGeometry(IndexedGeometry& a_geometry) = 0; // buffers already set
+  virtual void destroyGeometry(IndexedGeometry& a_geometry) = 0;
+  virtual Status drawGeometry(IndexedGeometry& a_geometry) = 0;
+  virtual Status drawGeometryInstanced(IndexedGeometry& a_geometry, FlurrHandle a_instanceBufferHandle, uint32_t a_instanceCount) = 0;
+  virtual Status initArena(GeometryArena& a_arena) = 0; // properties already set
+  virtual void destroyArena(GeometryArena& a_arena) = 0;
+  virtual Status updateArena(GeometryArena& a_arena, const ArenaMesh& a_mesh, const void* a_vertexData, const uint32_t* a_indexData) = 0; // mesh ranges already allocated
+  virtual Status copyArena(GeometryArena& a_arena, const std::vector<ArenaMesh>& a_packedMeshes) = 0; // packed ranges in arena mesh order
+  virtual Status drawArenaMesh(GeometryArena& a_arena, const ArenaMesh& a_mesh) = 0;
+  virtual Status drawArenaMeshes(GeometryArena& a_arena, const std::vector<FlurrHandle>& a_meshHandles) = 0; // handles already checked
+
+  // Render targets
+  virtual Status initRenderTarget(RenderTarget& a_renderTarget, uint32_t a_width, uint32_t a_height, RenderTargetFormat a_colorFormat, bool a_hasDepth, uint32_t a_sampleCount) = 0;
+  virtual void destroyRenderTarget(RenderTarget& a_renderTarget) = 0;
+  virtual Status readPixels(const RenderTarget& a_renderTarget, std::vector<uint8_t>& a_pixels) = 0; // RGBA, bottom row first; blocking
+
+  static std::unique_ptr<RenderBackend> Create(RenderBackendType a_backendType);
+  static bool ParseBackendType(const std::string& a_str, RenderBackendType& a_backendType); // OpenGL or Null
+};
+
+} // namespace flurr
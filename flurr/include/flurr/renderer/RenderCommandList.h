@@ -0,0 +1,55 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace flurr
+{
+
+/** Draw recorded into a command list; resources are referenced by handle and resolved on submission. */
+struct RenderCommandListDraw
+{
+  FlurrHandle programHandle;
+  FlurrHandle geometryHandle;
+  FlurrHandle texHandle; // or INVALID_HANDLE
+  glm::mat4 modelTransf;
+  float viewDepth;
+  glm::vec4 drawParams; // per-draw uniform data, see DRAW_PARAMS_UNIFORM_NAME
+};
+
+/**
+ * List of draws recorded without touching the renderer, so each worker thread can fill its own list
+ * in parallel. Lists are submitted to the renderer on the GL thread once recording has finished,
+ * where their draws are validated, merged into the render queue and sorted with all other draws.
+ */
+class FLURR_DLL_EXPORT RenderCommandList
+{
+
+public:
+
+  RenderCommandList() = default;
+  RenderCommandList(const RenderCommandList&) = delete;
+  RenderCommandList(RenderCommandList&&) = default;
+  RenderCommandList& operator=(const RenderCommandList&) = delete;
+  RenderCommandList& operator=(RenderCommandList&&) = default;
+  ~RenderCommandList() = default;
+
+  void addDraw(FlurrHandle a_programHandle, FlurrHandle a_geometryHandle, const glm::mat4& a_modelTransf, FlurrHandle a_texHandle = INVALID_HANDLE, float a_viewDepth = 0.0f,
+    const glm::vec4& a_drawParams = glm::vec4(0.0f));
+  void clear() { m_draws.clear(); } // keeps capacity, so lists can be reused every frame
+  void reserve(std::size_t a_drawCount) { m_draws.reserve(a_drawCount); }
+
+  std::size_t getDrawCount() const { return m_draws.size(); }
+  bool isEmpty() const { return m_draws.empty(); }
+  const RenderCommandListDraw& getDraw(std::size_t a_drawIndex) const { return m_draws[a_drawIndex]; }
+  const std::vector<RenderCommandListDraw>& getDraws() const { return m_draws; }
+
+private:
+
+  std::vector<RenderCommandListDraw> m_draws;
+};
+
+} // namespace flurr
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace flurr
+{
+
+/** Single queued draw of indexed geometry. */
+struct RenderCommand
+{
+  uint64_t sortKey;
+  FlurrHandle programHandle;
+  FlurrHandle textureHandle; // bound to texture unit 0, or INVALID_HANDLE
+  FlurrHandle geometryHandle;
+  glm::mat4 modelTransf;
+  glm::vec4 drawParams; // set on the program's drawParams uniform, if it has one
+};
+
+/**
+ * Per-frame list of render commands, sorted by key to minimize state changes.
+ *
+ * The sort key is laid out from the most to the least significant bits as
+ * program (16 bits) | texture array flag (1 bit) | texture (16 bits) | geometry (16 bits) | view depth (15 bits),
+ * so commands are grouped by program, then texture, then geometry, and drawn front to back.
+ * Handle fields hold the low 16 bits of the slot index; larger indices assert, since they would alias.
+ * Layers of one texture array are grouped by the array handle; the flag keeps array and texture handles apart.
+ */
+class FLURR_DLL_EXPORT RenderQueue
+{
+
+public:
+
+  RenderQueue() = default;
+  RenderQueue(const RenderQueue&) = delete;
+  RenderQueue(RenderQueue&&) = default;
+  RenderQueue& operator=(const RenderQueue&) = delete;
+  RenderQueue& operator=(RenderQueue&&) = default;
+  ~RenderQueue() = default;
+
+  static uint64_t MakeSortKey(FlurrHandle a_programHandle, FlurrHandle a_textureHandle, FlurrHandle a_geometryHandle, float a_viewDepth, bool a_textureArray = false); // texture handle is an array handle if a_textureArray
+
+  void addCommand(FlurrHandle a_programHandle, FlurrHandle a_textureHandle, FlurrHandle a_geometryHandle, const glm::mat4& a_modelTransf, float a_viewDepth = 0.0f, FlurrHandle a_textureArrayHandle = INVALID_HANDLE, // array holding the texture, if any
+    const glm::vec4& a_drawParams = glm::vec4(0.0f));
+  void sort();
+  void clear();
+  void reserve(std::size_t a_commandCount);
+
+  std::size_t getCommandCount() const { return m_commands.size(); }
+  bool isEmpty() const { return m_commands.empty(); }
+  const RenderCommand& getCommand(std::size_t a_commandIndex) const { return m_commands[a_commandIndex]; } // in submission order
+  const RenderCommand& getSortedCommand(std::size_t a_sortedIndex) const { return m_commands[m_sortItems[a_sortedIndex].commandIndex]; } // call sort beforehand
+
+private:
+
+  struct SortItem
+  {
+    uint64_t sortKey;
+    uint32_t commandIndex;
+  };
+
+  static constexpr uint32_t kRadixBits = 8;
+  static constexpr uint32_t kRadixSize = 1 << kRadixBits;
+  static constexpr uint32_t kRadixPassCount = 64 / kRadixBits;
+
+  std::vector<RenderCommand> m_commands;
+  std::vector<SortItem> m_sortItems;
+  std::vector<SortItem> m_sortScratch;
+};
+
+} // namespace flurr
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+#include "flurr/renderer/Texture.h"
+
+#include <GL/glew.h>
+
+#include <array>
+
+namespace flurr
+{
+
+struct RenderStateCacheStats
+{
+  uint32_t programBindsSkipped = 0;
+  uint32_t vertexArrayBindsSkipped = 0;
+  uint32_t bufferBindsSkipped = 0;
+  uint32_t textureBindsSkipped = 0;
+  uint32_t activeTextureSwitchesSkipped = 0;
+  uint32_t samplerBindsSkipped = 0;
+
+  uint32_t getTotalSkipped() const { return programBindsSkipped + vertexArrayBindsSkipped + bufferBindsSkipped + textureBindsSkipped + activeTextureSwitchesSkipped + samplerBindsSkipped; }
+};
+
+/**
+ * Shadow copy of the OGL bindings last set through the renderer,
+ * used to skip bind calls that would not change any state.
+ * All renderer objects must bind through the cache to keep it in sync with OGL.
+ */
+class FLURR_DLL_EXPORT RenderStateCache
+{
+
+public:
+
+  RenderStateCache();
+  RenderStateCache(const RenderStateCache&) = delete;
+  RenderStateCache(RenderStateCache&&) = delete;
+  RenderStateCache& operator=(const RenderStateCache&) = delete;
+  RenderStateCache& operator=(RenderStateCache&&) = delete;
+  ~RenderStateCache() = default;
+
+  void useProgram(GLuint a_oglProgramId);
+  void bindVertexArray(GLuint a_oglVaoId);
+  void bindBuffer(GLenum a_oglBufferType, GLuint a_oglBufferId);
+  void bindTexture(TextureUnitIndex a_texUnit, GLenum a_oglTexType, GLuint a_oglTexId);
+  void bindTexture(GLenum a_oglTexType, GLuint a_oglTexId); // bind to the active unit
+  void setActiveTextureUnit(TextureUnitIndex a_texUnit);
+  void bindSampler(TextureUnitIndex a_texUnit, GLuint a_oglSamplerId);
+
+  // Object deletion notifications (OGL resets bindings of deleted objects)
+  void onProgramDeleted(GLuint a_oglProgramId);
+  void onVertexArrayDeleted(GLuint a_oglVaoId);
+  void onBufferDeleted(GLuint a_oglBufferId);
+  void onTextureDeleted(GLuint a_oglTexId);
+  void onSamplerDeleted(GLuint a_oglSamplerId);
+
+  void invalidate(); // forget all cached bindings, e.g. after external OGL calls
+  const RenderStateCacheStats& getStats() const { return m_stats; }
+  void resetStats() { m_stats = RenderStateCacheStats(); }
+
+private:
+
+  struct TextureBinding
+  {
+    GLenum oglTexType;
+    GLuint oglTexId;
+  };
+
+  static constexpr GLuint kUnknownBinding = ~0u;
+  static constexpr TextureUnitIndex kUnknownTextureUnit = ~0u;
+
+  GLuint m_oglProgramId;
+  GLuint m_oglVaoId;
+  GLuint m_oglArrayBufferId;
+  GLuint m_oglElementBufferId; // part of VAO state
+  TextureUnitIndex m_activeTexUnit;
+  std::array<TextureBinding, MAX_TEXTURE_UNIT + 1> m_textureBindings;
+  std::array<GLuint, MAX_TEXTURE_UNIT + 1> m_oglSamplerIds;
+  RenderStateCacheStats m_stats;
+};
+
+} // namespace flurr
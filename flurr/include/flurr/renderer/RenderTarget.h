@@ -0,0 +1,69 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+
+#include <GL/glew.h>
+
+namespace flurr
+{
+
+enum class RenderTargetFormat : uint8_t
+{
+  kRGBA8 = 0,
+  kRGBA16F
+};
+
+/**
+ * Framebuffer object with a colour attachment and an optional depth-stencil attachment.
+ * Multisampled targets render into MSAA renderbuffers and are resolved into a single-sampled
+ * colour texture at the end of the frame; otherwise the colour texture is attached directly.
+ */
+class FLURR_DLL_EXPORT RenderTarget
+{
+  friend class Renderer;
+  friend class OGLRenderBackend;
+
+public:
+
+  RenderTarget(FlurrHandle a_targetHandle);
+  RenderTarget(const RenderTarget&) = delete;
+  RenderTarget(RenderTarget&&) = default;
+  RenderTarget& operator=(const RenderTarget&) = delete;
+  RenderTarget& operator=(RenderTarget&&) = default;
+  ~RenderTarget() = default;
+
+  FlurrHandle getTargetHandle() const { return m_targetHandle; }
+  bool isCreated() const { return 0 != m_oglFramebufferId; }
+  uint32_t getWidth() const { return m_width; }
+  uint32_t getHeight() const { return m_height; }
+  RenderTargetFormat getColorFormat() const { return m_colorFormat; }
+  bool hasDepth() const { return m_hasDepth; }
+  uint32_t getSampleCount() const { return m_sampleCount; }
+  bool isMultisampled() const { return m_sampleCount > 1; }
+  GLuint getOGLFramebufferId() const { return m_oglFramebufferId; } // draw framebuffer
+  GLuint getOGLReadFramebufferId() const { return isMultisampled() ? m_oglResolveFramebufferId : m_oglFramebufferId; } // holds resolved colour
+  GLuint getOGLColorTextureId() const { return m_oglColorTexId; } // resolved colour
+
+private:
+
+  Status initRenderTarget(uint32_t a_width, uint32_t a_height, RenderTargetFormat a_colorFormat, bool a_hasDepth, uint32_t a_sampleCount);
+  void destroyRenderTarget();
+  void resolve(); // multisampled colour into the colour texture; no-op for single-sampled targets
+
+  static bool CheckFramebufferComplete(const char* a_framebufferName);
+
+  FlurrHandle m_targetHandle;
+  uint32_t m_width;
+  uint32_t m_height;
+  RenderTargetFormat m_colorFormat;
+  bool m_hasDepth;
+  uint32_t m_sampleCount;
+
+  GLuint m_oglFramebufferId;
+  GLuint m_oglResolveFramebufferId;
+  GLuint m_oglColorTexId;
+  GLuint m_oglColorRenderbufferId; // multisampled only
+  GLuint m_oglDepthRenderbufferId;
+};
+
+} // namespace flurr
@@ -3,18 +3,45 @@
 #include "flurr/FlurrDefines.h"
 #include "flurr/renderer/ShaderProgram.h"
 #include "flurr/renderer/Texture.h"
+#include "flurr/renderer/TextureArray.h"
+#include "flurr/renderer/TextureUploader.h"
 #include "flurr/renderer/IndexedGeometry.h"
+#include "flurr/renderer/GeometryArena.h"
+#include "flurr/renderer/GpuProfiler.h"
+#include "flurr/renderer/PixelReadback.h"
+#include "flurr/renderer/ProgramBinaryCache.h"
+#include "flurr/renderer/RenderBackend.h"
+#include "flurr/renderer/RenderCommandList.h"
+#include "flurr/renderer/RenderQueue.h"
+#include "flurr/renderer/RenderStateCache.h"
+#include "flurr/renderer/RenderTarget.h"
+#include "flurr/renderer/SamplerCache.h"
+#include "flurr/utils/SlotMap.h"
 
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 namespace flurr
 {
 
+class ConfigFile;
+class FramePacket;
+
+// Per-frame uniform block (std140 layout), bound at FRAME_UNIFORM_BLOCK_BINDING
+struct FrameUniforms
+{
+  glm::mat4 viewTransf;
+  glm::mat4 projTransf;
+  glm::mat4 viewProjTransf;
+  glm::vec4 cameraPosition; // w is unused
+  glm::vec4 time; // x = time since start, y = delta time
+};
+static_assert(sizeof(FrameUniforms) == 224, "FrameUniforms must match the std140 layout of the shader uniform block!");
+
 class FLURR_DLL_EXPORT Renderer
 {
+  friend class Texture;
 
 public:
 
@@ -25,72 +52,162 @@ public:
   Renderer& operator=(Renderer&&) = delete;
   ~Renderer();
 
-  Status init();
+  Status init(const ConfigFile* a_config = nullptr); // reads [Renderer] settings
   void shutdown();
   Status update(float a_deltaTime);
   bool isInitialized() const { return m_initialized; }
+  Status setBackend(std::unique_ptr<RenderBackend> a_backend); // only before init
+  RenderBackend& getBackend() { return *m_backend; }
+  const RenderBackend& getBackend() const { return *m_backend; }
 
   void setViewport(int a_x, int a_y, uint32_t a_width, uint32_t a_height);
+  uint32_t getMaxFramesInFlight() const { return m_maxFramesInFlight; }
+  Status setMaxFramesInFlight(uint32_t a_maxFramesInFlight); // 1 to MAX_FRAMES_IN_FLIGHT, update blocks once the GPU falls this many frames behind
+  uint64_t getFrameIndex() const { return m_frameIndex; }
+  uint32_t getFrameSlot() const { return static_cast<uint32_t>(m_frameIndex % m_maxFramesInFlight); } // per-frame resource region this frame may write; the GPU has finished the last frame that used it
+  Status createOffscreenFramebuffer(uint32_t a_width, uint32_t a_height); // render target that frames render into instead of the default framebuffer
+  void destroyOffscreenFramebuffer();
+  bool hasOffscreenFramebuffer() const { return INVALID_HANDLE != m_offscreenTargetHandle; }
+  FlurrHandle getOffscreenRenderTargetHandle() const { return m_offscreenTargetHandle; }
+  uint32_t getOffscreenWidth() const;
+  uint32_t getOffscreenHeight() const;
+  Status readOffscreenPixels(std::vector<uint8_t>& a_pixels); // RGBA, bottom row first; waits for the GPU
+  RenderStateCache& getStateCache() { return m_stateCache; }
+  const RenderStateCache& getStateCache() const { return m_stateCache; }
+  GpuProfiler& getGpuProfiler() { return m_gpuProfiler; }
+  const GpuProfiler& getGpuProfiler() const { return m_gpuProfiler; }
+  ProgramBinaryCache& getProgramBinaryCache() { return m_programBinaryCache; }
+  const ProgramBinaryCache& getProgramBinaryCache() const { return m_programBinaryCache; }
+  const TextureUploader& getTextureUploader() const { return m_textureUploader; }
+  SamplerCache& getSamplerCache() { return m_samplerCache; }
+  const SamplerCache& getSamplerCache() const { return m_samplerCache; }
+  void setTextureFiltering(TextureFilteringQuality a_filteringQuality, uint32_t a_anisotropyLevel = 16) { m_samplerCache.setFilteringQuality(a_filteringQuality, a_anisotropyLevel); }
 
   Status createShaderProgram(FlurrHandle& a_programHandle);
   void destroyShaderProgram(FlurrHandle a_programHandle);
   bool hasShaderProgram(FlurrHandle a_programHandle) const;
   ShaderProgram* getShaderProgram(FlurrHandle a_programHandle) const;
   ShaderProgram* getShaderProgramByIndex(std::size_t a_programIndex) const;
-  std::size_t getShaderProgramCount() const { return m_shaderProgramHandles.size(); }
-  std::vector<FlurrHandle> getShaderProgramHandles() const { return m_shaderProgramHandles; }
+  std::size_t getShaderProgramCount() const { return m_shaderPrograms.size(); }
+  std::vector<FlurrHandle> getShaderProgramHandles() const { return m_shaderPrograms.getHandles(); }
   Status compileShader(FlurrHandle a_programHandle, ShaderType a_shaderType, FlurrHandle a_shaderResourceHandle);
-  Status linkShaderProgram(FlurrHandle a_programHandle);
+  Status linkShaderProgram(FlurrHandle a_programHandle); // blocking
+  Status linkShaderProgramsAsync(const std::vector<FlurrHandle>& a_programHandles); // programs become usable on a later update
+  std::size_t getPendingShaderProgramCount() const;
+  Status waitForShaderPrograms(); // finish all pending links, blocking
+  bool hasParallelShaderCompile() const { return m_backend->hasParallelShaderCompile(); }
   Status useShaderProgram(FlurrHandle a_programHandle);
 
   Status createTexture(FlurrHandle& a_texHandle, FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode = TextureWrapMode::kRepeat, TextureMinFilterMode a_texMinFilterMode = TextureMinFilterMode::kLinearMipmapLinear, TextureMagFilterMode a_texMagFilterMode = TextureMagFilterMode::kLinear);
+  Status createTextureAsync(FlurrHandle& a_texHandle, FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode = TextureWrapMode::kRepeat, TextureMinFilterMode a_texMinFilterMode = TextureMinFilterMode::kLinearMipmapLinear, TextureMagFilterMode a_texMagFilterMode = TextureMagFilterMode::kLinear); // uploaded through a PBO, draws are skipped until ready
   void destroyTexture(FlurrHandle a_texHandle);
   bool hasTexture(FlurrHandle a_texHandle) const;
   Texture* getTexture(FlurrHandle a_texHandle) const;
   Texture* getTextureByIndex(std::size_t a_texIndex) const;
-  std::size_t getTextureCount() const { return m_textureHandles.size(); }
-  std::vector<FlurrHandle> getTextureHandles() const { return m_textureHandles; }
+  std::size_t getTextureCount() const { return m_textures.size(); }
+  std::vector<FlurrHandle> getTextureHandles() const { return m_textures.getHandles(); }
   Status useTexture(FlurrHandle a_texHandle, TextureUnitIndex a_texUnit = 0);
 
+  Status createTextureInArray(FlurrHandle& a_texHandle, FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode = TextureWrapMode::kRepeat, TextureMinFilterMode a_texMinFilterMode = TextureMinFilterMode::kLinearMipmapLinear, TextureMagFilterMode a_texMagFilterMode = TextureMagFilterMode::kLinear); // sample with sampler2DArray and TEXTURE_LAYER_UNIFORM_NAME
+  bool hasTextureArray(FlurrHandle a_arrayHandle) const;
+  TextureArray* getTextureArray(FlurrHandle a_arrayHandle) const;
+  TextureArray* getTextureArrayByIndex(std::size_t a_arrayIndex) const;
+  std::size_t getTextureArrayCount() const { return m_textureArrays.size(); }
+  std::vector<FlurrHandle> getTextureArrayHandles() const { return m_textureArrays.getHandles(); }
+
   Status createVertexBuffer(FlurrHandle& a_bufferHandle, VertexBufferType a_bufferType, std::size_t a_dataSize, void* a_data, std::size_t a_attributeSize, VertexDataUsage a_dataUsage = VertexDataUsage::kStatic);
-  Status createIndexBuffer(FlurrHandle& a_bufferHandle, std::size_t a_dataSize, void* a_data, VertexDataUsage a_dataUsage = VertexDataUsage::kStatic);
+  Status createIndexBuffer(FlurrHandle& a_bufferHandle, std::size_t a_dataSize, void* a_data, VertexDataUsage a_dataUsage = VertexDataUsage::kStatic, IndexType a_indexType = IndexType::kAuto); // data holds 32-bit indices
   void destroyVertexBuffer(FlurrHandle a_bufferHandle);
   bool hasVertexBuffer(FlurrHandle a_bufferHandle) const;
   VertexBuffer* getVertexBuffer(FlurrHandle a_bufferHandle) const;
   VertexBuffer* getVertexBufferByIndex(std::size_t a_bufferIndex) const;
-  std::size_t getVertexBufferCount() const { return m_vertexBufferHandles.size(); }
-  std::vector<FlurrHandle> getVertexBufferHandles() const { return m_vertexBufferHandles; }
+  std::size_t getVertexBufferCount() const { return m_vertexBuffers.size(); }
+  std::vector<FlurrHandle> getVertexBufferHandles() const { return m_vertexBuffers.getHandles(); }
   Status useVertexBuffer(FlurrHandle a_bufferHandle);
+  Status updateVertexBuffer(FlurrHandle a_bufferHandle, const void* a_data, std::size_t a_dataSize, std::size_t& a_offset); // stream buffers output the offset of written data; index data must match buffer index type
+  Status allocateTransient(FlurrHandle a_bufferHandle, std::size_t a_dataSize, void** a_writePtr, std::size_t& a_offset); // stream buffers only
+  Status commitTransient(FlurrHandle a_bufferHandle); // call before drawing from allocated range
 
   Status createIndexedGeometry(FlurrHandle& a_geometryHandle, const std::vector<FlurrHandle>& a_attributeBufferHandles, FlurrHandle a_indexBufferHandle);
+  Status createIndexedGeometry(FlurrHandle& a_geometryHandle, const std::vector<FlurrHandle>& a_attributeBufferHandles, FlurrHandle a_indexBufferHandle, const VertexLayout& a_vertexLayout);
   void destroyIndexedGeometry(FlurrHandle a_geometryHandle);
   bool hasIndexedGeometry(FlurrHandle a_geometryHandle) const;
   IndexedGeometry* getIndexedGeometry(FlurrHandle a_geometryHandle) const;
   IndexedGeometry* getIndexedGeometryByIndex(std::size_t a_geometryIndex) const;
-  std::size_t getIndexedGeometryCount() const { return m_indexedGeometryHandles.size(); }
-  std::vector<FlurrHandle> getIndexedGeometryHandles() const { return m_indexedGeometryHandles; }
+  std::size_t getIndexedGeometryCount() const { return m_indexedGeometries.size(); }
+  std::vector<FlurrHandle> getIndexedGeometryHandles() const { return m_indexedGeometries.getHandles(); }
   Status drawIndexedGeometry(FlurrHandle a_geometryHandle);
+  Status drawIndexedGeometryInstanced(FlurrHandle a_geometryHandle, FlurrHandle a_instanceBufferHandle, uint32_t a_instanceCount = 0); // 0 = all instances in buffer
+
+  Status createGeometryArena(FlurrHandle& a_arenaHandle, const VertexLayout& a_vertexLayout, std::size_t a_vertexCapacity, std::size_t a_indexCapacity, IndexType a_indexType = IndexType::kUnsigned32);
+  void destroyGeometryArena(FlurrHandle a_arenaHandle);
+  bool hasGeometryArena(FlurrHandle a_arenaHandle) const;
+  GeometryArena* getGeometryArena(FlurrHandle a_arenaHandle) const;
+  GeometryArena* getGeometryArenaByIndex(std::size_t a_arenaIndex) const;
+  std::size_t getGeometryArenaCount() const { return m_geometryArenas.size(); }
+  std::vector<FlurrHandle> getGeometryArenaHandles() const { return m_geometryArenas.getHandles(); }
+
+  Status createRenderTarget(FlurrHandle& a_targetHandle, uint32_t a_width, uint32_t a_height, RenderTargetFormat a_colorFormat = RenderTargetFormat::kRGBA8, bool a_hasDepth = true, uint32_t a_sampleCount = 1);
+  void destroyRenderTarget(FlurrHandle a_targetHandle);
+  bool hasRenderTarget(FlurrHandle a_targetHandle) const;
+  RenderTarget* getRenderTarget(FlurrHandle a_targetHandle) const;
+  RenderTarget* getRenderTargetByIndex(std::size_t a_targetIndex) const;
+  std::size_t getRenderTargetCount() const { return m_renderTargets.size(); }
+  std::vector<FlurrHandle> getRenderTargetHandles() const { return m_renderTargets.getHandles(); }
+  Status setRenderTarget(FlurrHandle a_targetHandle); // subsequent frames render into the target, INVALID_HANDLE = default framebuffer
+  FlurrHandle getRenderTargetHandle() const { return m_renderTargetHandle; }
+  Status readPixelsAsync(PixelReadbackCallback a_callback, FlurrHandle a_targetHandle = INVALID_HANDLE); // captures the next frame, delivered a few updates later; INVALID_HANDLE = frame's target
+  const PixelReadback& getPixelReadback() const { return m_pixelReadback; }
+
+  Status submitDraw(FlurrHandle a_programHandle, FlurrHandle a_geometryHandle, const glm::mat4& a_modelTransf, FlurrHandle a_texHandle = INVALID_HANDLE, float a_viewDepth = 0.0f,
+    const glm::vec4& a_drawParams = glm::vec4(0.0f)); // draw params are set on the program's drawParams uniform
+  Status submitCommandList(const RenderCommandList& a_commandList); // call on the GL thread, after recording has finished
+  Status submitFramePacket(const FramePacket& a_framePacket); // applies the packet's buffer updates and camera data, then queues its draws
+  const RenderQueue& getRenderQueue() const { return m_renderQueue; }
+  const FrameUniforms& getFrameUniforms() const { return m_frameUniforms; }
+  void setFrameUniforms(const FrameUniforms& a_frameUniforms);
 
 private:
 
+  void updatePendingShaderPrograms();
+  Status allocateTextureArrayLayer(uint32_t a_width, uint32_t a_height, TextureFormat a_texFormat, uint32_t a_mipLevelCount,
+    TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode,
+    FlurrHandle& a_arrayHandle, uint32_t& a_layer);
+  Status setGeometryBuffers(IndexedGeometry& a_geometry, const std::vector<FlurrHandle>& a_attributeBufferHandles, FlurrHandle a_indexBufferHandle, const VertexLayout* a_vertexLayout);
+  void flushRenderQueue();
+  void fenceStreamBuffers();
+
   bool m_initialized;
+  std::unique_ptr<RenderBackend> m_backend;
+  RenderStateCache m_stateCache;
+  uint32_t m_maxFramesInFlight;
+  uint64_t m_frameIndex;
+  GpuProfiler m_gpuProfiler;
+  ProgramBinaryCache m_programBinaryCache;
+  TextureUploader m_textureUploader;
+  PixelReadback m_pixelReadback;
+  SamplerCache m_samplerCache;
 
   // Shaders
-  FlurrHandle m_nextShaderProgramHandle;
-  std::unordered_map<FlurrHandle, std::unique_ptr<ShaderProgram>> m_shaderPrograms;
-  std::vector<FlurrHandle> m_shaderProgramHandles;
+  SlotMap<std::unique_ptr<ShaderProgram>> m_shaderPrograms;
   // Textures
-  FlurrHandle m_nextTextureHandle;
-  std::unordered_map<FlurrHandle, std::unique_ptr<Texture>> m_textures;
-  std::vector<FlurrHandle> m_textureHandles;
+  SlotMap<std::unique_ptr<Texture>> m_textures;
+  SlotMap<std::unique_ptr<TextureArray>> m_textureArrays;
   // Vertex buffers
-  FlurrHandle m_nextVertexBufferHandle;
-  std::unordered_map<FlurrHandle, std::unique_ptr<VertexBuffer>> m_vertexBuffers;
-  std::vector<FlurrHandle> m_vertexBufferHandles;
+  SlotMap<std::unique_ptr<VertexBuffer>> m_vertexBuffers;
   // Vertex arrays
-  FlurrHandle m_nextIndexedGeometryHandle;
-  std::unordered_map<FlurrHandle, std::unique_ptr<IndexedGeometry>> m_indexedGeometries;
-  std::vector<FlurrHandle> m_indexedGeometryHandles;
+  SlotMap<std::unique_ptr<IndexedGeometry>> m_indexedGeometries;
+  // Geometry arenas
+  SlotMap<std::unique_ptr<GeometryArena>> m_geometryArenas;
+  // Render targets
+  SlotMap<std::unique_ptr<RenderTarget>> m_renderTargets;
+  FlurrHandle m_renderTargetHandle;
+  FlurrHandle m_offscreenTargetHandle;
+  glm::ivec4 m_viewport; // for the default framebuffer
+  // Render queue
+  RenderQueue m_renderQueue;
+  // Per-frame uniforms
+  FrameUniforms m_frameUniforms;
 };
 
 } // namespace flurr
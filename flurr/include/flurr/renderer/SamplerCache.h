@@ -0,0 +1,63 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+#include "flurr/renderer/Texture.h"
+
+#include <GL/glew.h>
+
+#include <string>
+#include <unordered_map>
+
+namespace flurr
+{
+
+enum class TextureFilteringQuality : uint8_t
+{
+  kBilinear = 0,
+  kTrilinear,
+  kAnisotropic
+};
+
+/**
+ * Deduplicated OGL sampler objects, shared by all textures with the same sampling state.
+ * Samplers following the global filtering quality are updated in place when it changes,
+ * so textures keep their sampler IDs.
+ * Samplers are only requested by OpenGL textures, so the cache stays empty with the null backend.
+ */
+class FLURR_DLL_EXPORT SamplerCache
+{
+
+public:
+
+  SamplerCache();
+  SamplerCache(const SamplerCache&) = delete;
+  SamplerCache(SamplerCache&&) = delete;
+  SamplerCache& operator=(const SamplerCache&) = delete;
+  SamplerCache& operator=(SamplerCache&&) = delete;
+  ~SamplerCache() = default;
+
+  void init(TextureFilteringQuality a_filteringQuality, uint32_t a_anisotropyLevel);
+  void shutdown();
+
+  GLuint getSampler(const SamplerDesc& a_samplerDesc); // creates the sampler on first use
+  std::size_t getSamplerCount() const { return m_oglSamplerIdsByKey.size(); }
+  TextureFilteringQuality getFilteringQuality() const { return m_filteringQuality; }
+  uint32_t getAnisotropyLevel() const { return m_anisotropyLevel; }
+  uint32_t getMaxAnisotropyLevel() const { return m_maxAnisotropyLevel; } // 1 if anisotropic filtering not supported
+  void setFilteringQuality(TextureFilteringQuality a_filteringQuality, uint32_t a_anisotropyLevel);
+
+  static uint32_t MakeSamplerKey(const SamplerDesc& a_samplerDesc);
+  static SamplerDesc GetSamplerDesc(uint32_t a_samplerKey);
+  static bool ParseFilteringQuality(const std::string& a_str, TextureFilteringQuality& a_filteringQuality); // Bilinear, Trilinear or Anisotropic
+
+private:
+
+  void setSamplerParameters(GLuint a_oglSamplerId, const SamplerDesc& a_samplerDesc) const;
+
+  TextureFilteringQuality m_filteringQuality;
+  uint32_t m_anisotropyLevel;
+  uint32_t m_maxAnisotropyLevel;
+  std::unordered_map<uint32_t, GLuint> m_oglSamplerIdsByKey;
+};
+
+} // namespace flurr
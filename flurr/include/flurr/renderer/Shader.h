@@ -33,18 +33,24 @@ public:
 
   ShaderType getShaderType() const { return m_shaderType; }
   ShaderProgram* getOwningProgram() const { return m_owningProgram; }
+  const std::string& getSource() const { return m_source; }
+  const std::string& getSourcePath() const { return m_sourcePath; }
 
   GLuint getOGLShaderId() const { return m_oglShaderId; }
 
 private:
 
-  Status compile(FlurrHandle a_shaderResourceHandle);
+  Status loadSource(FlurrHandle a_shaderResourceHandle);
+  Status compile(); // submit only, see checkCompileStatus
+  Status checkCompileStatus() const;
   void destroy();
 
   GLenum getOGLShaderType(ShaderType a_shaderType) const;
 
   ShaderType m_shaderType;
   ShaderProgram* m_owningProgram;
+  std::string m_source;
+  std::string m_sourcePath;
   GLuint m_oglShaderId;
 };
 
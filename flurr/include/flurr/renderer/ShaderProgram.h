@@ -8,20 +8,28 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace flurr
 {
 
+// Index of an active uniform in the reflected uniform table of a linked program
+using UniformHandle = int32_t;
+constexpr UniformHandle INVALID_UNIFORM_HANDLE = -1;
+
 enum class ShaderProgramState : uint8_t
 {
   kDestroyed = 0,
-  kCompiled,
+  kCompiled, // shader sources set, compiled on link
+  kLinking, // compile and link submitted, waiting for the driver
   kLinked
 };
 
 class FLURR_DLL_EXPORT ShaderProgram
 {
   friend class Renderer;
+  friend class OGLRenderBackend;
+  friend class NullRenderBackend;
 
 public:
 
@@ -38,26 +46,66 @@ public:
   bool hasShader(ShaderType a_shaderType) const;
   Shader* getShader(ShaderType a_shaderType) const;
 
-  bool setFloatValue(const std::string& a_name, float a_value);
-  bool setVec2Value(const std::string& a_name, const glm::vec2& a_value);
-  bool setVec3Value(const std::string& a_name, const glm::vec3& a_value);
-  bool setVec4Value(const std::string& a_name, const glm::vec4& a_value);
-  bool setMat4Value(const std::string& a_name, const glm::mat4& a_value);
-  bool setIntValue(const std::string& a_name, int a_value);
-  bool setUIntValue(const std::string& a_name, uint32_t a_value);
-  bool setBoolValue(const std::string& a_name, bool a_value);
+  // Uniforms are reflected when the program is linked; look up handles once and reuse them
+  UniformHandle getUniformHandle(const char* a_name) const;
+  std::size_t getUniformCount() const { return m_uniforms.size(); }
+  const std::string& getUniformName(UniformHandle a_uniform) const { return m_uniforms[a_uniform].name; }
+  GLint getUniformLocation(UniformHandle a_uniform) const { return m_uniforms[a_uniform].oglLocation; }
+  GLenum getUniformType(UniformHandle a_uniform) const { return m_uniforms[a_uniform].oglType; }
+  bool isValidUniformHandle(UniformHandle a_uniform) const { return a_uniform >= 0 && static_cast<std::size_t>(a_uniform) < m_uniforms.size(); }
+
+  // Setters require the program to be in use; unchanged values are not resent to OGL
+  bool setFloatValue(UniformHandle a_uniform, float a_value);
+  bool setVec2Value(UniformHandle a_uniform, const glm::vec2& a_value);
+  bool setVec3Value(UniformHandle a_uniform, const glm::vec3& a_value);
+  bool setVec4Value(UniformHandle a_uniform, const glm::vec4& a_value);
+  bool setMat4Value(UniformHandle a_uniform, const glm::mat4& a_value);
+  bool setIntValue(UniformHandle a_uniform, int a_value);
+  bool setUIntValue(UniformHandle a_uniform, uint32_t a_value);
+  bool setBoolValue(UniformHandle a_uniform, bool a_value);
+  bool setFloatValue(const char* a_name, float a_value) { return setFloatValue(getUniformHandle(a_name), a_value); }
+  bool setVec2Value(const char* a_name, const glm::vec2& a_value) { return setVec2Value(getUniformHandle(a_name), a_value); }
+  bool setVec3Value(const char* a_name, const glm::vec3& a_value) { return setVec3Value(getUniformHandle(a_name), a_value); }
+  bool setVec4Value(const char* a_name, const glm::vec4& a_value) { return setVec4Value(getUniformHandle(a_name), a_value); }
+  bool setMat4Value(const char* a_name, const glm::mat4& a_value) { return setMat4Value(getUniformHandle(a_name), a_value); }
+  bool setIntValue(const char* a_name, int a_value) { return setIntValue(getUniformHandle(a_name), a_value); }
+  bool setUIntValue(const char* a_name, uint32_t a_value) { return setUIntValue(getUniformHandle(a_name), a_value); }
+  bool setBoolValue(const char* a_name, bool a_value) { return setBoolValue(getUniformHandle(a_name), a_value); }
 
   GLuint getOGLShaderProgramId() const { return m_oglProgramId; }
 
 private:
 
-  Status linkProgram();
+  Status linkProgram(); // blocking
+  Status beginLink();
+  bool isLinkComplete() const; // never blocks
+  Status finishLink(); // blocks if link not complete
+  void cancelLink();
   void destroyProgram();
   Status useProgram();
+  void reflectUniforms();
+  uint64_t computeSourceHash() const;
+  template <typename T>
+  bool updateUniformShadowValue(UniformHandle a_uniform, const T& a_value);
+
+  static constexpr std::size_t kMaxUniformValueSize = 16 * sizeof(float);
+
+  struct Uniform
+  {
+    std::string name; // without array suffix
+    GLint oglLocation;
+    GLenum oglType;
+    GLint arraySize;
+    bool shadowValueSet;
+    uint8_t shadowValue[kMaxUniformValueSize]; // last value set through the program
+  };
 
   FlurrHandle m_programHandle;
   ShaderProgramState m_programState;
   std::unordered_map<ShaderType, std::unique_ptr<Shader>> m_shadersByType;
+  std::vector<Uniform> m_uniforms;
+  uint64_t m_sourceHash;
+  bool m_linkedFromCache;
 
   GLuint m_oglProgramId;
 };
@@ -7,6 +7,7 @@
 #include <GL/glew.h>
 
 #include <mutex>
+#include <vector>
 
 namespace flurr
 {
@@ -32,12 +33,23 @@ enum class TextureMagFilterMode {
   kLinear
 };
 
+/** Sampling state of a texture; anisotropy level 0 follows the global filtering quality. */
+struct SamplerDesc
+{
+  TextureWrapMode wrapMode = TextureWrapMode::kRepeat;
+  TextureMinFilterMode minFilterMode = TextureMinFilterMode::kLinearMipmapLinear;
+  TextureMagFilterMode magFilterMode = TextureMagFilterMode::kLinear;
+  uint8_t anisotropyLevel = 0;
+};
+
 using TextureUnitIndex = uint32_t;
 constexpr TextureUnitIndex MAX_TEXTURE_UNIT = 15;
 
 class FLURR_DLL_EXPORT Texture
 {
   friend class Renderer;
+  friend class OGLRenderBackend;
+  friend class TextureUploader;
 
 public:
 
@@ -53,24 +65,54 @@ public:
   TextureWrapMode getWrapMode() { return m_texWrapMode; }
   TextureMinFilterMode getMinFilterMode() const { return m_texMinFilterMode; }
   TextureMagFilterMode getMagFilterMode() const { return m_texMagFilterMode; }
+  SamplerDesc getSamplerDesc() const { return SamplerDesc{m_texWrapMode, m_texMinFilterMode, m_texMagFilterMode, 0}; }
+  uint32_t getWidth() const { return m_texWidth; }
+  uint32_t getHeight() const { return m_texHeight; }
+  std::size_t getDataSize() const { return m_texDataSize; } // of all uploaded mip levels, in bytes
+  bool isCompressed() const { return m_compressed; }
+  std::size_t getMipLevelCount() const { return m_mipLevels.size(); } // stored in the resource, excludes generated levels
+  bool isArrayLayer() const { return INVALID_HANDLE != m_arrayHandle; }
+  FlurrHandle getTextureArrayHandle() const { return m_arrayHandle; } // INVALID_HANDLE if not in an array
+  uint32_t getArrayLayer() const { return m_arrayLayer; }
+  bool isUploadPending() const { return m_uploadPending; } // contents undefined until async upload completes
+
+  static bool GetOGLTextureFormat(TextureFormat a_texFormat, GLint& a_oglInternalTexFormat, GLint& a_oglTexFormat);
+  static GLint GetOGLTextureWrapMode(TextureWrapMode a_texWrapMode);
+  static GLint GetOGLTextureMinFilterMode(TextureMinFilterMode a_texMinFilterMode);
+  static GLint GetOGLTextureMagFilterMode(TextureMagFilterMode a_texMagFilterMode);
+  static bool IsMipmapFilterMode(TextureMinFilterMode a_texMinFilterMode);
 
 private:
 
-  Status initTexture(FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode = TextureWrapMode::kRepeat, TextureMinFilterMode a_texMinFilterMode = TextureMinFilterMode::kLinearMipmapLinear, TextureMagFilterMode a_texMagFilterMode = TextureMagFilterMode::kLinear);
+  Status initTexture(FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode = TextureWrapMode::kRepeat, TextureMinFilterMode a_texMinFilterMode = TextureMinFilterMode::kLinearMipmapLinear, TextureMagFilterMode a_texMagFilterMode = TextureMagFilterMode::kLinear, bool a_asyncUpload = false);
+  Status initArrayLayer(FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode);
+  Status lockTextureResource(FlurrHandle a_texResourceHandle, std::unique_lock<std::mutex>& a_resourceLock, TextureResource** a_texResource) const;
+  Status checkTextureResource(FlurrHandle a_texResourceHandle) const; // backend-independent checks, done before initialization
+  Status uploadFromPixelBuffer(GLuint a_oglPixelBufferId); // data at offset 0 of the PBO
+  void onUploadComplete() { m_uploadPending = false; }
+  bool hasMipmaps() const;
+  void setTextureLevels(const void* a_data); // null only allocates storage
   void destroyTexture();
   Status useTexture(TextureUnitIndex a_texUnit = 0);
-  bool getOGLTextureFormat(TextureFormat a_texFormat, GLint& a_oglInternalTexFormat, GLint& a_oglTexFormat) const;
-  GLint getOGLTextureWrapMode(TextureWrapMode a_texWrapMode) const;
-  GLint getOGLTextureMinFilterMode(TextureMinFilterMode a_texMinFilterMode) const;
-  GLint getOGLTextureMagFilterMode(TextureMagFilterMode a_texMagFilterMode) const;
 
   FlurrHandle m_texHandle;
   FlurrHandle m_texResourceHandle;
   TextureWrapMode m_texWrapMode;
   TextureMinFilterMode m_texMinFilterMode;
   TextureMagFilterMode m_texMagFilterMode;
-
-  GLuint m_oglTexId;
+  uint32_t m_texWidth;
+  uint32_t m_texHeight;
+  std::size_t m_texDataSize;
+  std::vector<TextureMipLevel> m_mipLevels;
+  bool m_compressed;
+  bool m_uploadPending;
+  FlurrHandle m_arrayHandle;
+  uint32_t m_arrayLayer;
+
+  GLuint m_oglTexId; // 0 for array layers
+  GLuint m_oglSamplerId;
+  GLint m_oglInternalTexFormat;
+  GLint m_oglTexFormat;
 };
 
 } // namespace flurr
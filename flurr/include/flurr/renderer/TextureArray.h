@@ -0,0 +1,75 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+#include "flurr/renderer/Texture.h"
+
+#include <GL/glew.h>
+
+#include <vector>
+
+namespace flurr
+{
+
+/**
+ * GL_TEXTURE_2D_ARRAY with immutable storage (glTexStorage3D), whose layers hold
+ * textures of the same size, format and sampling. Draws using textures from one array
+ * need no texture rebinds; shaders select the layer instead.
+ */
+class FLURR_DLL_EXPORT TextureArray
+{
+  friend class Renderer;
+  friend class Texture;
+  friend class OGLRenderBackend;
+
+public:
+
+  static constexpr uint32_t kDefaultLayerCapacity = 16;
+
+  TextureArray(FlurrHandle a_arrayHandle);
+  TextureArray(const TextureArray&) = delete;
+  TextureArray(TextureArray&&) = default;
+  TextureArray& operator=(const TextureArray&) = delete;
+  TextureArray& operator=(TextureArray&&) = default;
+  ~TextureArray() = default;
+
+  FlurrHandle getArrayHandle() const { return m_arrayHandle; }
+  bool isCreated() const { return 0 != m_oglTexArrayId; }
+  uint32_t getWidth() const { return m_texWidth; }
+  uint32_t getHeight() const { return m_texHeight; }
+  TextureFormat getTextureFormat() const { return m_texFormat; }
+  uint32_t getMipLevelCount() const { return m_mipLevelCount; }
+  uint32_t getLayerCapacity() const { return m_layerCapacity; }
+  uint32_t getLayerCount() const { return m_layerCapacity - static_cast<uint32_t>(m_freeLayers.size()); } // allocated layers
+  bool hasFreeLayer() const { return !m_freeLayers.empty(); }
+  bool isCompatible(uint32_t a_width, uint32_t a_height, TextureFormat a_texFormat, uint32_t a_mipLevelCount,
+    TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode) const;
+  GLuint getOGLTextureArrayId() const { return m_oglTexArrayId; }
+
+  static uint32_t FullMipLevelCount(uint32_t a_width, uint32_t a_height);
+
+private:
+
+  Status initArray(uint32_t a_width, uint32_t a_height, TextureFormat a_texFormat, uint32_t a_mipLevelCount, uint32_t a_layerCapacity,
+    TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode);
+  void destroyArray();
+  Status allocateLayer(uint32_t& a_layer);
+  void freeLayer(uint32_t a_layer);
+  Status uploadLayer(uint32_t a_layer, const uint8_t* a_data, const std::vector<TextureMipLevel>& a_mipLevels);
+
+  FlurrHandle m_arrayHandle;
+  uint32_t m_texWidth;
+  uint32_t m_texHeight;
+  TextureFormat m_texFormat;
+  uint32_t m_mipLevelCount;
+  uint32_t m_layerCapacity;
+  TextureWrapMode m_texWrapMode;
+  TextureMinFilterMode m_texMinFilterMode;
+  TextureMagFilterMode m_texMagFilterMode;
+  std::vector<uint32_t> m_freeLayers; // lowest layer on top
+
+  GLuint m_oglTexArrayId;
+  GLint m_oglInternalTexFormat;
+  GLint m_oglTexFormat;
+};
+
+} // namespace flurr
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+
+#include <GL/glew.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace flurr
+{
+
+/**
+ * Uploads texture data asynchronously through a pool of pixel buffer objects.
+ * The GL thread maps a PBO, the upload thread copies texture resource data into it,
+ * then the GL thread sources glTexSubImage2D from the PBO and fences the upload.
+ * The texture becomes ready to sample once the fence signals.
+ * Driven by the OpenGL backend's async texture init; never initialized without a GPU context.
+ */
+class FLURR_DLL_EXPORT TextureUploader
+{
+
+public:
+
+  static constexpr std::size_t kMaxPixelBufferCount = 4;
+
+  TextureUploader();
+  TextureUploader(const TextureUploader&) = delete;
+  TextureUploader(TextureUploader&&) = delete;
+  TextureUploader& operator=(const TextureUploader&) = delete;
+  TextureUploader& operator=(TextureUploader&&) = delete;
+  ~TextureUploader();
+
+  void init();
+  void shutdown();
+  void update(); // call on the GL thread once per frame
+
+  Status queueUpload(FlurrHandle a_texHandle, FlurrHandle a_texResourceHandle, std::size_t a_dataSize);
+  void cancelUpload(FlurrHandle a_texHandle);
+  std::size_t getPendingUploadCount() const { return m_uploads.size(); }
+  std::size_t getPixelBufferCount() const { return m_pixelBuffers.size(); }
+
+private:
+
+  enum class UploadState : uint8_t
+  {
+    kQueued = 0, // waiting for a free PBO
+    kCopying, // upload thread writing into mapped PBO
+    kTransferring, // PBO to texture copy fenced on the GPU
+    kDone // finished or failed, removed on update
+  };
+
+  struct PixelBuffer
+  {
+    GLuint oglBufferId;
+    std::size_t size;
+    bool inUse;
+  };
+
+  struct Upload
+  {
+    FlurrHandle texHandle;
+    FlurrHandle texResourceHandle;
+    std::size_t dataSize;
+    UploadState state;
+    std::size_t pixelBufferIndex;
+    GLsync oglFence;
+    bool cancelled;
+  };
+
+  struct CopyJob
+  {
+    FlurrHandle texHandle;
+    FlurrHandle texResourceHandle;
+    void* dst; // mapped PBO memory
+    std::size_t dataSize;
+  };
+
+  struct CopyResult
+  {
+    FlurrHandle texHandle;
+    Status status;
+  };
+
+  bool startUpload(Upload& a_upload);
+  void finishCopy(Upload& a_upload, Status a_copyStatus);
+  std::size_t acquirePixelBuffer(std::size_t a_dataSize);
+  void releasePixelBuffer(std::size_t a_pixelBufferIndex);
+  Upload* findUpload(FlurrHandle a_texHandle);
+  void uploadThread();
+  Status executeCopyJob(const CopyJob& a_job);
+
+  static constexpr std::size_t kInvalidPixelBufferIndex = ~static_cast<std::size_t>(0);
+  static constexpr int kUploadThreadSleepTime = 2;
+
+  bool m_initialized;
+  std::vector<PixelBuffer> m_pixelBuffers;
+  std::vector<Upload> m_uploads; // in submission order
+
+  std::thread m_uploadThread;
+  std::atomic_bool m_stopUploadThread;
+
+  std::mutex m_copyJobMutex;
+  std::vector<CopyJob> m_copyJobQueue;
+  std::vector<CopyJob> m_activeCopyJobs;
+
+  std::mutex m_copyResultMutex;
+  std::vector<CopyResult> m_copyResultQueue;
+  std::vector<CopyResult> m_activeCopyResults;
+};
+
+} // namespace flurr
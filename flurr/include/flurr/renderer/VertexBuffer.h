@@ -4,24 +4,37 @@
 
 #include <GL/glew.h>
 
+#include <deque>
+
 namespace flurr
 {
 
 enum class VertexBufferType
 {
   kVertexAttribute,
-  kIndex
+  kIndex,
+  kInstanceAttribute
 };
 
 enum class VertexDataUsage
 {
   kStatic,
-  kDynamic
+  kDynamic,
+  kStream // ring buffer for transient per-frame data, written through allocateTransient
+};
+
+// Index data is always supplied as 32-bit indices and converted to the buffer's index type on creation
+enum class IndexType
+{
+  kAuto, // 16-bit if static and all indices fit, otherwise 32-bit
+  kUnsigned16,
+  kUnsigned32
 };
 
 class FLURR_DLL_EXPORT VertexBuffer
 {
   friend class Renderer;
+  friend class OGLRenderBackend;
 
 public:
 
@@ -38,21 +51,52 @@ public:
   std::size_t getAttributeSize() const { return m_attributeSize; }
   VertexDataUsage getDataUsage() const { return m_dataUsage; }
   bool isCreated() const { return m_dataSize > 0; }
+  bool isMapped() const { return m_mapped; }
+  IndexType getIndexType() const { return m_indexType; } // index buffers only
+  std::size_t getIndexCount() const { return m_attributeSize > 0 ? m_dataSize / m_attributeSize : 0; } // index buffers only
+  uint32_t getMaxIndex() const { return m_maxIndex; } // index buffers only, excludes transient data
+  GLenum getOGLIndexType() const { return IndexType::kUnsigned16 == m_indexType ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT; }
 
   GLuint getOGLVertexBufferObjectId() const { return m_oglVboId; }
 
 private:
 
-  Status initBuffer(VertexBufferType a_bufferType, std::size_t a_dataSize, void* a_data, std::size_t a_attributeSize, VertexDataUsage a_dataUsage = VertexDataUsage::kStatic);
-  Status initIndexBuffer(std::size_t a_dataSize, void* a_data, VertexDataUsage a_dataUsage = VertexDataUsage::kStatic);
+  // Validate arguments and set properties, without touching the GPU
+  Status setBufferProperties(VertexBufferType a_bufferType, std::size_t a_dataSize, const void* a_data, std::size_t a_attributeSize, VertexDataUsage a_dataUsage = VertexDataUsage::kStatic);
+  Status setIndexBufferProperties(std::size_t a_dataSize, const void* a_data, VertexDataUsage a_dataUsage = VertexDataUsage::kStatic, IndexType a_indexType = IndexType::kAuto);
+  Status prepareUpdate(const void* a_data, std::size_t a_dataSize, std::size_t a_offset); // also tracks the largest index
+
+  Status initBuffer(const void* a_data); // index data as 32-bit indices
   void destroyBuffer();
   Status useBuffer();
+  Status updateData(const void* a_data, std::size_t a_dataSize, std::size_t a_offset);
+  Status mapTransient(std::size_t a_dataSize, void** a_writePtr, std::size_t& a_offset);
+  Status unmapTransient();
+  void fenceTransients();
+  void destroyFences();
+
+  static constexpr GLuint64 kStreamFenceTimeout = 1000000000; // ns
+
+  struct StreamFence
+  {
+    GLsync oglSync;
+    std::size_t allocatedSize; // bytes allocated since the previous fence
+  };
 
   FlurrHandle m_bufferHandle;
   VertexBufferType m_bufferType;
   std::size_t m_dataSize;
   std::size_t m_attributeSize;
   VertexDataUsage m_dataUsage;
+  IndexType m_indexType;
+  uint32_t m_maxIndex;
+  bool m_mapped;
+
+  // Stream ring buffer state
+  std::size_t m_streamHead; // next write offset
+  std::size_t m_streamUsedSize; // bytes that may still be read by the GPU, including unfenced bytes
+  std::size_t m_streamUnfencedSize; // bytes allocated since the last fence
+  std::deque<StreamFence> m_streamFences;
 
   GLuint m_oglVboId;
 };
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+
+#include <GL/glew.h>
+
+#include <vector>
+
+namespace flurr
+{
+
+enum class VertexAttributeType
+{
+  kFloat,
+  kHalfFloat,
+  kByte,
+  kUnsignedByte,
+  kShort,
+  kUnsignedShort,
+  kInt2_10_10_10, // packed signed XYZW, component count must be 4
+  kUnsignedInt2_10_10_10 // packed unsigned XYZW, component count must be 4
+};
+
+/** Single vertex attribute read from one of the geometry's attribute buffers (streams). */
+struct VertexAttribute
+{
+  GLuint location;
+  VertexAttributeType type;
+  uint32_t componentCount;
+  bool normalized; // map integer values to [0, 1] or [-1, 1]
+  uint32_t streamIndex; // index of attribute buffer
+  std::size_t offset; // in bytes, from the start of the vertex
+};
+
+/**
+ * Describes how vertex attributes are laid out in the attribute buffers of indexed geometry.
+ * Several attributes can be interleaved in the same stream. Stream stride is the attribute size
+ * of its vertex buffer, unless set explicitly.
+ */
+class FLURR_DLL_EXPORT VertexLayout
+{
+
+public:
+
+  VertexLayout() = default;
+  VertexLayout(const VertexLayout&) = default;
+  VertexLayout(VertexLayout&&) = default;
+  VertexLayout& operator=(const VertexLayout&) = default;
+  VertexLayout& operator=(VertexLayout&&) = default;
+  ~VertexLayout() = default;
+
+  static std::size_t GetAttributeTypeSize(VertexAttributeType a_type, uint32_t a_componentCount);
+  static GLenum GetOGLAttributeType(VertexAttributeType a_type);
+
+  VertexLayout& addAttribute(GLuint a_location, VertexAttributeType a_type, uint32_t a_componentCount, bool a_normalized = false, uint32_t a_streamIndex = 0);
+  VertexLayout& addAttribute(GLuint a_location, VertexAttributeType a_type, uint32_t a_componentCount, bool a_normalized, uint32_t a_streamIndex, std::size_t a_offset);
+  void setStreamStride(uint32_t a_streamIndex, std::size_t a_stride);
+
+  std::size_t getAttributeCount() const { return m_attributes.size(); }
+  const VertexAttribute& getAttribute(std::size_t a_attributeIndex) const { return m_attributes[a_attributeIndex]; }
+  uint32_t getStreamCount() const { return static_cast<uint32_t>(m_streamStrides.size()); }
+  std::size_t getStreamStride(uint32_t a_streamIndex) const; // 0 = use attribute size of vertex buffer
+  std::size_t getStreamPackedSize(uint32_t a_streamIndex) const; // end of the last attribute in stream
+  Status validate() const;
+
+private:
+
+  std::vector<VertexAttribute> m_attributes;
+  std::vector<std::size_t> m_streamStrides;
+};
+
+} // namespace flurr
@@ -2,6 +2,7 @@
 
 #include "flurr/FlurrDefines.h"
 #include "flurr/resource/Resource.h"
+#include "flurr/utils/SlotMap.h"
 
 #include <atomic>
 #include <mutex>
@@ -112,8 +113,7 @@ private:
 
   mutable std::mutex m_resourceMutex;
   std::vector<std::string> m_resourceDirectories;
-  FlurrHandle m_nextResourceHandle;
-  std::unordered_map<FlurrHandle, std::unique_ptr<Resource>> m_resources;
+  SlotMap<std::unique_ptr<Resource>> m_resources;
   std::unordered_map<std::string, FlurrHandle> m_resourceHandlesByPath;
 };
 
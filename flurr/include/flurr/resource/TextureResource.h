@@ -2,6 +2,9 @@
 
 #include "flurr/resource/Resource.h"
 
+#include <cstdio>
+#include <vector>
+
 namespace flurr
 {
 
@@ -9,7 +12,19 @@ enum class TextureFormat : uint32_t
 {
   kGrayscale,
   kRGB,
-  kRGBA
+  kRGBA,
+  kBC1, // DXT1, 4x4 blocks of 8 bytes
+  kBC2, // DXT3, 4x4 blocks of 16 bytes
+  kBC3 // DXT5, 4x4 blocks of 16 bytes
+};
+
+/** Location of a mip level in the texture data, level 0 is the full-size image. */
+struct TextureMipLevel
+{
+  uint32_t width;
+  uint32_t height;
+  std::size_t offset; // in bytes
+  std::size_t size; // in bytes
 };
 
 class FLURR_DLL_EXPORT TextureResource : public Resource
@@ -29,20 +44,30 @@ public:
   uint32_t getTextureWidth() const { return m_texWidth; }
   uint32_t getTextureHeight() const { return m_texHeight; }
   TextureFormat getTextureFormat() const { return m_texFormat; }
-  uint32_t getTextureDataSize() const { return m_texWidth*m_texHeight*getTexelSize(); }
-  uint32_t getTexelSize() const;
+  uint32_t getTextureDataSize() const; // all mip levels
+  uint32_t getTexelSize() const; // 0 for compressed formats
+  bool isCompressed() const { return IsCompressedFormat(m_texFormat); }
+  std::size_t getMipLevelCount() const { return m_mipLevels.size(); }
+  const TextureMipLevel& getMipLevel(std::size_t a_mipLevel) const { return m_mipLevels[a_mipLevel]; }
 
   static constexpr uint32_t TexelSize(const TextureFormat a_texFormat); // in bytes
+  static constexpr bool IsCompressedFormat(TextureFormat a_texFormat) { return a_texFormat >= TextureFormat::kBC1; }
+  static uint32_t BlockSize(TextureFormat a_texFormat); // in bytes per 4x4 block, 0 for uncompressed formats
+  static std::size_t CompressedLevelSize(TextureFormat a_texFormat, uint32_t a_width, uint32_t a_height);
 
 private:
 
   Status onLoad(const std::string& a_fullPath) override;
   void onUnload() override;
   void onDestroy() override {}
+  Status loadCompressedDDS(FILE* a_textureFile, const std::string& a_fullPath);
   void destroyTextureData();
   void FlipY();
+  void FlipCompressedY();
 
-  uint8_t* m_texData;
+  uint8_t* m_texData; // owned by stb_image, or points into m_compressedTexData
+  std::vector<uint8_t> m_compressedTexData;
+  std::vector<TextureMipLevel> m_mipLevels;
   uint32_t m_texWidth;
   uint32_t m_texHeight;
   TextureFormat m_texFormat;
@@ -4,6 +4,7 @@
 #include "flurr/scene/NodeComponent.h"
 
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 namespace flurr
 {
@@ -59,13 +60,16 @@ public:
   void setFarClipDistance(float a_fcd) { m_fcd = glm::clamp(a_fcd, kMinClipDistance, kMaxClipDistance); m_projTransfDirty = true; }
   float getAspectRatio() const { return ((float) m_vpw) / m_vph; }
   void applyRendererViewport();
-  void applyShaderViewProjectionMatrix(FlurrHandle a_shaderProgramHandle);
+  const glm::mat4& getViewTransform() const { updateTransforms(); return m_viewTransf; }
+  const glm::mat4& getProjectionTransform() const { updateTransforms(); return m_projTransf; }
+  const glm::mat4& getViewProjectionTransform() const { updateTransforms(); return m_viewProjTransf; }
 
 private:
 
   Status onInitComponent(const NodeComponentInitArgs& a_initArgs) override;
   void onDestroyComponent() override;
   Status onUpdateComponent(float a_deltaTime) override;
+  void updateTransforms() const;
 
   static constexpr uint32_t kMaxViewportSize = 100000;
   static constexpr float kMinClipDistance = 0.00001f;
@@ -75,8 +79,13 @@ private:
   float m_fov; // in radians
   int m_vpx, m_vpy, m_vpw, m_vph; // viewport
   float m_ncd, m_fcd; // near and far clipping distances
-  glm::mat4 m_projTransf;
-  bool m_projTransfDirty;
+  mutable glm::mat4 m_projTransf;
+  mutable bool m_projTransfDirty;
+  mutable glm::mat4 m_viewTransf;
+  mutable glm::mat4 m_viewProjTransf;
+  mutable glm::vec3 m_viewWorldPosition; // camera node world transform the view was computed from
+  mutable glm::quat m_viewWorldRotation;
+  mutable bool m_viewTransfValid;
 };
 
 } // namespace flurr
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+#include "flurr/scene/NodeComponent.h"
+#include "flurr/scene/StaticBatch.h"
+
+#include <memory>
+
+namespace flurr
+{
+
+struct ModelComponentInitArgs : public NodeComponentInitArgs
+{
+  NodeComponentType componentType() const override { return NodeComponentType::kModel; }
+  FlurrHandle programHandle = INVALID_HANDLE;
+  FlurrHandle geometryHandle = INVALID_HANDLE;
+  FlurrHandle texHandle = INVALID_HANDLE;
+  bool isStatic = false; // node never moves, so the model can be merged into a static batch
+  std::shared_ptr<const StaticMeshData> meshData; // CPU copy of the geometry, required for static batching
+};
+
+class FLURR_DLL_EXPORT ModelComponent : public NodeComponent
+{
+
+  friend class SceneManager;
+
+protected:
+
+  ModelComponent(FlurrHandle a_componentHandle, FlurrHandle a_containingNodeHandle, SceneManager* a_owningManager);
+
+public:
+
+  ~ModelComponent() override; // needed so unique_ptr can delete NodeComponent objects
+
+  NodeComponentType getComponentType() const override { return NodeComponentType::kModel; }
+  FlurrHandle getProgramHandle() const { return m_programHandle; }
+  FlurrHandle getGeometryHandle() const { return m_geometryHandle; }
+  FlurrHandle getTextureHandle() const { return m_texHandle; }
+  bool isStatic() const { return m_isStatic; }
+  const StaticMeshData* getMeshData() const { return m_meshData.get(); }
+  bool isVisible() const { return m_visible; }
+  void setVisible(bool a_visible);
+  bool isStaticBatched() const { return kNoStaticBatch != m_staticBatchIndex; }
+
+private:
+
+  Status onInitComponent(const NodeComponentInitArgs& a_initArgs) override;
+  void onDestroyComponent() override;
+  Status onUpdateComponent(float a_deltaTime) override;
+  Status onDrawComponent() override;
+
+  static constexpr std::size_t kNoStaticBatch = ~static_cast<std::size_t>(0);
+
+  FlurrHandle m_programHandle;
+  FlurrHandle m_geometryHandle;
+  FlurrHandle m_texHandle;
+  bool m_isStatic;
+  bool m_visible;
+  std::shared_ptr<const StaticMeshData> m_meshData;
+  std::size_t m_staticBatchIndex; // drawn as part of this batch instead of on its own
+  std::size_t m_staticBatchRangeIndex;
+};
+
+} // namespace flurr
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "flurr/FlurrDefines.h"
+#include "flurr/scene/StaticBatch.h"
+#include "flurr/utils/SlotMap.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -29,13 +31,18 @@ struct NodeComponentInitArgs
   virtual NodeComponentType componentType() const = 0;
 };
 
+class FramePacket;
+class RenderCommandList;
 class Node;
 class NodeComponent;
 class CameraComponent;
+class ModelComponent;
 
 class FLURR_DLL_EXPORT SceneManager
 {
 
+  friend class ModelComponent;
+
 public:
 
   SceneManager();
@@ -49,7 +56,7 @@ public:
   Status init();
   void shutdown();
   Status update(float a_deltaTime);
-  Status draw();
+  Status draw(FramePacket& a_framePacket); // records the frame's camera data and draws, without touching the renderer
 
   Node* getRootNode() const { return getNode(ROOT_NODE_HANDLE); }
   Status createNode(FlurrHandle& a_nodeHandle, const std::string& a_nodeName = "", FlurrHandle a_parentNodeHandle = INVALID_HANDLE,
@@ -73,6 +80,10 @@ public:
   std::vector<FlurrHandle> getAllComponentHandlesOfType(NodeComponentType a_componentType) const;
   CameraComponent* getActiveCamera() const;
   void setActiveCameraHandle(FlurrHandle cameraHandle);
+  Status buildStaticBatches(); // merges static models sharing a program and texture, replacing existing batches
+  void destroyStaticBatches();
+  std::size_t getStaticBatchCount() const { return m_staticBatches.size(); }
+  const StaticBatch* getStaticBatch(std::size_t a_batchIndex) const;
 
 private:
 
@@ -82,20 +93,26 @@ private:
   void removeComponent(FlurrHandle a_componentHandle);
   std::string generateNodeName();
   NodeComponent* createComponentOfType(FlurrHandle a_componentHandle, FlurrHandle a_nodeHandle, NodeComponentType a_componentType);
+  Status createStaticBatch(const std::vector<ModelComponent*>& a_models);
+  void setStaticBatchRangeVisible(std::size_t a_batchIndex, std::size_t a_rangeIndex, bool a_visible);
+  float getViewDepth(const glm::vec3& a_worldPosition) const;
+  RenderCommandList* getDrawCommandList() const { return m_drawCommandList; }
 
   bool m_initialized;
 
   // Nodes
-  FlurrHandle m_nextNodeHandle;
   uint32_t m_nextNodeNameIndex;
-  std::unordered_map<FlurrHandle, std::unique_ptr<Node>> m_nodes;
+  SlotMap<std::unique_ptr<Node>> m_nodes;
   std::unordered_map<std::string, FlurrHandle> m_nodeHandlesByName;
   // Node components
-  FlurrHandle m_nextComponentHandle;
-  std::unordered_map<FlurrHandle, std::unique_ptr<NodeComponent>> m_components;
+  SlotMap<std::unique_ptr<NodeComponent>> m_components;
   std::unordered_multimap<NodeComponentType, FlurrHandle> m_componentHandlesByType;
   // Rendering
   FlurrHandle m_activeCameraHandle;
+  std::vector<StaticBatch> m_staticBatches;
+  RenderCommandList* m_drawCommandList; // only set while drawing
+  float m_time;
+  float m_deltaTime;
 };
 
 } // namespace flurr
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+#include "flurr/renderer/VertexLayout.h"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace flurr
+{
+
+constexpr std::size_t NO_VERTEX_ATTRIBUTE = ~static_cast<std::size_t>(0);
+
+/**
+ * CPU copy of a mesh with a single interleaved vertex stream, kept so the mesh
+ * can be pre-transformed to world space and merged into a static batch.
+ */
+struct StaticMeshData
+{
+  VertexLayout vertexLayout; // single stream
+  std::size_t vertexStride = 0; // in bytes
+  std::vector<uint8_t> vertexData;
+  std::vector<uint32_t> indices;
+  std::size_t positionOffset = 0; // float XYZ, in bytes from the start of the vertex
+  std::size_t normalOffset = NO_VERTEX_ATTRIBUTE; // float XYZ, optional
+};
+
+/** Index range of one model merged into a static batch. */
+struct StaticBatchRange
+{
+  FlurrHandle componentHandle; // model component the range was merged from
+  std::size_t firstIndex;
+  std::size_t indexCount;
+  bool visible;
+};
+
+/**
+ * Merged geometry of static models sharing a shader program and texture, drawn with a single call.
+ * Hidden ranges are collapsed into degenerate triangles, so hiding a model never splits the draw.
+ */
+struct StaticBatch
+{
+  FlurrHandle programHandle = INVALID_HANDLE;
+  FlurrHandle texHandle = INVALID_HANDLE;
+  FlurrHandle vertexBufferHandle = INVALID_HANDLE;
+  FlurrHandle indexBufferHandle = INVALID_HANDLE;
+  FlurrHandle geometryHandle = INVALID_HANDLE;
+  std::vector<uint32_t> indices; // restored into the index buffer when a range is shown again
+  std::vector<StaticBatchRange> ranges;
+  std::size_t visibleRangeCount = 0;
+  std::vector<std::size_t> dirtyRangeIndices; // ranges shown or hidden since the last draw, written to the index buffer by the next frame packet
+  glm::vec3 center = glm::vec3(0.0f); // for depth sorting
+};
+
+/**
+ * Append a mesh transformed to world space to merged vertex data, and its indices rebased to the merged vertices.
+ * Normals are transformed by the inverse transpose and renormalized.
+ */
+FLURR_DLL_EXPORT Status AppendStaticMesh(const StaticMeshData& a_mesh, const glm::mat4& a_worldTransf,
+  std::vector<uint8_t>& a_vertexData, std::vector<uint32_t>& a_indices);
+
+/** Meshes can be merged if their vertex formats match. */
+FLURR_DLL_EXPORT bool IsStaticBatchCompatible(const StaticMeshData& a_mesh1, const StaticMeshData& a_mesh2);
+
+} // namespace flurr
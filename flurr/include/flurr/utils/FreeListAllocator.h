@@ -0,0 +1,52 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+
+#include <vector>
+
+namespace flurr
+{
+
+/**
+ * First-fit range allocator over [0, capacity) that tracks free blocks sorted by offset.
+ * Freed blocks are merged with adjacent free blocks. Units are up to the user
+ * (e.g. vertices or indices); the allocator does not own any memory.
+ */
+class FLURR_DLL_EXPORT FreeListAllocator
+{
+
+public:
+
+  static constexpr std::size_t kInvalidOffset = ~static_cast<std::size_t>(0);
+
+  explicit FreeListAllocator(std::size_t a_capacity = 0);
+  FreeListAllocator(const FreeListAllocator&) = default;
+  FreeListAllocator(FreeListAllocator&&) = default;
+  FreeListAllocator& operator=(const FreeListAllocator&) = default;
+  FreeListAllocator& operator=(FreeListAllocator&&) = default;
+  ~FreeListAllocator() = default;
+
+  void reset(std::size_t a_capacity); // free everything
+  std::size_t allocate(std::size_t a_size); // returns kInvalidOffset if no free block is large enough
+  void free(std::size_t a_offset, std::size_t a_size);
+
+  std::size_t getCapacity() const { return m_capacity; }
+  std::size_t getFreeSize() const { return m_freeSize; }
+  std::size_t getUsedSize() const { return m_capacity - m_freeSize; }
+  std::size_t getFreeBlockCount() const { return m_freeBlocks.size(); }
+  std::size_t getLargestFreeBlockSize() const;
+
+private:
+
+  struct FreeBlock
+  {
+    std::size_t offset;
+    std::size_t size;
+  };
+
+  std::size_t m_capacity;
+  std::size_t m_freeSize;
+  std::vector<FreeBlock> m_freeBlocks;
+};
+
+} // namespace flurr
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "flurr/FlurrDefines.h"
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace flurr
+{
+
+/**
+ * Generational slot map that owns objects of type T and hands out FlurrHandles to them.
+ *
+ * Values are stored densely (removal swaps the last value into the freed position),
+ * while a sparse slot array maps handles to dense indices. A handle encodes the slot
+ * index (+1, so that no handle is ever INVALID_HANDLE) and the slot generation, which
+ * is incremented whenever the slot is freed, so lookups with stale handles fail.
+ */
+template <typename T>
+class SlotMap
+{
+
+public:
+
+  using ValueType = T;
+  using Iterator = typename std::vector<T>::iterator;
+  using ConstIterator = typename std::vector<T>::const_iterator;
+
+  static constexpr uint32_t kIndexBits = 20;
+  static constexpr uint32_t kGenerationBits = 11;
+  static constexpr FlurrHandle kIndexMask = (1u << kIndexBits) - 1;
+  static constexpr FlurrHandle kGenerationMask = ((1u << kGenerationBits) - 1) << kIndexBits;
+  static constexpr FlurrHandle kFreeFlag = 1u << (kIndexBits + kGenerationBits); // only ever set on free slots
+  static constexpr std::size_t kMaxSize = kIndexMask;
+
+  static constexpr uint32_t SlotIndexOf(FlurrHandle a_handle) { return (a_handle & kIndexMask) - 1u; }
+  static constexpr uint32_t GenerationOf(FlurrHandle a_handle) { return (a_handle & kGenerationMask) >> kIndexBits; }
+
+  /** Get the handle that the next call to insert will return. */
+  FlurrHandle getNextHandle() const
+  {
+    return kNoFreeSlot != m_freeSlotIndex ?
+      (m_slots[m_freeSlotIndex].handle & ~kFreeFlag) :
+      static_cast<FlurrHandle>(m_slots.size() + 1);
+  }
+
+  /** Insert value into the map and return its handle. */
+  FlurrHandle insert(T a_value)
+  {
+    assert(m_values.size() < kMaxSize);
+
+    uint32_t slotIndex = m_freeSlotIndex;
+    if (kNoFreeSlot != slotIndex)
+    {
+      // Reuse a free slot, its handle already carries the next generation
+      m_freeSlotIndex = m_slots[slotIndex].denseIndex;
+      m_slots[slotIndex].handle &= ~kFreeFlag;
+    }
+    else
+    {
+      slotIndex = static_cast<uint32_t>(m_slots.size());
+      m_slots.push_back(Slot{slotIndex + 1u, 0});
+    }
+
+    Slot& slot = m_slots[slotIndex];
+    slot.denseIndex = static_cast<uint32_t>(m_values.size());
+    m_values.push_back(std::move(a_value));
+    m_handles.push_back(slot.handle);
+
+    return slot.handle;
+  }
+
+  /** Remove the value with the specified handle; returns false if the handle is not valid. */
+  bool erase(FlurrHandle a_handle)
+  {
+    if (!contains(a_handle))
+      return false;
+
+    const uint32_t slotIndex = SlotIndexOf(a_handle);
+    const uint32_t denseIndex = m_slots[slotIndex].denseIndex;
+    const uint32_t lastDenseIndex = static_cast<uint32_t>(m_values.size() - 1);
+
+    // Move last value into the freed position
+    if (denseIndex != lastDenseIndex)
+    {
+      m_values[denseIndex] = std::move(m_values[lastDenseIndex]);
+      m_handles[denseIndex] = m_handles[lastDenseIndex];
+      m_slots[SlotIndexOf(m_handles[denseIndex])].denseIndex = denseIndex;
+    }
+    m_values.pop_back();
+    m_handles.pop_back();
+
+    // Bump slot generation and push the slot onto the free list
+    const FlurrHandle nextGeneration = ((GenerationOf(a_handle) + 1) << kIndexBits) & kGenerationMask;
+    m_slots[slotIndex].handle = (slotIndex + 1u) | nextGeneration | kFreeFlag;
+    m_slots[slotIndex].denseIndex = m_freeSlotIndex;
+    m_freeSlotIndex = slotIndex;
+
+    return true;
+  }
+
+  /** Remove all values and reset handle generation, so handles are issued anew starting from 1. */
+  void clear()
+  {
+    m_slots.clear();
+    m_values.clear();
+    m_handles.clear();
+    m_freeSlotIndex = kNoFreeSlot;
+  }
+
+  void reserve(std::size_t a_capacity)
+  {
+    m_slots.reserve(a_capacity);
+    m_values.reserve(a_capacity);
+    m_handles.reserve(a_capacity);
+  }
+
+  bool contains(FlurrHandle a_handle) const
+  {
+    const uint32_t slotIndex = SlotIndexOf(a_handle);
+    return slotIndex < m_slots.size() && m_slots[slotIndex].handle == a_handle;
+  }
+
+  T* get(FlurrHandle a_handle)
+  {
+    const uint32_t slotIndex = SlotIndexOf(a_handle);
+    return slotIndex < m_slots.size() && m_slots[slotIndex].handle == a_handle ?
+      &m_values[m_slots[slotIndex].denseIndex] : nullptr;
+  }
+
+  const T* get(FlurrHandle a_handle) const
+  {
+    return const_cast<SlotMap*>(this)->get(a_handle);
+  }
+
+  // Dense access (indices are invalidated by erase)
+  std::size_t size() const { return m_values.size(); }
+  bool empty() const { return m_values.empty(); }
+  T& getByIndex(std::size_t a_index) { return m_values[a_index]; }
+  const T& getByIndex(std::size_t a_index) const { return m_values[a_index]; }
+  FlurrHandle getHandleByIndex(std::size_t a_index) const { return m_handles[a_index]; }
+  const std::vector<FlurrHandle>& getHandles() const { return m_handles; }
+  Iterator begin() { return m_values.begin(); }
+  Iterator end() { return m_values.end(); }
+  ConstIterator begin() const { return m_values.begin(); }
+  ConstIterator end() const { return m_values.end(); }
+
+private:
+
+  struct Slot
+  {
+    FlurrHandle handle; // current handle of occupied slot, or next handle | kFreeFlag of free slot
+    uint32_t denseIndex; // index into m_values, or next free slot index if slot is free
+  };
+
+  static constexpr uint32_t kNoFreeSlot = ~0u;
+
+  std::vector<Slot> m_slots;
+  std::vector<T> m_values;
+  std::vector<FlurrHandle> m_handles;
+  uint32_t m_freeSlotIndex = kNoFreeSlot;
+};
+
+} // namespace flurr
@@ -5,8 +5,16 @@ layout (location = 1) in vec2 inUV;
 
 out vec2 uv;
 
+layout (std140) uniform FrameUniforms
+{
+  mat4 viewTransf;
+  mat4 projTransf;
+  mat4 viewProjTransf;
+  vec4 cameraPosition;
+  vec4 time;
+};
+
 uniform mat4 modelTransf;
-uniform mat4 viewProjTransf;
 
 void main()
 {
@@ -0,0 +1,22 @@
+#version 330 core
+
+layout (location = 0) in vec3 inPos;
+layout (location = 1) in vec2 inUV;
+layout (location = 8) in mat4 instanceTransf;
+
+out vec2 uv;
+
+layout (std140) uniform FrameUniforms
+{
+  mat4 viewTransf;
+  mat4 projTransf;
+  mat4 viewProjTransf;
+  vec4 cameraPosition;
+  vec4 time;
+};
+
+void main()
+{
+  gl_Position = viewProjTransf * instanceTransf * vec4(inPos, 1.0f);
+  uv = inUV;
+}
@@ -9,7 +9,10 @@ FlurrCore::FlurrCore()
   : m_initialized(false),
   m_sceneManager(std::make_unique<SceneManager>()),
   m_resourceManager(std::make_unique<ResourceManager>()),
-  m_renderer(std::make_unique<Renderer>())
+  m_renderer(std::make_unique<Renderer>()),
+  m_frameIndex(0),
+  m_recordingPacket(nullptr),
+  m_renderThreadStatus(Status::kSuccess)
 {
 }
 
@@ -28,7 +31,10 @@ Status FlurrCore::init(const std::string& a_configPath)
     return Status::kSuccess;
   }
 
-  // TODO: load engine config
+  // Load engine config; missing settings fall back to defaults
+  ConfigFile config;
+  if (Status::kSuccess != config.readFromFile(a_configPath))
+    FLURR_LOG_WARN("Failed to read config file %s, using default settings.", a_configPath.c_str());
 
   // Initialize resource manager
   m_resourceManager->addResourceDirectory("./"); // TODO: condition this on a config setting
@@ -47,7 +53,7 @@ Status FlurrCore::init(const std::string& a_configPath)
   }
 
   // Initialize renderer
-  result = m_renderer->init();
+  result = m_renderer->init(&config);
   if (Status::kSuccess != result)
   {
     FLURR_LOG_ERROR("Failed to initialize Renderer!");
@@ -59,6 +65,43 @@ Status FlurrCore::init(const std::string& a_configPath)
   return Status::kSuccess;
 }
 
+Status FlurrCore::initHeadless(uint32_t a_width, uint32_t a_height, const std::string& a_configPath)
+{
+  if (isInitialized())
+  {
+    FLURR_LOG_WARN("flurr already initialized!");
+    return Status::kSuccess;
+  }
+
+  // Create windowless OpenGL context
+  m_headlessContext = std::make_unique<HeadlessContext>();
+  Status result = m_headlessContext->init();
+  if (Status::kSuccess != result)
+  {
+    FLURR_LOG_ERROR("Failed to create headless OpenGL context!");
+    m_headlessContext.reset();
+    return result;
+  }
+
+  result = init(a_configPath);
+  if (Status::kSuccess != result)
+  {
+    m_headlessContext.reset();
+    return result;
+  }
+
+  // There is no default framebuffer to present to, so render offscreen
+  result = m_renderer->createOffscreenFramebuffer(a_width, a_height);
+  if (Status::kSuccess != result)
+  {
+    FLURR_LOG_ERROR("Failed to create offscreen framebuffer!");
+    shutdown();
+    return result;
+  }
+
+  return Status::kSuccess;
+}
+
 void FlurrCore::shutdown()
 {
   FLURR_LOG_INFO("Shutting down flurr...");
@@ -68,10 +111,13 @@ void FlurrCore::shutdown()
     return;
   }
 
+  stopRenderThread();
+  m_recordingPacket = nullptr;
   m_renderer->shutdown();
   m_sceneManager->shutdown();
   m_resourceManager->stop();
   m_resourceManager->removeAllResourceDirectories();
+  m_headlessContext.reset(); // after the renderer has released its GL objects
 
   m_initialized = false;
   FLURR_LOG_INFO("flurr shutdown complete.");
@@ -96,34 +142,139 @@ Status FlurrCore::update(float a_deltaTime)
     return result;
   }
 
-  // Update renderer
-  if (m_renderer)
+  // Record the scene into this frame's packet
+  auto* framePacket = getFramePacket();
+  framePacket->setDeltaTime(a_deltaTime);
+  result = m_sceneManager->draw(*framePacket);
+  if (Status::kSuccess != result)
   {
-    if (!m_renderer->isInitialized())
-    {
-      FLURR_LOG_ERROR("Failed to update flurr; renderer not initialized!");
-      return Status::kNotInitialized;
-    }
+    FLURR_LOG_ERROR("Failed to draw the scene!");
+    framePacket->reset(m_frameIndex); // record the frame again next update
+    return result;
+  }
+  m_recordingPacket = nullptr;
+  ++m_frameIndex;
 
-    result = m_renderer->update(a_deltaTime);
+  // Hand the packet over to the render thread, which renders it while the next frame is recorded
+  if (isRenderThreadRunning())
+  {
+    m_framePacketExchange.endWrite();
+    result = m_renderThreadStatus.exchange(Status::kSuccess);
     if (Status::kSuccess != result)
-    {
-      FLURR_LOG_ERROR("Failed to update flurr renderer!");
-      return result;
-    }
+      FLURR_LOG_ERROR("Failed to render frame on the render thread!");
+    return result;
   }
 
-  // Draw the scene
-  result = m_sceneManager->draw();
-  if (Status::kSuccess != result)
+  return renderFramePacket(*framePacket);
+}
+
+FramePacket* FlurrCore::getFramePacket()
+{
+  if (m_recordingPacket)
+    return m_recordingPacket;
+
+  if (isRenderThreadRunning())
   {
-    FLURR_LOG_ERROR("Failed to draw the scene!");
-    return result;
+    // Wait for the render thread to finish with the older packet
+    m_recordingPacket = m_framePacketExchange.waitWrite();
+  }
+  else
+  {
+    m_recordingPacket = &m_framePacket;
   }
+  m_recordingPacket->reset(m_frameIndex);
+
+  return m_recordingPacket;
+}
+
+Status FlurrCore::startRenderThread(const RenderThreadCallbacks& a_callbacks)
+{
+  if (!isInitialized() || !m_renderer->isInitialized())
+  {
+    FLURR_LOG_ERROR("Unable to start render thread; flurr not initialized!");
+    return Status::kNotInitialized;
+  }
+
+  if (isRenderThreadRunning())
+  {
+    FLURR_LOG_WARN("Render thread already running!");
+    return Status::kSuccess;
+  }
+
+  if (m_recordingPacket)
+  {
+    FLURR_LOG_ERROR("Unable to start render thread while a frame is being recorded!");
+    return Status::kInvalidState;
+  }
+
+  FLURR_LOG_INFO("Starting render thread...");
+  m_framePacketExchange.reset();
+  m_renderThreadCallbacks = a_callbacks;
+  m_renderThreadStatus.store(Status::kSuccess);
+  m_renderThread = std::thread(&FlurrCore::renderThread, this);
 
   return Status::kSuccess;
 }
 
+void FlurrCore::stopRenderThread()
+{
+  if (!isRenderThreadRunning())
+    return;
+
+  // Unpublished packet is discarded
+  FLURR_LOG_INFO("Stopping render thread...");
+  m_recordingPacket = nullptr;
+  m_framePacketExchange.close();
+  m_renderThread.join();
+  m_framePacketExchange.reset();
+  m_renderThreadCallbacks = RenderThreadCallbacks();
+  FLURR_LOG_INFO("Render thread stopped.");
+}
+
+Status FlurrCore::renderFramePacket(const FramePacket& a_framePacket)
+{
+  if (!m_renderer->isInitialized())
+  {
+    FLURR_LOG_ERROR("Failed to update flurr; renderer not initialized!");
+    return Status::kNotInitialized;
+  }
+
+  // Queue the packet's draws
+  Status result = m_renderer->submitFramePacket(a_framePacket);
+  if (Status::kSuccess != result)
+    FLURR_LOG_ERROR("Failed to submit frame packet %llu!", static_cast<unsigned long long>(a_framePacket.getFrameIndex()));
+
+  // Update renderer (executes queued draws)
+  const Status updateResult = m_renderer->update(a_framePacket.getDeltaTime());
+  if (Status::kSuccess != updateResult)
+  {
+    FLURR_LOG_ERROR("Failed to update flurr renderer!");
+    result = updateResult;
+  }
+
+  return result;
+}
+
+void FlurrCore::renderThread()
+{
+  if (m_renderThreadCallbacks.onStart)
+    m_renderThreadCallbacks.onStart();
+
+  // Render packets until the exchange is closed and drained
+  while (const auto* framePacket = m_framePacketExchange.waitRead())
+  {
+    const Status result = renderFramePacket(*framePacket);
+    if (Status::kSuccess != result)
+      m_renderThreadStatus.store(result);
+    if (m_renderThreadCallbacks.onFrame)
+      m_renderThreadCallbacks.onFrame();
+    m_framePacketExchange.endRead();
+  }
+
+  if (m_renderThreadCallbacks.onStop)
+    m_renderThreadCallbacks.onStop();
+}
+
 FlurrCore& FlurrCore::Get()
 {
   static FlurrCore flurrCore;
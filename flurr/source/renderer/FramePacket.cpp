@@ -0,0 +1,141 @@
+#include "flurr/renderer/FramePacket.h"
+
+#include <cstring>
+
+namespace flurr
+{
+
+FramePacket::FramePacket()
+  : m_frameIndex(0),
+  m_deltaTime(0.0f),
+  m_hasFrameUniforms(false),
+  m_frameUniforms{glm::mat4(1.0f), glm::mat4(1.0f), glm::mat4(1.0f), glm::vec4(0.0f), glm::vec4(0.0f)},
+  m_viewport(0)
+{
+}
+
+void FramePacket::reset(uint64_t a_frameIndex)
+{
+  m_frameIndex = a_frameIndex;
+  m_deltaTime = 0.0f;
+  m_hasFrameUniforms = false;
+  m_viewport = glm::ivec4(0);
+  m_bufferUpdates.clear();
+  m_bufferUpdateData.clear();
+  m_commandList.clear();
+}
+
+void FramePacket::setFrameUniforms(const FrameUniforms& a_frameUniforms)
+{
+  m_frameUniforms = a_frameUniforms;
+  m_hasFrameUniforms = true;
+}
+
+void FramePacket::setViewport(int a_x, int a_y, uint32_t a_width, uint32_t a_height)
+{
+  m_viewport = glm::ivec4(a_x, a_y, static_cast<int>(a_width), static_cast<int>(a_height));
+}
+
+void FramePacket::addBufferUpdate(FlurrHandle a_bufferHandle, const void* a_data, std::size_t a_dataSize, std::size_t a_offset)
+{
+  // Copy the data, so the caller can reuse its memory right away
+  const std::size_t dataOffset = m_bufferUpdateData.size();
+  m_bufferUpdateData.resize(dataOffset + a_dataSize);
+  std::memcpy(m_bufferUpdateData.data() + dataOffset, a_data, a_dataSize);
+  m_bufferUpdates.push_back(FramePacketBufferUpdate{a_bufferHandle, a_offset, dataOffset, a_dataSize});
+}
+
+FramePacketExchange::FramePacketExchange()
+  : m_writeCount(0),
+  m_readCount(0),
+  m_closed(false)
+{
+}
+
+FramePacket* FramePacketExchange::beginWrite()
+{
+  const uint64_t writeCount = m_writeCount.load(std::memory_order_relaxed);
+  if (writeCount - m_readCount.load(std::memory_order_acquire) >= kPacketCount)
+    return nullptr;
+
+  return &m_packets[writeCount % kPacketCount];
+}
+
+FramePacket* FramePacketExchange::waitWrite()
+{
+  FramePacket* packet = beginWrite();
+  if (packet)
+    return packet;
+
+  std::unique_lock<std::mutex> lock(m_waitMutex);
+  m_waitCondition.wait(lock, [this, &packet]() { return nullptr != (packet = beginWrite()); });
+
+  return packet;
+}
+
+void FramePacketExchange::endWrite()
+{
+  m_writeCount.store(m_writeCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  notifyWaiters();
+}
+
+FramePacket* FramePacketExchange::beginRead()
+{
+  const uint64_t readCount = m_readCount.load(std::memory_order_relaxed);
+  if (readCount == m_writeCount.load(std::memory_order_acquire))
+    return nullptr;
+
+  return &m_packets[readCount % kPacketCount];
+}
+
+FramePacket* FramePacketExchange::waitRead()
+{
+  FramePacket* packet = beginRead();
+  if (packet)
+    return packet;
+
+  // Check closed first, so packets published before closing are still read
+  std::unique_lock<std::mutex> lock(m_waitMutex);
+  m_waitCondition.wait(lock, [this, &packet]()
+  {
+    const bool closed = m_closed;
+    packet = beginRead();
+    return packet || closed;
+  });
+
+  return packet;
+}
+
+void FramePacketExchange::endRead()
+{
+  m_readCount.store(m_readCount.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  notifyWaiters();
+}
+
+void FramePacketExchange::close()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_waitMutex);
+    m_closed = true;
+  }
+  m_waitCondition.notify_all();
+}
+
+void FramePacketExchange::reset()
+{
+  m_writeCount.store(0);
+  m_readCount.store(0);
+  std::lock_guard<std::mutex> lock(m_waitMutex);
+  m_closed = false;
+}
+
+void FramePacketExchange::notifyWaiters()
+{
+  // Taking the lock orders the count update before a waiter's check, so no wakeup is lost
+  {
+    std::lock_guard<std::mutex> lock(m_waitMutex);
+  }
+  m_waitCondition.notify_all();
+}
+
+} // namespace flurr
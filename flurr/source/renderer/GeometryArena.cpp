@@ -0,0 +1,390 @@
+#include "flurr/renderer/GeometryArena.h"
+#include "flurr/FlurrCore.h"
+#include "flurr/renderer/RenderBackend.h"
+#include "flurr/FlurrLog.h"
+
+#include <algorithm>
+
+namespace flurr
+{
+
+GeometryArena::GeometryArena(FlurrHandle a_arenaHandle, RenderBackend* a_backend)
+  : m_arenaHandle(a_arenaHandle),
+  m_backend(a_backend),
+  m_vertexStride(0),
+  m_indexType(IndexType::kUnsigned32),
+  m_oglVboId(0),
+  m_oglIboId(0),
+  m_oglVaoId(0)
+{
+}
+
+Status GeometryArena::addMesh(FlurrHandle& a_meshHandle, const void* a_vertexData, std::size_t a_vertexCount, const uint32_t* a_indexData, std::size_t a_indexCount)
+{
+  a_meshHandle = INVALID_HANDLE;
+  if (!isCreated())
+  {
+    FLURR_LOG_ERROR("Unable to add mesh to geometry arena; not created yet!");
+    return Status::kInvalidState;
+  }
+
+  if (nullptr == a_vertexData || nullptr == a_indexData)
+  {
+    FLURR_LOG_ERROR("Mesh data cannot be null!");
+    return Status::kNullArgument;
+  }
+
+  if (0 == a_vertexCount || 0 == a_indexCount)
+  {
+    FLURR_LOG_ERROR("Mesh vertex and index count must be > 0!");
+    return Status::kInvalidArgument;
+  }
+
+  // Check indices are within the mesh
+  for (std::size_t index = 0; index < a_indexCount; ++index)
+  {
+    if (a_indexData[index] >= a_vertexCount)
+    {
+      FLURR_LOG_ERROR("Mesh index %u out of bounds (vertex count is %u)!", a_indexData[index], static_cast<uint32_t>(a_vertexCount));
+      return Status::kIndexOutOfBounds;
+    }
+  }
+  if (IndexType::kUnsigned16 == m_indexType && a_vertexCount > UINT16_MAX + 1u)
+  {
+    FLURR_LOG_ERROR("Mesh has too many vertices for a 16-bit index geometry arena!");
+    return Status::kInvalidArgument;
+  }
+
+  // Compact the arena if there is enough free space, but not in one block
+  if ((m_vertexAllocator.getLargestFreeBlockSize() < a_vertexCount && m_vertexAllocator.getFreeSize() >= a_vertexCount) ||
+    (m_indexAllocator.getLargestFreeBlockSize() < a_indexCount && m_indexAllocator.getFreeSize() >= a_indexCount))
+  {
+    auto result = defragment();
+    if (result != Status::kSuccess)
+      return result;
+  }
+
+  // Sub-allocate vertices and indices
+  const std::size_t firstVertex = m_vertexAllocator.allocate(a_vertexCount);
+  if (FreeListAllocator::kInvalidOffset == firstVertex)
+  {
+    FLURR_LOG_ERROR("Unable to add mesh; geometry arena out of vertex space!");
+    return Status::kFailed;
+  }
+  const std::size_t firstIndex = m_indexAllocator.allocate(a_indexCount);
+  if (FreeListAllocator::kInvalidOffset == firstIndex)
+  {
+    m_vertexAllocator.free(firstVertex, a_vertexCount);
+    FLURR_LOG_ERROR("Unable to add mesh; geometry arena out of index space!");
+    return Status::kFailed;
+  }
+
+  // Upload mesh data
+  const ArenaMesh mesh{firstVertex, a_vertexCount, firstIndex, a_indexCount};
+  auto result = m_backend->updateArena(*this, mesh, a_vertexData, a_indexData);
+  if (result != Status::kSuccess)
+  {
+    m_vertexAllocator.free(firstVertex, a_vertexCount);
+    m_indexAllocator.free(firstIndex, a_indexCount);
+    return result;
+  }
+
+  a_meshHandle = m_meshes.insert(mesh);
+
+  return Status::kSuccess;
+}
+
+void GeometryArena::removeMesh(FlurrHandle a_meshHandle)
+{
+  const auto* mesh = m_meshes.get(a_meshHandle);
+  if (!mesh)
+  {
+    FLURR_LOG_WARN("No mesh with handle %u in geometry arena!", a_meshHandle);
+    return;
+  }
+
+  // Return mesh ranges to free lists
+  m_vertexAllocator.free(mesh->firstVertex, mesh->vertexCount);
+  m_indexAllocator.free(mesh->firstIndex, mesh->indexCount);
+  m_meshes.erase(a_meshHandle);
+}
+
+Status GeometryArena::defragment()
+{
+  if (!isCreated())
+  {
+    FLURR_LOG_ERROR("Unable to defragment geometry arena; not created yet!");
+    return Status::kInvalidState;
+  }
+
+  // Pack meshes at the start of the buffers, in their current order
+  std::vector<ArenaMesh> packedMeshes(m_meshes.begin(), m_meshes.end());
+  std::vector<ArenaMesh*> sortedMeshes;
+  sortedMeshes.reserve(packedMeshes.size());
+  for (auto& mesh : packedMeshes)
+    sortedMeshes.push_back(&mesh);
+
+  std::size_t vertexCount = 0;
+  std::sort(sortedMeshes.begin(), sortedMeshes.end(), [](const ArenaMesh* a_mesh1, const ArenaMesh* a_mesh2) { return a_mesh1->firstVertex < a_mesh2->firstVertex; });
+  for (auto* mesh : sortedMeshes)
+  {
+    mesh->firstVertex = vertexCount;
+    vertexCount += mesh->vertexCount;
+  }
+
+  std::size_t indexCount = 0;
+  std::sort(sortedMeshes.begin(), sortedMeshes.end(), [](const ArenaMesh* a_mesh1, const ArenaMesh* a_mesh2) { return a_mesh1->firstIndex < a_mesh2->firstIndex; });
+  for (auto* mesh : sortedMeshes)
+  {
+    mesh->firstIndex = indexCount;
+    indexCount += mesh->indexCount;
+  }
+
+  // Copy mesh data to the packed ranges
+  auto result = m_backend->copyArena(*this, packedMeshes);
+  if (result != Status::kSuccess)
+    return result;
+
+  std::size_t meshIndex = 0;
+  for (auto& mesh : m_meshes)
+    mesh = packedMeshes[meshIndex++];
+
+  // All free space is now at the end
+  m_vertexAllocator.reset(getVertexCapacity());
+  m_vertexAllocator.allocate(vertexCount);
+  m_indexAllocator.reset(getIndexCapacity());
+  m_indexAllocator.allocate(indexCount);
+
+  return Status::kSuccess;
+}
+
+Status GeometryArena::drawMesh(FlurrHandle a_meshHandle)
+{
+  const auto* mesh = m_meshes.get(a_meshHandle);
+  if (!mesh)
+  {
+    FLURR_LOG_ERROR("Unable to draw mesh; no mesh with handle %u in geometry arena!", a_meshHandle);
+    return Status::kInvalidHandle;
+  }
+
+  return m_backend->drawArenaMesh(*this, *mesh);
+}
+
+Status GeometryArena::drawMeshes(const std::vector<FlurrHandle>& a_meshHandles)
+{
+  for (const auto meshHandle : a_meshHandles)
+  {
+    if (!m_meshes.contains(meshHandle))
+    {
+      FLURR_LOG_ERROR("Unable to draw mesh; no mesh with handle %u in geometry arena!", meshHandle);
+      return Status::kInvalidHandle;
+    }
+  }
+
+  if (a_meshHandles.empty())
+    return Status::kSuccess;
+
+  // Draw all meshes with a single call
+  return m_backend->drawArenaMeshes(*this, a_meshHandles);
+}
+
+Status GeometryArena::setArenaProperties(const VertexLayout& a_vertexLayout, std::size_t a_vertexCapacity, std::size_t a_indexCapacity, IndexType a_indexType)
+{
+  if (isCreated())
+  {
+    FLURR_LOG_ERROR("Unable to create geometry arena; already created!");
+    return Status::kInvalidState;
+  }
+
+  if (0 == a_vertexCapacity || 0 == a_indexCapacity)
+  {
+    FLURR_LOG_ERROR("Geometry arena capacity must be > 0!");
+    return Status::kInvalidArgument;
+  }
+
+  if (a_vertexLayout.getStreamCount() != 1)
+  {
+    FLURR_LOG_ERROR("Geometry arena vertex layout must have exactly one stream!");
+    return Status::kInvalidArgument;
+  }
+
+  auto result = a_vertexLayout.validate();
+  if (result != Status::kSuccess)
+    return result;
+
+  // Set arena properties
+  m_vertexLayout = a_vertexLayout;
+  m_vertexStride = m_vertexLayout.getStreamStride(0) > 0 ? m_vertexLayout.getStreamStride(0) : m_vertexLayout.getStreamPackedSize(0);
+  m_indexType = IndexType::kUnsigned16 == a_indexType ? IndexType::kUnsigned16 : IndexType::kUnsigned32;
+  m_vertexAllocator.reset(a_vertexCapacity);
+  m_indexAllocator.reset(a_indexCapacity);
+
+  return Status::kSuccess;
+}
+
+Status GeometryArena::initArena()
+{
+  if (m_oglVaoId)
+  {
+    FLURR_LOG_ERROR("Unable to create geometry arena; already created!");
+    return Status::kInvalidState;
+  }
+
+  // Create OGL buffers
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+  glGenBuffers(1, &m_oglVboId);
+  stateCache.bindBuffer(GL_COPY_WRITE_BUFFER, m_oglVboId);
+  glBufferData(GL_COPY_WRITE_BUFFER, getVertexCapacity() * m_vertexStride, nullptr, GL_STATIC_DRAW);
+  glGenBuffers(1, &m_oglIboId);
+  stateCache.bindBuffer(GL_COPY_WRITE_BUFFER, m_oglIboId);
+  glBufferData(GL_COPY_WRITE_BUFFER, getIndexCapacity() * getIndexSize(), nullptr, GL_STATIC_DRAW);
+
+  // Create OGL vertex array shared by all meshes
+  glGenVertexArrays(1, &m_oglVaoId);
+  setVertexArrayBuffers();
+
+  return Status::kSuccess;
+}
+
+Status GeometryArena::uploadMesh(const ArenaMesh& a_mesh, const void* a_vertexData, const uint32_t* a_indexData)
+{
+  // Copy targets leave VAO element buffer binding alone
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+  stateCache.bindBuffer(GL_COPY_WRITE_BUFFER, m_oglVboId);
+  glBufferSubData(GL_COPY_WRITE_BUFFER, a_mesh.firstVertex * m_vertexStride, a_mesh.vertexCount * m_vertexStride, a_vertexData);
+  stateCache.bindBuffer(GL_COPY_WRITE_BUFFER, m_oglIboId);
+  if (IndexType::kUnsigned16 == m_indexType)
+  {
+    std::vector<uint16_t> shortIndices(a_indexData, a_indexData + a_mesh.indexCount);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, a_mesh.firstIndex * sizeof(uint16_t), a_mesh.indexCount * sizeof(uint16_t), shortIndices.data());
+  }
+  else
+  {
+    glBufferSubData(GL_COPY_WRITE_BUFFER, a_mesh.firstIndex * sizeof(uint32_t), a_mesh.indexCount * sizeof(uint32_t), a_indexData);
+  }
+
+  return Status::kSuccess;
+}
+
+Status GeometryArena::copyMeshes(const std::vector<ArenaMesh>& a_packedMeshes)
+{
+  // Create new buffers (OGL does not allow overlapping copies within a buffer)
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+  GLuint oglBufferIds[2] = {0, 0};
+  glGenBuffers(2, oglBufferIds);
+  stateCache.bindBuffer(GL_COPY_WRITE_BUFFER, oglBufferIds[0]);
+  glBufferData(GL_COPY_WRITE_BUFFER, getVertexCapacity() * m_vertexStride, nullptr, GL_STATIC_DRAW);
+  stateCache.bindBuffer(GL_COPY_WRITE_BUFFER, oglBufferIds[1]);
+  glBufferData(GL_COPY_WRITE_BUFFER, getIndexCapacity() * getIndexSize(), nullptr, GL_STATIC_DRAW);
+
+  // Copy each mesh to its packed range in the new buffers
+  stateCache.bindBuffer(GL_COPY_READ_BUFFER, m_oglVboId);
+  stateCache.bindBuffer(GL_COPY_WRITE_BUFFER, oglBufferIds[0]);
+  for (std::size_t meshIndex = 0; meshIndex < a_packedMeshes.size(); ++meshIndex)
+  {
+    const auto& mesh = m_meshes.getByIndex(meshIndex);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+      mesh.firstVertex * m_vertexStride, a_packedMeshes[meshIndex].firstVertex * m_vertexStride, mesh.vertexCount * m_vertexStride);
+  }
+  stateCache.bindBuffer(GL_COPY_READ_BUFFER, m_oglIboId);
+  stateCache.bindBuffer(GL_COPY_WRITE_BUFFER, oglBufferIds[1]);
+  for (std::size_t meshIndex = 0; meshIndex < a_packedMeshes.size(); ++meshIndex)
+  {
+    const auto& mesh = m_meshes.getByIndex(meshIndex);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+      mesh.firstIndex * getIndexSize(), a_packedMeshes[meshIndex].firstIndex * getIndexSize(), mesh.indexCount * getIndexSize());
+  }
+
+  // Replace old buffers
+  glDeleteBuffers(1, &m_oglVboId);
+  stateCache.onBufferDeleted(m_oglVboId);
+  glDeleteBuffers(1, &m_oglIboId);
+  stateCache.onBufferDeleted(m_oglIboId);
+  m_oglVboId = oglBufferIds[0];
+  m_oglIboId = oglBufferIds[1];
+  setVertexArrayBuffers();
+
+  return Status::kSuccess;
+}
+
+Status GeometryArena::drawOGLMesh(const ArenaMesh& a_mesh)
+{
+  // Draw the elements, offsetting indices by the mesh base vertex; buffer updates may have rebound the VAO's index buffer
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+  stateCache.bindVertexArray(m_oglVaoId);
+  stateCache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_oglIboId);
+  glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(a_mesh.indexCount), getOGLIndexType(),
+    reinterpret_cast<const void*>(a_mesh.firstIndex * getIndexSize()), static_cast<GLint>(a_mesh.firstVertex));
+
+  return Status::kSuccess;
+}
+
+Status GeometryArena::drawOGLMeshes(const std::vector<FlurrHandle>& a_meshHandles)
+{
+  // Gather draw parameters of all meshes
+  m_drawIndexCounts.clear();
+  m_drawIndexOffsets.clear();
+  m_drawBaseVertices.clear();
+  for (const auto meshHandle : a_meshHandles)
+  {
+    const auto* mesh = m_meshes.get(meshHandle);
+    m_drawIndexCounts.push_back(static_cast<GLsizei>(mesh->indexCount));
+    m_drawIndexOffsets.push_back(reinterpret_cast<const void*>(mesh->firstIndex * getIndexSize()));
+    m_drawBaseVertices.push_back(static_cast<GLint>(mesh->firstVertex));
+  }
+
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+  stateCache.bindVertexArray(m_oglVaoId);
+  stateCache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_oglIboId);
+  glMultiDrawElementsBaseVertex(GL_TRIANGLES, m_drawIndexCounts.data(), getOGLIndexType(),
+    m_drawIndexOffsets.data(), static_cast<GLsizei>(m_drawIndexCounts.size()), m_drawBaseVertices.data());
+
+  return Status::kSuccess;
+}
+
+void GeometryArena::destroyArena()
+{
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+  if (m_oglVaoId)
+  {
+    glDeleteVertexArrays(1, &m_oglVaoId);
+    stateCache.onVertexArrayDeleted(m_oglVaoId);
+    m_oglVaoId = 0;
+  }
+  if (m_oglVboId)
+  {
+    glDeleteBuffers(1, &m_oglVboId);
+    stateCache.onBufferDeleted(m_oglVboId);
+    m_oglVboId = 0;
+  }
+  if (m_oglIboId)
+  {
+    glDeleteBuffers(1, &m_oglIboId);
+    stateCache.onBufferDeleted(m_oglIboId);
+    m_oglIboId = 0;
+  }
+
+  m_meshes.clear();
+  m_vertexAllocator.reset(0);
+  m_indexAllocator.reset(0);
+}
+
+void GeometryArena::setVertexArrayBuffers()
+{
+  // Set OGL vertex array attribute pointers and element buffer to our buffers
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+  stateCache.bindVertexArray(m_oglVaoId);
+  stateCache.bindBuffer(GL_ARRAY_BUFFER, m_oglVboId);
+  for (std::size_t attributeIndex = 0; attributeIndex < m_vertexLayout.getAttributeCount(); ++attributeIndex)
+  {
+    const auto& attribute = m_vertexLayout.getAttribute(attributeIndex);
+    glVertexAttribPointer(attribute.location,
+      static_cast<GLint>(attribute.componentCount), VertexLayout::GetOGLAttributeType(attribute.type),
+      attribute.normalized ? GL_TRUE : GL_FALSE, static_cast<GLsizei>(m_vertexStride),
+      reinterpret_cast<const void*>(attribute.offset));
+    glEnableVertexAttribArray(attribute.location);
+  }
+  stateCache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_oglIboId);
+}
+
+} // namespace flurr
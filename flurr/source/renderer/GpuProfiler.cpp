@@ -0,0 +1,168 @@
+#include "flurr/renderer/GpuProfiler.h"
+#include "flurr/FlurrLog.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace flurr
+{
+
+GpuProfiler::GpuProfiler()
+  : m_initialized(false),
+  m_enabled(true),
+  m_frameActive(false),
+  m_logInterval(0),
+  m_frameIndex(0),
+  m_timingsFrameIndex(0)
+{
+}
+
+void GpuProfiler::init()
+{
+  m_initialized = true;
+  m_frameActive = false;
+  m_frameIndex = 0;
+}
+
+void GpuProfiler::shutdown()
+{
+  for (auto& frame : m_frames)
+  {
+    if (!frame.oglQueryIds.empty())
+      glDeleteQueries(static_cast<GLsizei>(frame.oglQueryIds.size()), frame.oglQueryIds.data());
+    frame = FrameQueries();
+  }
+  m_openZoneIndices.clear();
+  m_zoneTimings.clear();
+  m_initialized = false;
+}
+
+void GpuProfiler::beginFrame()
+{
+  if (!m_initialized || !m_enabled)
+    return;
+
+  // Read back results of the oldest frame, which should have completed by now
+  auto& frame = m_frames[m_frameIndex % m_frames.size()];
+  if (frame.pending)
+    readFrameResults(frame);
+
+  // Reuse its queries for this frame
+  frame.frameIndex = m_frameIndex;
+  frame.usedQueryCount = 0;
+  frame.zones.clear();
+  m_openZoneIndices.clear();
+  m_frameActive = true;
+}
+
+void GpuProfiler::endFrame()
+{
+  if (!m_frameActive)
+    return;
+
+  // Close zones left open
+  while (!m_openZoneIndices.empty())
+  {
+    FLURR_LOG_WARN("GPU profiler zone %s not ended!", m_frames[m_frameIndex % m_frames.size()].zones[m_openZoneIndices.back()].name);
+    endZone();
+  }
+
+  auto& frame = m_frames[m_frameIndex % m_frames.size()];
+  frame.pending = !frame.zones.empty();
+  m_frameActive = false;
+  ++m_frameIndex;
+}
+
+void GpuProfiler::beginZone(const char* a_zoneName)
+{
+  if (!m_frameActive)
+    return;
+
+  auto& frame = m_frames[m_frameIndex % m_frames.size()];
+  const uint32_t beginQueryIndex = issueTimestampQuery();
+  m_openZoneIndices.push_back(static_cast<uint32_t>(frame.zones.size()));
+  frame.zones.push_back(Zone{a_zoneName, static_cast<uint32_t>(m_openZoneIndices.size() - 1), beginQueryIndex, beginQueryIndex});
+}
+
+void GpuProfiler::endZone()
+{
+  if (!m_frameActive || m_openZoneIndices.empty())
+    return;
+
+  auto& frame = m_frames[m_frameIndex % m_frames.size()];
+  frame.zones[m_openZoneIndices.back()].endQueryIndex = issueTimestampQuery();
+  m_openZoneIndices.pop_back();
+}
+
+double GpuProfiler::getZoneTimeMs(const char* a_zoneName) const
+{
+  double timeMs = 0.0;
+  for (const auto& zoneTiming : m_zoneTimings)
+  {
+    if (std::strcmp(zoneTiming.name, a_zoneName) == 0)
+      timeMs += zoneTiming.timeMs;
+  }
+
+  return timeMs;
+}
+
+void GpuProfiler::logZoneTimings() const
+{
+  std::string timingsStr;
+  for (const auto& zoneTiming : m_zoneTimings)
+  {
+    char zoneStr[128];
+    std::snprintf(zoneStr, sizeof(zoneStr), "\n%*s%s: %.3f ms", static_cast<int>(zoneTiming.depth * 2), "", zoneTiming.name, zoneTiming.timeMs);
+    timingsStr += zoneStr;
+  }
+  FLURR_LOG_INFO("GPU timings (frame %u):%s", static_cast<uint32_t>(m_timingsFrameIndex), timingsStr.c_str());
+}
+
+uint32_t GpuProfiler::issueTimestampQuery()
+{
+  // Create more queries as needed
+  auto& frame = m_frames[m_frameIndex % m_frames.size()];
+  if (frame.usedQueryCount == frame.oglQueryIds.size())
+  {
+    GLuint oglQueryId = 0;
+    glGenQueries(1, &oglQueryId);
+    frame.oglQueryIds.push_back(oglQueryId);
+  }
+
+  const uint32_t queryIndex = frame.usedQueryCount++;
+  glQueryCounter(frame.oglQueryIds[queryIndex], GL_TIMESTAMP);
+  return queryIndex;
+}
+
+void GpuProfiler::readFrameResults(FrameQueries& a_frame)
+{
+  a_frame.pending = false;
+
+  // Never stall; if the GPU is still behind, drop this frame's results
+  GLint available = 0;
+  glGetQueryObjectiv(a_frame.oglQueryIds[a_frame.usedQueryCount - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+  if (!available)
+  {
+    FLURR_LOG_DEBUG("GPU profiler results of frame %u not available yet, dropped.", static_cast<uint32_t>(a_frame.frameIndex));
+    return;
+  }
+
+  // Timestamps become available in order, so all results of the frame can be read now
+  m_queryResults.resize(a_frame.usedQueryCount);
+  for (uint32_t queryIndex = 0; queryIndex < a_frame.usedQueryCount; ++queryIndex)
+    glGetQueryObjectui64v(a_frame.oglQueryIds[queryIndex], GL_QUERY_RESULT, &m_queryResults[queryIndex]);
+
+  m_zoneTimings.clear();
+  for (const auto& zone : a_frame.zones)
+  {
+    const GLuint64 elapsedNs = m_queryResults[zone.endQueryIndex] - m_queryResults[zone.beginQueryIndex];
+    m_zoneTimings.push_back(GpuZoneTiming{zone.name, zone.depth, static_cast<double>(elapsedNs) / 1000000.0});
+  }
+  m_timingsFrameIndex = a_frame.frameIndex;
+
+  if (m_logInterval > 0 && m_timingsFrameIndex % m_logInterval == 0)
+    logZoneTimings();
+}
+
+} // namespace flurr
@@ -0,0 +1,191 @@
+#include "flurr/renderer/HeadlessContext.h"
+#include "flurr/FlurrLog.h"
+
+#ifdef FLURR_HEADLESS_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+#include <cstring>
+
+namespace flurr
+{
+
+#ifdef FLURR_HEADLESS_EGL
+static bool HasEGLExtension(const char* a_extensions, const char* a_extension)
+{
+  if (!a_extensions)
+    return false;
+
+  // Match whole space-separated names only
+  const std::size_t extLength = std::strlen(a_extension);
+  for (const char* ext = std::strstr(a_extensions, a_extension); ext; ext = std::strstr(ext + extLength, a_extension))
+  {
+    if ((ext == a_extensions || ' ' == ext[-1]) && (' ' == ext[extLength] || '\0' == ext[extLength]))
+      return true;
+  }
+
+  return false;
+}
+#endif
+
+HeadlessContext::HeadlessContext()
+  : m_eglDisplay(nullptr),
+  m_eglContext(nullptr),
+  m_eglSurface(nullptr)
+{
+}
+
+HeadlessContext::~HeadlessContext()
+{
+  if (isCreated())
+    shutdown();
+}
+
+Status HeadlessContext::init(int a_glMajorVersion, int a_glMinorVersion)
+{
+  FLURR_LOG_INFO("Creating headless OpenGL %d.%d context...", a_glMajorVersion, a_glMinorVersion);
+  if (isCreated())
+  {
+    FLURR_LOG_WARN("Headless context already created!");
+    return Status::kSuccess;
+  }
+
+#ifdef FLURR_HEADLESS_EGL
+  // Prefer the Mesa surfaceless platform, which needs no display server
+  EGLDisplay display = EGL_NO_DISPLAY;
+  const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+  auto eglGetPlatformDisplayEXTProc = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+  if (eglGetPlatformDisplayEXTProc && HasEGLExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+    display = eglGetPlatformDisplayEXTProc(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+  if (EGL_NO_DISPLAY == display)
+    display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+  if (EGL_NO_DISPLAY == display)
+  {
+    FLURR_LOG_ERROR("Failed to get EGL display!");
+    return Status::kFailed;
+  }
+
+  EGLint eglMajorVersion = 0, eglMinorVersion = 0;
+  if (!eglInitialize(display, &eglMajorVersion, &eglMinorVersion))
+  {
+    FLURR_LOG_ERROR("Failed to initialize EGL (error 0x%x)!", eglGetError());
+    return Status::kFailed;
+  }
+  FLURR_LOG_INFO("EGL %d.%d initialized (vendor: %s).", eglMajorVersion, eglMinorVersion, eglQueryString(display, EGL_VENDOR));
+
+  if (!eglBindAPI(EGL_OPENGL_API))
+  {
+    FLURR_LOG_ERROR("EGL display does not support desktop OpenGL!");
+    eglTerminate(display);
+    return Status::kUnsupportedMode;
+  }
+
+  // Without surfaceless support we need a config that can back a pbuffer
+  const bool surfaceless = HasEGLExtension(eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+  const EGLint configAttribs[] =
+  {
+    EGL_SURFACE_TYPE, surfaceless ? 0 : EGL_PBUFFER_BIT,
+    EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+    EGL_NONE
+  };
+  EGLConfig config = nullptr;
+  EGLint configCount = 0;
+  if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) || 0 == configCount)
+  {
+    FLURR_LOG_ERROR("No suitable EGL config found!");
+    eglTerminate(display);
+    return Status::kUnsupportedMode;
+  }
+
+  // Create core profile context
+  const EGLint contextAttribs[] =
+  {
+    EGL_CONTEXT_MAJOR_VERSION_KHR, a_glMajorVersion,
+    EGL_CONTEXT_MINOR_VERSION_KHR, a_glMinorVersion,
+    EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+    EGL_NONE
+  };
+  EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+  if (EGL_NO_CONTEXT == context)
+  {
+    FLURR_LOG_ERROR("Failed to create EGL context (error 0x%x)!", eglGetError());
+    eglTerminate(display);
+    return Status::kFailed;
+  }
+
+  // Fall back to a minimal pbuffer; it is never drawn to
+  EGLSurface surface = EGL_NO_SURFACE;
+  if (!surfaceless)
+  {
+    const EGLint pbufferAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+    surface = eglCreatePbufferSurface(display, config, pbufferAttribs);
+    if (EGL_NO_SURFACE == surface)
+    {
+      FLURR_LOG_ERROR("Failed to create EGL pbuffer surface (error 0x%x)!", eglGetError());
+      eglDestroyContext(display, context);
+      eglTerminate(display);
+      return Status::kFailed;
+    }
+  }
+
+  m_eglDisplay = display;
+  m_eglContext = context;
+  m_eglSurface = surface;
+  Status result = makeCurrent();
+  if (Status::kSuccess != result)
+  {
+    shutdown();
+    return result;
+  }
+
+  FLURR_LOG_INFO("Headless context created (%s).", surfaceless ? "surfaceless" : "pbuffer");
+  return Status::kSuccess;
+#else
+  (void)a_glMajorVersion;
+  (void)a_glMinorVersion;
+  FLURR_LOG_ERROR("Headless rendering not supported; flurr must be built with FLURR_HEADLESS_EGL!");
+  return Status::kUnsupportedMode;
+#endif
+}
+
+void HeadlessContext::shutdown()
+{
+#ifdef FLURR_HEADLESS_EGL
+  if (m_eglDisplay)
+  {
+    eglMakeCurrent(m_eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (m_eglSurface)
+      eglDestroySurface(m_eglDisplay, m_eglSurface);
+    if (m_eglContext)
+      eglDestroyContext(m_eglDisplay, m_eglContext);
+    eglTerminate(m_eglDisplay);
+  }
+#endif
+
+  m_eglDisplay = nullptr;
+  m_eglContext = nullptr;
+  m_eglSurface = nullptr;
+}
+
+Status HeadlessContext::makeCurrent()
+{
+  if (!isCreated())
+  {
+    FLURR_LOG_ERROR("Headless context not created!");
+    return Status::kInvalidState;
+  }
+
+#ifdef FLURR_HEADLESS_EGL
+  EGLSurface surface = m_eglSurface ? m_eglSurface : EGL_NO_SURFACE;
+  if (!eglMakeCurrent(m_eglDisplay, surface, surface, m_eglContext))
+  {
+    FLURR_LOG_ERROR("Failed to make headless context current (error 0x%x)!", eglGetError());
+    return Status::kFailed;
+  }
+#endif
+
+  return Status::kSuccess;
+}
+
+} // namespace flurr
@@ -2,13 +2,17 @@
 #include "flurr/FlurrLog.h"
 #include "flurr/FlurrCore.h"
 
+#include <cstddef>
+
 namespace flurr
 {
 
 IndexedGeometry::IndexedGeometry(FlurrHandle a_geometryHandle)
   : m_geometryHandle(a_geometryHandle),
   m_geometryInitialized(false),
+  m_vertexCount(0),
   m_indexBufferHandle(INVALID_HANDLE),
+  m_instanceBufferHandle(INVALID_HANDLE),
   m_oglVaoId(0)
 {
 }
@@ -30,39 +34,108 @@ VertexBuffer* IndexedGeometry::getIndexBuffer() const
   return renderer->getVertexBuffer(m_indexBufferHandle);
 }
 
-Status IndexedGeometry::initGeometry(const std::vector<FlurrHandle>& a_attributeBufferHandles, FlurrHandle a_indexBufferHandle)
+Status IndexedGeometry::setBuffers(const std::vector<FlurrHandle>& a_attributeBufferHandles, const std::vector<const VertexBuffer*>& a_attributeBuffers,
+  FlurrHandle a_indexBufferHandle, const VertexBuffer& a_indexBuffer, const VertexLayout* a_vertexLayout)
 {
-  if (m_geometryInitialized)
+  if (m_geometryInitialized || INVALID_HANDLE != m_indexBufferHandle)
   {
     FLURR_LOG_ERROR("Unable to create indexed geometry; already created!");
     return Status::kInvalidState;
   }
 
-  for (const auto& attributeBufferHandle : a_attributeBufferHandles)
+  // Without a layout, each attribute buffer holds a single float attribute
+  VertexLayout vertexLayout;
+  if (a_vertexLayout)
   {
-    auto result = addAttributeBuffer(attributeBufferHandle);
-    if (result != Status::kSuccess)
-      return result;
+    vertexLayout = *a_vertexLayout;
+  }
+  else
+  {
+    for (std::size_t attributeIndex = 0; attributeIndex < a_attributeBuffers.size(); ++attributeIndex)
+    {
+      const std::size_t attributeSize = a_attributeBuffers[attributeIndex]->getAttributeSize();
+      vertexLayout.addAttribute(static_cast<GLuint>(attributeIndex), VertexAttributeType::kFloat,
+        static_cast<uint32_t>(attributeSize / sizeof(float)), false, static_cast<uint32_t>(attributeIndex));
+    }
   }
 
-  auto result = setIndexBuffer(a_indexBufferHandle);
+  auto result = vertexLayout.validate();
   if (result != Status::kSuccess)
     return result;
 
+  if (vertexLayout.getStreamCount() > a_attributeBuffers.size())
+  {
+    FLURR_LOG_ERROR("Unable to create indexed geometry; vertex layout has more streams than attribute buffers!");
+    return Status::kInvalidArgument;
+  }
+
+  // All streams must hold the same number of vertices
+  std::size_t vertexCount = 0;
+  for (uint32_t streamIndex = 0; streamIndex < a_attributeBuffers.size(); ++streamIndex)
+  {
+    const auto* buffer = a_attributeBuffers[streamIndex];
+    const std::size_t layoutStride = vertexLayout.getStreamStride(streamIndex);
+    const std::size_t stride = layoutStride > 0 ? layoutStride : buffer->getAttributeSize();
+    if (stride < vertexLayout.getStreamPackedSize(streamIndex))
+    {
+      FLURR_LOG_ERROR("Unable to create indexed geometry; vertex attributes exceed stride of stream %u!", streamIndex);
+      return Status::kInvalidArgument;
+    }
+
+    const std::size_t streamVertexCount = buffer->getDataSize() / stride;
+    if (streamIndex > 0 && streamVertexCount != vertexCount)
+    {
+      FLURR_LOG_ERROR("Buffer data count must match the data count of existing vertex attribute buffers!");
+      return Status::kInvalidArgument;
+    }
+    vertexCount = streamVertexCount;
+  }
+
+  // Check that indices are not out of bounds
+  if (!a_attributeBuffers.empty() && a_indexBuffer.getMaxIndex() >= vertexCount)
+  {
+    FLURR_LOG_ERROR("Unable to create indexed geometry; index %u out of bounds (vertex count is %u)!",
+      a_indexBuffer.getMaxIndex(), static_cast<uint32_t>(vertexCount));
+    return Status::kIndexOutOfBounds;
+  }
+
+  m_attributeBufferHandles = a_attributeBufferHandles;
+  m_indexBufferHandle = a_indexBufferHandle;
+  m_vertexLayout = vertexLayout;
+  m_vertexCount = vertexCount;
+
+  return Status::kSuccess;
+}
+
+Status IndexedGeometry::initGeometry()
+{
+  if (m_geometryInitialized)
+  {
+    FLURR_LOG_ERROR("Unable to create indexed geometry; already created!");
+    return Status::kInvalidState;
+  }
+
+  if (INVALID_HANDLE == m_indexBufferHandle)
+  {
+    FLURR_LOG_ERROR("Unable to create indexed geometry; buffers not set!");
+    return Status::kInvalidState;
+  }
+
   // Create OGL vertex array
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
   glGenVertexArrays(1, &m_oglVaoId);
-  glBindVertexArray(m_oglVaoId);
+  stateCache.bindVertexArray(m_oglVaoId);
 
   // Set OGL vertex array attribute pointers to our VBOs
-  for (std::size_t attributeIndex = 0; attributeIndex < getAttributeBuffersCount(); ++attributeIndex)
-  {
-    const GLuint oglAttributeIndex = static_cast<GLuint>(attributeIndex);
-    glBindBuffer(GL_ARRAY_BUFFER, getAttributeBuffer(attributeIndex)->getOGLVertexBufferObjectId());
-    std::size_t attributeSize = getAttributeBuffer(attributeIndex)->getAttributeSize();
-    glVertexAttribPointer(oglAttributeIndex,
-      static_cast<GLint>(attributeSize) / sizeof(float), GL_FLOAT,
-      GL_FALSE, 0, 0);
-    glEnableVertexAttribArray(oglAttributeIndex);
+  for (std::size_t attributeIndex = 0; attributeIndex < m_vertexLayout.getAttributeCount(); ++attributeIndex)
+  {
+    const auto& attribute = m_vertexLayout.getAttribute(attributeIndex);
+    stateCache.bindBuffer(GL_ARRAY_BUFFER, getAttributeBuffer(attribute.streamIndex)->getOGLVertexBufferObjectId());
+    glVertexAttribPointer(attribute.location,
+      static_cast<GLint>(attribute.componentCount), VertexLayout::GetOGLAttributeType(attribute.type),
+      attribute.normalized ? GL_TRUE : GL_FALSE, static_cast<GLsizei>(getStreamStride(attribute.streamIndex)),
+      reinterpret_cast<const void*>(attribute.offset));
+    glEnableVertexAttribArray(attribute.location);
   }
 
   m_geometryInitialized = true;
@@ -73,10 +146,17 @@ void IndexedGeometry::destroyGeometry()
 {
   // Delete OGL vertex array
   if (m_oglVaoId)
+  {
     glDeleteVertexArrays(1, &m_oglVaoId);
+    FlurrCore::Get().getRenderer()->getStateCache().onVertexArrayDeleted(m_oglVaoId);
+    m_oglVaoId = 0;
+  }
 
   m_attributeBufferHandles.clear();
+  m_vertexLayout = VertexLayout();
+  m_vertexCount = 0;
   m_indexBufferHandle = INVALID_HANDLE;
+  m_instanceBufferHandle = INVALID_HANDLE;
   m_geometryInitialized = false;
 }
 
@@ -90,62 +170,109 @@ Status IndexedGeometry::drawGeometry()
 
   // Get number of indices to draw
   auto* indexBuffer = getIndexBuffer();
-  std::size_t numIndices = indexBuffer->getDataSize() / sizeof(uint32_t);
+  std::size_t numIndices = indexBuffer->getIndexCount();
 
   // Draw the elements
-  glBindVertexArray(m_oglVaoId);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer->getOGLVertexBufferObjectId());
-  glDrawElements(GL_TRIANGLES, numIndices, GL_UNSIGNED_INT, 0);
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+  stateCache.bindVertexArray(m_oglVaoId);
+  stateCache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer->getOGLVertexBufferObjectId());
+  glDrawElements(GL_TRIANGLES, numIndices, indexBuffer->getOGLIndexType(), 0);
 
   return Status::kSuccess;
 }
 
-Status IndexedGeometry::addAttributeBuffer(FlurrHandle a_bufferHandle)
+Status IndexedGeometry::drawGeometryInstanced(FlurrHandle a_instanceBufferHandle, uint32_t a_instanceCount)
 {
-  // Get pointer to the vertex buffer
-  auto* renderer = FlurrCore::Get().getRenderer();
-  auto* buffer = renderer->getVertexBuffer(a_bufferHandle);
-  if (!buffer) {
-    FLURR_LOG_ERROR("Unable to add vertex attribute buffer; no buffer with that handle!");
-    return Status::kInvalidHandle;
+  if (!m_geometryInitialized)
+  {
+    FLURR_LOG_ERROR("Unable to draw indexed geometry; not created yet!");
+    return Status::kInvalidState;
   }
 
-  if (buffer->getBufferType() != VertexBufferType::kVertexAttribute) {
-    FLURR_LOG_ERROR("Unable to add vertex attribute buffer; wrong buffer type!");
-    return Status::kUnsupportedType;
+  auto* renderer = FlurrCore::Get().getRenderer();
+  auto* instanceBuffer = renderer->getVertexBuffer(a_instanceBufferHandle);
+  if (!instanceBuffer)
+  {
+    FLURR_LOG_ERROR("Unable to draw indexed geometry instances; no instance buffer with that handle!");
+    return Status::kInvalidHandle;
   }
 
-  if (getAttributeBuffersCount() > 0 &&
-    getAttributeBuffer(0)->getDataSize() / getAttributeBuffer(0)->getAttributeSize() != buffer->getDataSize() / buffer->getAttributeSize())
+  // Attach instance buffer to our VAO, unless already attached
+  auto& stateCache = renderer->getStateCache();
+  stateCache.bindVertexArray(m_oglVaoId);
+  if (a_instanceBufferHandle != m_instanceBufferHandle)
   {
-    FLURR_LOG_ERROR("Buffer data count must match the data count of existing vertex attribute buffers!");
-    return Status::kInvalidArgument;
+    auto result = setInstanceBuffer(a_instanceBufferHandle);
+    if (result != Status::kSuccess)
+      return result;
   }
 
-  // Add vertex attribute buffer to our vector
-  m_attributeBufferHandles.push_back(a_bufferHandle);
+  // Get number of indices to draw; instance count was checked by the renderer
+  auto* indexBuffer = getIndexBuffer();
+  std::size_t numIndices = indexBuffer->getIndexCount();
+
+  // Draw the elements
+  stateCache.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer->getOGLVertexBufferObjectId());
+  glDrawElementsInstanced(GL_TRIANGLES, numIndices, indexBuffer->getOGLIndexType(), 0, a_instanceCount);
 
   return Status::kSuccess;
 }
 
-Status IndexedGeometry::setIndexBuffer(FlurrHandle a_bufferHandle) {
-  // Get pointer to the index buffer
+std::size_t IndexedGeometry::getStreamStride(uint32_t a_streamIndex) const
+{
+  const std::size_t stride = m_vertexLayout.getStreamStride(a_streamIndex);
+  return stride > 0 ? stride : getAttributeBuffer(a_streamIndex)->getAttributeSize();
+}
+
+Status IndexedGeometry::setInstanceBuffer(FlurrHandle a_bufferHandle)
+{
+  // Get pointer to the instance buffer
   auto* renderer = FlurrCore::Get().getRenderer();
   auto* buffer = renderer->getVertexBuffer(a_bufferHandle);
   if (!buffer) {
-    FLURR_LOG_ERROR("Unable to set index buffer; no buffer with that handle!");
+    FLURR_LOG_ERROR("Unable to set instance buffer; no buffer with that handle!");
     return Status::kInvalidHandle;
   }
 
-  if (buffer->getBufferType() != VertexBufferType::kIndex) {
-    FLURR_LOG_ERROR("Unable to set index buffer; wrong buffer type!");
-    return Status::kUnsupportedType;
-  }
+  // Buffer type and instance data size were checked by the renderer
+  const std::size_t stride = buffer->getAttributeSize();
+  const bool hasColor = stride >= offsetof(InstanceData, params);
+  const bool hasParams = stride == sizeof(InstanceData);
 
-  // TODO: should verify that indices are not out of bounds
+  // Set OGL vertex array attribute pointers to the instance buffer, advancing once per instance (VAO must be bound)
+  renderer->getStateCache().bindBuffer(GL_ARRAY_BUFFER, buffer->getOGLVertexBufferObjectId());
+  for (GLuint columnIndex = 0; columnIndex < 4; ++columnIndex)
+  {
+    const GLuint oglAttributeIndex = INSTANCE_TRANSFORM_ATTRIBUTE_LOCATION + columnIndex;
+    glVertexAttribPointer(oglAttributeIndex, 4, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(stride),
+      reinterpret_cast<const void*>(offsetof(InstanceData, modelTransf) + columnIndex * sizeof(glm::vec4)));
+    glEnableVertexAttribArray(oglAttributeIndex);
+    glVertexAttribDivisor(oglAttributeIndex, 1);
+  }
+  if (hasColor)
+  {
+    glVertexAttribPointer(INSTANCE_COLOR_ATTRIBUTE_LOCATION, 4, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(stride),
+      reinterpret_cast<const void*>(offsetof(InstanceData, color)));
+    glEnableVertexAttribArray(INSTANCE_COLOR_ATTRIBUTE_LOCATION);
+    glVertexAttribDivisor(INSTANCE_COLOR_ATTRIBUTE_LOCATION, 1);
+  }
+  else
+  {
+    glDisableVertexAttribArray(INSTANCE_COLOR_ATTRIBUTE_LOCATION);
+  }
+  if (hasParams)
+  {
+    glVertexAttribPointer(INSTANCE_PARAMS_ATTRIBUTE_LOCATION, 4, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(stride),
+      reinterpret_cast<const void*>(offsetof(InstanceData, params)));
+    glEnableVertexAttribArray(INSTANCE_PARAMS_ATTRIBUTE_LOCATION);
+    glVertexAttribDivisor(INSTANCE_PARAMS_ATTRIBUTE_LOCATION, 1);
+  }
+  else
+  {
+    glDisableVertexAttribArray(INSTANCE_PARAMS_ATTRIBUTE_LOCATION);
+  }
 
-  // Set it as our current index buffer
-  m_indexBufferHandle = a_bufferHandle;
+  m_instanceBufferHandle = a_bufferHandle;
 
   return Status::kSuccess;
 }
@@ -0,0 +1,390 @@
+#include "flurr/renderer/MeshOptimizer.h"
+#include "flurr/FlurrLog.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace flurr
+{
+
+namespace
+{
+
+constexpr uint32_t kNoVertex = ~0u;
+
+/** FIFO vertex cache simulation; a vertex is cached if fewer than cacheSize misses occurred since it was loaded. */
+class VertexCacheSimulator
+{
+
+public:
+
+  VertexCacheSimulator(std::size_t a_vertexCount, uint32_t a_cacheSize)
+    : m_cacheSize(a_cacheSize),
+    m_timestamp(a_cacheSize + 1),
+    m_cacheTimestamps(a_vertexCount, 0)
+  {
+  }
+
+  uint32_t access(uint32_t a_vertex)
+  {
+    if (m_timestamp - m_cacheTimestamps[a_vertex] <= m_cacheSize)
+      return 0;
+
+    m_cacheTimestamps[a_vertex] = m_timestamp++;
+    return 1;
+  }
+
+  uint32_t accessTriangle(const uint32_t* a_triIndices) { return access(a_triIndices[0]) + access(a_triIndices[1]) + access(a_triIndices[2]); }
+  void flush() { m_timestamp += m_cacheSize + 1; }
+
+private:
+
+  uint32_t m_cacheSize;
+  uint32_t m_timestamp;
+  std::vector<uint32_t> m_cacheTimestamps;
+};
+
+const float* GetPosition(const float* a_positions, std::size_t a_positionStride, uint32_t a_vertex)
+{
+  return reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(a_positions) + a_vertex * a_positionStride);
+}
+
+} // namespace
+
+VertexCacheStats AnalyzeVertexCache(const uint32_t* a_indices, std::size_t a_indexCount, std::size_t a_vertexCount, uint32_t a_cacheSize)
+{
+  VertexCacheStats stats;
+  if (a_indexCount < 3)
+    return stats;
+
+  // Simulate cache and count referenced vertices
+  VertexCacheSimulator cache(a_vertexCount, a_cacheSize);
+  std::vector<bool> vertexReferenced(a_vertexCount, false);
+  std::size_t referencedVertexCount = 0;
+  for (std::size_t index = 0; index < a_indexCount; ++index)
+  {
+    const uint32_t vertex = a_indices[index];
+    if (!vertexReferenced[vertex])
+    {
+      vertexReferenced[vertex] = true;
+      ++referencedVertexCount;
+    }
+    stats.vertexTransformCount += cache.access(vertex);
+  }
+
+  stats.acmr = static_cast<float>(stats.vertexTransformCount) / (a_indexCount / 3);
+  stats.atvr = static_cast<float>(stats.vertexTransformCount) / referencedVertexCount;
+
+  return stats;
+}
+
+void OptimizeVertexCache(uint32_t* a_indices, std::size_t a_indexCount, std::size_t a_vertexCount, uint32_t a_cacheSize)
+{
+  const std::size_t triCount = a_indexCount / 3;
+  if (triCount < 2 || 0 == a_vertexCount)
+    return;
+
+  // Build vertex-triangle adjacency
+  std::vector<uint32_t> liveTriCounts(a_vertexCount, 0);
+  for (std::size_t index = 0; index < triCount * 3; ++index)
+    ++liveTriCounts[a_indices[index]];
+  std::vector<uint32_t> adjacencyOffsets(a_vertexCount + 1, 0);
+  for (std::size_t vertex = 0; vertex < a_vertexCount; ++vertex)
+    adjacencyOffsets[vertex + 1] = adjacencyOffsets[vertex] + liveTriCounts[vertex];
+  std::vector<uint32_t> adjacency(triCount * 3);
+  std::vector<uint32_t> adjacencyCursors(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+  for (std::size_t index = 0; index < triCount * 3; ++index)
+    adjacency[adjacencyCursors[a_indices[index]]++] = static_cast<uint32_t>(index / 3);
+
+  // Tipsify: fan around vertices, preferring candidates that are still in the cache
+  std::vector<uint32_t> cacheTimestamps(a_vertexCount, 0);
+  std::vector<bool> triEmitted(triCount, false);
+  std::vector<uint32_t> deadEndStack;
+  std::vector<uint32_t> candidates;
+  std::vector<uint32_t> outIndices;
+  outIndices.reserve(triCount * 3);
+  uint32_t timestamp = a_cacheSize + 1;
+  std::size_t scanCursor = 0;
+  uint32_t fanVertex = 0;
+  while (kNoVertex != fanVertex)
+  {
+    // Emit all live triangles around the fanning vertex
+    candidates.clear();
+    for (uint32_t adjacencyIndex = adjacencyOffsets[fanVertex]; adjacencyIndex < adjacencyOffsets[fanVertex + 1]; ++adjacencyIndex)
+    {
+      const uint32_t tri = adjacency[adjacencyIndex];
+      if (triEmitted[tri])
+        continue;
+
+      for (uint32_t triVertexIndex = 0; triVertexIndex < 3; ++triVertexIndex)
+      {
+        const uint32_t vertex = a_indices[tri * 3 + triVertexIndex];
+        outIndices.push_back(vertex);
+        deadEndStack.push_back(vertex);
+        candidates.push_back(vertex);
+        --liveTriCounts[vertex];
+        if (timestamp - cacheTimestamps[vertex] > a_cacheSize)
+          cacheTimestamps[vertex] = timestamp++;
+      }
+      triEmitted[tri] = true;
+    }
+
+    // Pick the candidate that will still be in the cache after fanning around it, and entered it earliest
+    fanVertex = kNoVertex;
+    int64_t bestPriority = -1;
+    for (const uint32_t vertex : candidates)
+    {
+      if (0 == liveTriCounts[vertex])
+        continue;
+
+      int64_t priority = 0;
+      if (timestamp - cacheTimestamps[vertex] + 2 * liveTriCounts[vertex] <= a_cacheSize)
+        priority = timestamp - cacheTimestamps[vertex];
+      if (priority > bestPriority)
+      {
+        bestPriority = priority;
+        fanVertex = vertex;
+      }
+    }
+
+    // Dead end, continue from a recently used vertex or the next vertex with live triangles
+    while (kNoVertex == fanVertex && !deadEndStack.empty())
+    {
+      const uint32_t vertex = deadEndStack.back();
+      deadEndStack.pop_back();
+      if (liveTriCounts[vertex] > 0)
+        fanVertex = vertex;
+    }
+    for (; kNoVertex == fanVertex && scanCursor < a_vertexCount; ++scanCursor)
+    {
+      if (liveTriCounts[scanCursor] > 0)
+        fanVertex = static_cast<uint32_t>(scanCursor);
+    }
+  }
+
+  std::copy(outIndices.begin(), outIndices.end(), a_indices);
+}
+
+void OptimizeOverdraw(uint32_t* a_indices, std::size_t a_indexCount, const float* a_positions, std::size_t a_positionStride, std::size_t a_vertexCount,
+  uint32_t a_cacheSize, float a_threshold)
+{
+  const std::size_t triCount = a_indexCount / 3;
+  if (triCount < 2 || nullptr == a_positions)
+    return;
+
+  // Hard cluster boundaries are where the cache is effectively flushed (all vertices miss)
+  std::vector<std::size_t> hardClusterStarts;
+  {
+    VertexCacheSimulator cache(a_vertexCount, a_cacheSize);
+    for (std::size_t tri = 0; tri < triCount; ++tri)
+    {
+      if (3 == cache.accessTriangle(&a_indices[tri * 3]) || 0 == tri)
+        hardClusterStarts.push_back(tri);
+    }
+  }
+  hardClusterStarts.push_back(triCount);
+
+  // Split hard clusters into soft clusters that start with a cold cache, without exceeding the ACMR threshold
+  std::vector<std::size_t> clusterStarts;
+  VertexCacheSimulator cache(a_vertexCount, a_cacheSize);
+  for (std::size_t hardClusterIndex = 0; hardClusterIndex + 1 < hardClusterStarts.size(); ++hardClusterIndex)
+  {
+    const std::size_t startTri = hardClusterStarts[hardClusterIndex];
+    const std::size_t endTri = hardClusterStarts[hardClusterIndex + 1];
+
+    cache.flush();
+    uint32_t clusterMissCount = 0;
+    for (std::size_t tri = startTri; tri < endTri; ++tri)
+      clusterMissCount += cache.accessTriangle(&a_indices[tri * 3]);
+    const float maxAcmr = a_threshold * clusterMissCount / (endTri - startTri);
+
+    cache.flush();
+    clusterStarts.push_back(startTri);
+    uint32_t softMissCount = 0;
+    std::size_t softTriCount = 0;
+    for (std::size_t tri = startTri; tri < endTri; ++tri)
+    {
+      softMissCount += cache.accessTriangle(&a_indices[tri * 3]);
+      ++softTriCount;
+      if (tri + 1 < endTri && softMissCount <= maxAcmr * softTriCount)
+      {
+        clusterStarts.push_back(tri + 1);
+        cache.flush();
+        softMissCount = 0;
+        softTriCount = 0;
+      }
+    }
+  }
+  const std::size_t clusterCount = clusterStarts.size();
+  clusterStarts.push_back(triCount);
+
+  // Compute area-weighted centroids and normals of clusters and mesh
+  std::vector<float> clusterSortKeys(clusterCount, 0.0f);
+  std::vector<float> clusterData(clusterCount * 7, 0.0f); // centroid * area, area, normal * 2 * area
+  float meshCentroid[3] = {0.0f, 0.0f, 0.0f};
+  float meshArea = 0.0f;
+  for (std::size_t clusterIndex = 0; clusterIndex < clusterCount; ++clusterIndex)
+  {
+    float* data = &clusterData[clusterIndex * 7];
+    for (std::size_t tri = clusterStarts[clusterIndex]; tri < clusterStarts[clusterIndex + 1]; ++tri)
+    {
+      const float* p0 = GetPosition(a_positions, a_positionStride, a_indices[tri * 3]);
+      const float* p1 = GetPosition(a_positions, a_positionStride, a_indices[tri * 3 + 1]);
+      const float* p2 = GetPosition(a_positions, a_positionStride, a_indices[tri * 3 + 2]);
+      const float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+      const float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+      const float normal[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+      const float area = 0.5f * std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        data[axis] += (p0[axis] + p1[axis] + p2[axis]) / 3.0f * area;
+        data[4 + axis] += normal[axis];
+      }
+      data[3] += area;
+    }
+
+    for (int axis = 0; axis < 3; ++axis)
+      meshCentroid[axis] += data[axis];
+    meshArea += data[3];
+  }
+  if (meshArea <= 0.0f)
+    return;
+  for (int axis = 0; axis < 3; ++axis)
+    meshCentroid[axis] /= meshArea;
+
+  // Outward-facing clusters (normal pointing away from the mesh centroid) are likely to occlude others
+  for (std::size_t clusterIndex = 0; clusterIndex < clusterCount; ++clusterIndex)
+  {
+    const float* data = &clusterData[clusterIndex * 7];
+    const float normalLength = std::sqrt(data[4] * data[4] + data[5] * data[5] + data[6] * data[6]);
+    if (data[3] <= 0.0f || normalLength <= 0.0f)
+      continue;
+
+    float sortKey = 0.0f;
+    for (int axis = 0; axis < 3; ++axis)
+      sortKey += (data[axis] / data[3] - meshCentroid[axis]) * data[4 + axis] / normalLength;
+    clusterSortKeys[clusterIndex] = sortKey;
+  }
+
+  // Reorder clusters
+  std::vector<std::size_t> clusterOrder(clusterCount);
+  for (std::size_t clusterIndex = 0; clusterIndex < clusterCount; ++clusterIndex)
+    clusterOrder[clusterIndex] = clusterIndex;
+  std::stable_sort(clusterOrder.begin(), clusterOrder.end(),
+    [&clusterSortKeys](std::size_t a_cluster1, std::size_t a_cluster2) { return clusterSortKeys[a_cluster1] > clusterSortKeys[a_cluster2]; });
+
+  std::vector<uint32_t> outIndices;
+  outIndices.reserve(triCount * 3);
+  for (const std::size_t clusterIndex : clusterOrder)
+    outIndices.insert(outIndices.end(), a_indices + clusterStarts[clusterIndex] * 3, a_indices + clusterStarts[clusterIndex + 1] * 3);
+  std::copy(outIndices.begin(), outIndices.end(), a_indices);
+}
+
+std::size_t OptimizeVertexFetchRemap(uint32_t* a_indices, std::size_t a_indexCount, std::size_t a_vertexCount, std::vector<uint32_t>& a_remap)
+{
+  // Number vertices in order of first reference
+  a_remap.assign(a_vertexCount, kNoVertex);
+  uint32_t nextVertex = 0;
+  for (std::size_t index = 0; index < a_indexCount; ++index)
+  {
+    uint32_t& newVertex = a_remap[a_indices[index]];
+    if (kNoVertex == newVertex)
+      newVertex = nextVertex++;
+    a_indices[index] = newVertex;
+  }
+
+  return nextVertex;
+}
+
+void RemapVertexStream(void* a_vertexData, std::size_t a_vertexSize, std::size_t a_vertexCount, const std::vector<uint32_t>& a_remap)
+{
+  auto* vertexData = static_cast<uint8_t*>(a_vertexData);
+  const std::vector<uint8_t> srcVertexData(vertexData, vertexData + a_vertexCount * a_vertexSize);
+  for (std::size_t vertex = 0; vertex < a_vertexCount; ++vertex)
+  {
+    if (kNoVertex != a_remap[vertex])
+      std::memcpy(vertexData + a_remap[vertex] * a_vertexSize, srcVertexData.data() + vertex * a_vertexSize, a_vertexSize);
+  }
+}
+
+Status OptimizeMesh(uint32_t* a_indices, std::size_t a_indexCount, const std::vector<MeshVertexStream>& a_vertexStreams, std::size_t& a_vertexCount,
+  const MeshOptimizationSettings& a_settings, MeshOptimizationStats* a_stats)
+{
+  if (nullptr == a_indices)
+  {
+    FLURR_LOG_ERROR("indices cannot be null!");
+    return Status::kNullArgument;
+  }
+
+  if (a_indexCount % 3 != 0)
+  {
+    FLURR_LOG_ERROR("Mesh index count must be a multiple of 3!");
+    return Status::kInvalidArgument;
+  }
+
+  for (std::size_t index = 0; index < a_indexCount; ++index)
+  {
+    if (a_indices[index] >= a_vertexCount)
+    {
+      FLURR_LOG_ERROR("Mesh index %u out of bounds (vertex count is %u)!", a_indices[index], static_cast<uint32_t>(a_vertexCount));
+      return Status::kIndexOutOfBounds;
+    }
+  }
+
+  for (const auto& vertexStream : a_vertexStreams)
+  {
+    if (nullptr == vertexStream.data || 0 == vertexStream.vertexSize)
+    {
+      FLURR_LOG_ERROR("Mesh vertex streams cannot be null or empty!");
+      return Status::kNullArgument;
+    }
+  }
+
+  const bool hasPositions = a_settings.positionStreamIndex < a_vertexStreams.size() &&
+    a_settings.positionOffset + 3 * sizeof(float) <= a_vertexStreams[a_settings.positionStreamIndex].vertexSize;
+  if (a_settings.optimizeOverdraw && !hasPositions)
+  {
+    FLURR_LOG_ERROR("Unable to optimize mesh overdraw; no vertex positions!");
+    return Status::kInvalidArgument;
+  }
+
+  const auto statsBefore = AnalyzeVertexCache(a_indices, a_indexCount, a_vertexCount, a_settings.vertexCacheSize);
+  const std::size_t vertexCountBefore = a_vertexCount;
+
+  // Triangle order
+  if (a_settings.optimizeVertexCache)
+    OptimizeVertexCache(a_indices, a_indexCount, a_vertexCount, a_settings.vertexCacheSize);
+  if (a_settings.optimizeOverdraw)
+  {
+    const auto& positionStream = a_vertexStreams[a_settings.positionStreamIndex];
+    const auto* positions = reinterpret_cast<const float*>(static_cast<const uint8_t*>(positionStream.data) + a_settings.positionOffset);
+    OptimizeOverdraw(a_indices, a_indexCount, positions, positionStream.vertexSize, a_vertexCount, a_settings.vertexCacheSize, a_settings.overdrawThreshold);
+  }
+
+  // Vertex order
+  if (a_settings.optimizeVertexFetch)
+  {
+    std::vector<uint32_t> remap;
+    const std::size_t vertexCount = OptimizeVertexFetchRemap(a_indices, a_indexCount, a_vertexCount, remap);
+    for (const auto& vertexStream : a_vertexStreams)
+      RemapVertexStream(vertexStream.data, vertexStream.vertexSize, a_vertexCount, remap);
+    a_vertexCount = vertexCount;
+  }
+
+  const auto statsAfter = AnalyzeVertexCache(a_indices, a_indexCount, a_vertexCount, a_settings.vertexCacheSize);
+  FLURR_LOG_DEBUG("Mesh optimized: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, %u -> %u vertices",
+    statsBefore.acmr, statsAfter.acmr, statsBefore.atvr, statsAfter.atvr,
+    static_cast<uint32_t>(vertexCountBefore), static_cast<uint32_t>(a_vertexCount));
+  if (a_stats)
+  {
+    a_stats->statsBefore = statsBefore;
+    a_stats->statsAfter = statsAfter;
+    a_stats->vertexCountBefore = vertexCountBefore;
+    a_stats->vertexCountAfter = a_vertexCount;
+  }
+
+  return Status::kSuccess;
+}
+
+} // namespace flurr
@@ -0,0 +1,255 @@
+#include "flurr/renderer/NullRenderBackend.h"
+
+namespace flurr
+{
+
+NullRenderBackend::NullRenderBackend()
+  : m_recording(true)
+{
+  m_callCounts.fill(0);
+}
+
+void NullRenderBackend::clearCalls()
+{
+  m_calls.clear();
+  m_callCounts.fill(0);
+}
+
+void NullRenderBackend::beginFrame(const RenderTarget* a_renderTarget, const glm::ivec4& a_viewport)
+{
+  recordCall(RenderBackendCallType::kBeginFrame, a_renderTarget ? a_renderTarget->getTargetHandle() : INVALID_HANDLE);
+}
+
+void NullRenderBackend::endFrame(RenderTarget* a_renderTarget)
+{
+  recordCall(RenderBackendCallType::kEndFrame, a_renderTarget ? a_renderTarget->getTargetHandle() : INVALID_HANDLE);
+}
+
+void NullRenderBackend::setViewport(int a_x, int a_y, uint32_t a_width, uint32_t a_height)
+{
+  recordCall(RenderBackendCallType::kSetViewport);
+}
+
+void NullRenderBackend::updateFrameUniforms(const FrameUniforms& a_frameUniforms)
+{
+  recordCall(RenderBackendCallType::kUpdateFrameUniforms);
+}
+
+void NullRenderBackend::insertFrameFence(uint32_t a_frameSlot)
+{
+  recordCall(RenderBackendCallType::kInsertFrameFence, INVALID_HANDLE, a_frameSlot);
+}
+
+Status NullRenderBackend::waitFrameFence(uint32_t a_frameSlot)
+{
+  recordCall(RenderBackendCallType::kWaitFrameFence, INVALID_HANDLE, a_frameSlot);
+  return Status::kSuccess;
+}
+
+Status NullRenderBackend::compileShader(ShaderProgram& a_program, ShaderType a_shaderType, FlurrHandle a_shaderResourceHandle)
+{
+  recordCall(RenderBackendCallType::kCompileShader, a_program.getProgramHandle(), static_cast<uint32_t>(a_shaderType));
+  return Status::kSuccess;
+}
+
+Status NullRenderBackend::linkProgram(ShaderProgram& a_program, bool a_async)
+{
+  recordCall(RenderBackendCallType::kLinkProgram, a_program.getProgramHandle(), a_async ? 1 : 0);
+
+  // Nothing to wait for, the program is usable right away
+  a_program.m_programState = ShaderProgramState::kLinked;
+  return Status::kSuccess;
+}
+
+void NullRenderBackend::destroyProgram(ShaderProgram& a_program)
+{
+  recordCall(RenderBackendCallType::kDestroyProgram, a_program.getProgramHandle());
+}
+
+Status NullRenderBackend::useProgram(ShaderProgram& a_program)
+{
+  recordCall(RenderBackendCallType::kUseProgram, a_program.getProgramHandle());
+  return Status::kSuccess;
+}
+
+void NullRenderBackend::setIntUniform(ShaderProgram& a_program, UniformHandle a_uniform, int a_value)
+{
+  recordCall(RenderBackendCallType::kSetUniform, a_program.getProgramHandle(), static_cast<uint32_t>(a_uniform));
+}
+
+void NullRenderBackend::setVec4Uniform(ShaderProgram& a_program, UniformHandle a_uniform, const glm::vec4& a_value)
+{
+  recordCall(RenderBackendCallType::kSetUniform, a_program.getProgramHandle(), static_cast<uint32_t>(a_uniform));
+}
+
+void NullRenderBackend::setMat4Uniform(ShaderProgram& a_program, UniformHandle a_uniform, const glm::mat4& a_value)
+{
+  recordCall(RenderBackendCallType::kSetUniform, a_program.getProgramHandle(), static_cast<uint32_t>(a_uniform));
+}
+
+Status NullRenderBackend::initTexture(Texture& a_texture, FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode, bool a_asyncUpload)
+{
+  recordCall(RenderBackendCallType::kInitTexture, a_texture.getTextureHandle());
+  return Status::kSuccess;
+}
+
+Status NullRenderBackend::initTextureInArray(Texture& a_texture, FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode)
+{
+  recordCall(RenderBackendCallType::kInitTexture, a_texture.getTextureHandle());
+  return Status::kSuccess;
+}
+
+void NullRenderBackend::destroyTexture(Texture& a_texture)
+{
+  recordCall(RenderBackendCallType::kDestroyTexture, a_texture.getTextureHandle());
+}
+
+Status NullRenderBackend::useTexture(Texture& a_texture, TextureUnitIndex a_texUnit)
+{
+  recordCall(RenderBackendCallType::kUseTexture, a_texture.getTextureHandle(), a_texUnit);
+  return Status::kSuccess;
+}
+
+Status NullRenderBackend::initTextureArray(TextureArray& a_textureArray, uint32_t a_width, uint32_t a_height, TextureFormat a_texFormat, uint32_t a_mipLevelCount, uint32_t a_layerCapacity,
+  TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode)
+{
+  recordCall(RenderBackendCallType::kInitTextureArray, a_textureArray.getArrayHandle(), a_layerCapacity);
+  return Status::kSuccess;
+}
+
+void NullRenderBackend::destroyTextureArray(TextureArray& a_textureArray)
+{
+  recordCall(RenderBackendCallType::kDestroyTextureArray, a_textureArray.getArrayHandle());
+}
+
+Status NullRenderBackend::initVertexBuffer(VertexBuffer& a_buffer, const void* a_data)
+{
+  recordCall(RenderBackendCallType::kInitVertexBuffer, a_buffer.getBufferHandle(), static_cast<uint32_t>(a_buffer.getDataSize()));
+  return Status::kSuccess;
+}
+
+void NullRenderBackend::destroyVertexBuffer(VertexBuffer& a_buffer)
+{
+  recordCall(RenderBackendCallType::kDestroyVertexBuffer, a_buffer.getBufferHandle());
+}
+
+Status NullRenderBackend::useVertexBuffer(VertexBuffer& a_buffer)
+{
+  recordCall(RenderBackendCallType::kUseVertexBuffer, a_buffer.getBufferHandle());
+  return Status::kSuccess;
+}
+
+Status NullRenderBackend::updateVertexBuffer(VertexBuffer& a_buffer, const void* a_data, std::size_t a_dataSize, std::size_t a_offset)
+{
+  recordCall(RenderBackendCallType::kUpdateVertexBuffer, a_buffer.getBufferHandle(), static_cast<uint32_t>(a_dataSize));
+  return Status::kSuccess;
+}
+
+Status NullRenderBackend::mapTransient(VertexBuffer& a_buffer, std::size_t a_dataSize, void** a_writePtr, std::size_t& a_offset)
+{
+  recordCall(RenderBackendCallType::kMapTransient, a_buffer.getBufferHandle(), static_cast<uint32_t>(a_dataSize));
+
+  // Hand out scratch memory, so callers can write their data as usual
+  if (m_transientData.size() < a_dataSize)
+    m_transientData.resize(a_dataSize);
+  *a_writePtr = m_transientData.data();
+  a_offset = 0;
+
+  return Status::kSuccess;
+}
+
+Status NullRenderBackend::unmapTransient(VertexBuffer& a_buffer)
+{
+  recordCall(RenderBackendCallType::kUnmapTransient, a_buffer.getBufferHandle());
+  return Status::kSuccess;
+}
+
+void NullRenderBackend::fenceTransients(VertexBuffer& a_buffer)
+{
+  recordCall(RenderBackendCallType::kFenceTransients, a_buffer.getBufferHandle());
+}
+
+Status NullRenderBackend::initGeometry(IndexedGeometry& a_geometry)
+{
+  recordCall(RenderBackendCallType::kInitGeometry, a_geometry.getGeometryHandle());
+  return Status::kSuccess;
+}
+
+void NullRenderBackend::destroyGeometry(IndexedGeometry& a_geometry)
+{
+  recordCall(RenderBackendCallType::kDestroyGeometry, a_geometry.getGeometryHandle());
+}
+
+Status NullRenderBackend::drawGeometry(IndexedGeometry& a_geometry)
+{
+  recordCall(RenderBackendCallType::kDrawGeometry, a_geometry.getGeometryHandle());
+  return Status::kSuccess;
+}
+
+Status NullRenderBackend::drawGeometryInstanced(IndexedGeometry& a_geometry, FlurrHandle a_instanceBufferHandle, uint32_t a_instanceCount)
+{
+  recordCall(RenderBackendCallType::kDrawGeometryInstanced, a_geometry.getGeometryHandle(), a_instanceCount);
+  return Status::kSuccess;
+}
+
+Status NullRenderBackend::initArena(GeometryArena& a_arena)
+{
+  recordCall(RenderBackendCallType::kInitArena, a_arena.getArenaHandle());
+  return Status::kSuccess;
+}
+
+void NullRenderBackend::destroyArena(GeometryArena& a_arena)
+{
+  recordCall(RenderBackendCallType::kDestroyArena, a_arena.getArenaHandle());
+}
+
+Status NullRenderBackend::updateArena(GeometryArena& a_arena, const ArenaMesh& a_mesh, const void* a_vertexData, const uint32_t* a_indexData)
+{
+  recordCall(RenderBackendCallType::kUpdateArena, a_arena.getArenaHandle(), static_cast<uint32_t>(a_mesh.vertexCount * a_arena.getVertexStride()));
+  return Status::kSuccess;
+}
+
+Status NullRenderBackend::copyArena(GeometryArena& a_arena, const std::vector<ArenaMesh>& a_packedMeshes)
+{
+  recordCall(RenderBackendCallType::kCopyArena, a_arena.getArenaHandle(), static_cast<uint32_t>(a_packedMeshes.size()));
+  return Status::kSuccess;
+}
+
+Status NullRenderBackend::drawArenaMesh(GeometryArena& a_arena, const ArenaMesh& a_mesh)
+{
+  recordCall(RenderBackendCallType::kDrawArena, a_arena.getArenaHandle(), 1);
+  return Status::kSuccess;
+}
+
+Status NullRenderBackend::drawArenaMeshes(GeometryArena& a_arena, const std::vector<FlurrHandle>& a_meshHandles)
+{
+  recordCall(RenderBackendCallType::kDrawArena, a_arena.getArenaHandle(), static_cast<uint32_t>(a_meshHandles.size()));
+  return Status::kSuccess;
+}
+
+Status NullRenderBackend::initRenderTarget(RenderTarget& a_renderTarget, uint32_t a_width, uint32_t a_height, RenderTargetFormat a_colorFormat, bool a_hasDepth, uint32_t a_sampleCount)
+{
+  recordCall(RenderBackendCallType::kInitRenderTarget, a_renderTarget.getTargetHandle());
+  return Status::kSuccess;
+}
+
+void NullRenderBackend::destroyRenderTarget(RenderTarget& a_renderTarget)
+{
+  recordCall(RenderBackendCallType::kDestroyRenderTarget, a_renderTarget.getTargetHandle());
+}
+
+Status NullRenderBackend::readPixels(const RenderTarget& a_renderTarget, std::vector<uint8_t>& a_pixels)
+{
+  recordCall(RenderBackendCallType::kReadPixels, a_renderTarget.getTargetHandle());
+  a_pixels.clear();
+  return Status::kSuccess;
+}
+
+void NullRenderBackend::recordCall(RenderBackendCallType a_callType, FlurrHandle a_handle, uint32_t a_arg)
+{
+  ++m_callCounts[static_cast<std::size_t>(a_callType)];
+  if (m_recording)
+    m_calls.push_back(RenderBackendCall{a_callType, a_handle, a_arg});
+}
+
+} // namespace flurr
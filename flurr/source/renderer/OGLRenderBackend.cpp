@@ -0,0 +1,365 @@
+#include "flurr/renderer/OGLRenderBackend.h"
+#include "flurr/FlurrCore.h"
+#include "flurr/FlurrLog.h"
+
+namespace flurr
+{
+
+void GLAPIENTRY OGLDebugMessageCallback(GLenum source,
+  GLenum type,
+  GLuint id,
+  GLenum severity,
+  GLsizei length,
+  const GLchar* message,
+  const void* userParam) {
+  FLURR_LOG_DEBUG("OGL 0x%x type = 0x%x, severity = 0x%x, message = %s",
+    source, type, severity, message);
+}
+
+OGLRenderBackend::OGLRenderBackend()
+  : m_parallelShaderCompile(false),
+  m_oglFrameUniformBufferId(0),
+  m_defaultViewport(0),
+  m_renderTargetBound(false)
+{
+  m_oglFrameFences.fill(nullptr);
+}
+
+Status OGLRenderBackend::init()
+{
+  // Initialize GLEW
+  GLenum glewResult = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+  // GLX-based GLEW reports this for EGL contexts, after GL entry points are already loaded
+  if (GLEW_ERROR_NO_GLX_DISPLAY == glewResult)
+    glewResult = GLEW_OK;
+#endif
+  if (GLEW_OK != glewResult)
+  {
+    FLURR_LOG_ERROR("Failed to initialize GLEW (error %u)!", glewResult);
+    return Status::kFailed;
+  }
+
+  // Register debug callback
+  glEnable(GL_DEBUG_OUTPUT);
+  glDebugMessageCallback(OGLDebugMessageCallback, 0);
+
+  // Let the driver compile shaders on as many threads as it wants
+  m_parallelShaderCompile = false;
+  if (GLEW_KHR_parallel_shader_compile)
+  {
+    glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+    m_parallelShaderCompile = true;
+  }
+  else if (GLEW_ARB_parallel_shader_compile)
+  {
+    glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+    m_parallelShaderCompile = true;
+  }
+  FLURR_LOG_INFO("Parallel shader compilation %s.", m_parallelShaderCompile ? "enabled" : "not supported");
+
+  // Create per-frame uniform buffer and bind it to its binding point
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+  const FrameUniforms frameUniforms = FlurrCore::Get().getRenderer()->getFrameUniforms();
+  glGenBuffers(1, &m_oglFrameUniformBufferId);
+  stateCache.bindBuffer(GL_UNIFORM_BUFFER, m_oglFrameUniformBufferId);
+  glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), &frameUniforms, GL_DYNAMIC_DRAW);
+  glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_UNIFORM_BLOCK_BINDING, m_oglFrameUniformBufferId);
+
+  // Initial viewport of the default framebuffer covers the whole window
+  GLint viewport[4] = {};
+  glGetIntegerv(GL_VIEWPORT, viewport);
+  m_defaultViewport = glm::ivec4(viewport[0], viewport[1], viewport[2], viewport[3]);
+  m_renderTargetBound = false;
+
+  // Print OpenGL capabilities
+  int numAttributes = 0;
+  glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &numAttributes);
+  FLURR_LOG_INFO("OpenGL info:\nNumber of attributes: %d", numAttributes);
+
+  return Status::kSuccess;
+}
+
+void OGLRenderBackend::shutdown()
+{
+  for (auto& oglFrameFence : m_oglFrameFences)
+  {
+    if (oglFrameFence)
+      glDeleteSync(oglFrameFence);
+    oglFrameFence = nullptr;
+  }
+
+  if (m_oglFrameUniformBufferId)
+  {
+    glDeleteBuffers(1, &m_oglFrameUniformBufferId);
+    FlurrCore::Get().getRenderer()->getStateCache().onBufferDeleted(m_oglFrameUniformBufferId);
+    m_oglFrameUniformBufferId = 0;
+  }
+}
+
+void OGLRenderBackend::beginFrame(const RenderTarget* a_renderTarget, const glm::ivec4& a_viewport)
+{
+  if (a_renderTarget)
+  {
+    glBindFramebuffer(GL_FRAMEBUFFER, a_renderTarget->getOGLFramebufferId());
+    glViewport(0, 0, a_renderTarget->getWidth(), a_renderTarget->getHeight());
+    m_renderTargetBound = true;
+  }
+  else
+  {
+    // Without an explicit viewport, restore the one a render target may have replaced
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (a_viewport.z > 0 && a_viewport.w > 0)
+      m_defaultViewport = a_viewport;
+    if (m_defaultViewport.z > 0 && m_defaultViewport.w > 0)
+      glViewport(m_defaultViewport.x, m_defaultViewport.y, m_defaultViewport.z, m_defaultViewport.w);
+    m_renderTargetBound = false;
+  }
+
+  glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void OGLRenderBackend::endFrame(RenderTarget* a_renderTarget)
+{
+  if (a_renderTarget)
+    a_renderTarget->resolve();
+}
+
+void OGLRenderBackend::setViewport(int a_x, int a_y, uint32_t a_width, uint32_t a_height)
+{
+  glViewport(a_x, a_y, a_width, a_height);
+  if (!m_renderTargetBound)
+    m_defaultViewport = glm::ivec4(a_x, a_y, static_cast<int>(a_width), static_cast<int>(a_height));
+}
+
+void OGLRenderBackend::updateFrameUniforms(const FrameUniforms& a_frameUniforms)
+{
+  FlurrCore::Get().getRenderer()->getStateCache().bindBuffer(GL_UNIFORM_BUFFER, m_oglFrameUniformBufferId);
+  glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniforms), &a_frameUniforms);
+}
+
+void OGLRenderBackend::insertFrameFence(uint32_t a_frameSlot)
+{
+  // Slot should have been waited on before reuse, replace its fence regardless
+  auto& oglFrameFence = m_oglFrameFences[a_frameSlot];
+  if (oglFrameFence)
+    glDeleteSync(oglFrameFence);
+  oglFrameFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+Status OGLRenderBackend::waitFrameFence(uint32_t a_frameSlot)
+{
+  auto& oglFrameFence = m_oglFrameFences[a_frameSlot];
+  if (!oglFrameFence)
+    return Status::kSuccess;
+
+  GLenum waitResult = glClientWaitSync(oglFrameFence, GL_SYNC_FLUSH_COMMANDS_BIT, kFrameFenceTimeout);
+  glDeleteSync(oglFrameFence);
+  oglFrameFence = nullptr;
+  if (GL_TIMEOUT_EXPIRED == waitResult || GL_WAIT_FAILED == waitResult)
+  {
+    FLURR_LOG_ERROR("Failed waiting for the GPU to finish frame slot %u!", a_frameSlot);
+    return Status::kFailed;
+  }
+
+  return Status::kSuccess;
+}
+
+Status OGLRenderBackend::compileShader(ShaderProgram& a_program, ShaderType a_shaderType, FlurrHandle a_shaderResourceHandle)
+{
+  // Sources are compiled when the program is linked, so the program binary cache can skip compilation
+  return Status::kSuccess;
+}
+
+Status OGLRenderBackend::linkProgram(ShaderProgram& a_program, bool a_async)
+{
+  return a_async ? a_program.beginLink() : a_program.linkProgram();
+}
+
+bool OGLRenderBackend::isLinkComplete(const ShaderProgram& a_program) const
+{
+  return a_program.isLinkComplete();
+}
+
+Status OGLRenderBackend::finishLink(ShaderProgram& a_program)
+{
+  return a_program.finishLink();
+}
+
+void OGLRenderBackend::destroyProgram(ShaderProgram& a_program)
+{
+  if (a_program.getProgramState() != ShaderProgramState::kDestroyed)
+    a_program.destroyProgram();
+}
+
+Status OGLRenderBackend::useProgram(ShaderProgram& a_program)
+{
+  return a_program.useProgram();
+}
+
+void OGLRenderBackend::setIntUniform(ShaderProgram& a_program, UniformHandle a_uniform, int a_value)
+{
+  a_program.setIntValue(a_uniform, a_value);
+}
+
+void OGLRenderBackend::setVec4Uniform(ShaderProgram& a_program, UniformHandle a_uniform, const glm::vec4& a_value)
+{
+  a_program.setVec4Value(a_uniform, a_value);
+}
+
+void OGLRenderBackend::setMat4Uniform(ShaderProgram& a_program, UniformHandle a_uniform, const glm::mat4& a_value)
+{
+  a_program.setMat4Value(a_uniform, a_value);
+}
+
+Status OGLRenderBackend::initTexture(Texture& a_texture, FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode, bool a_asyncUpload)
+{
+  return a_texture.initTexture(a_texResourceHandle, a_texWrapMode, a_texMinFilterMode, a_texMagFilterMode, a_asyncUpload);
+}
+
+Status OGLRenderBackend::initTextureInArray(Texture& a_texture, FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode)
+{
+  return a_texture.initArrayLayer(a_texResourceHandle, a_texWrapMode, a_texMinFilterMode, a_texMagFilterMode);
+}
+
+void OGLRenderBackend::destroyTexture(Texture& a_texture)
+{
+  if (INVALID_HANDLE != a_texture.getResourceHandle())
+    a_texture.destroyTexture();
+}
+
+Status OGLRenderBackend::useTexture(Texture& a_texture, TextureUnitIndex a_texUnit)
+{
+  return a_texture.useTexture(a_texUnit);
+}
+
+Status OGLRenderBackend::initTextureArray(TextureArray& a_textureArray, uint32_t a_width, uint32_t a_height, TextureFormat a_texFormat, uint32_t a_mipLevelCount, uint32_t a_layerCapacity,
+  TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode)
+{
+  return a_textureArray.initArray(a_width, a_height, a_texFormat, a_mipLevelCount, a_layerCapacity, a_texWrapMode, a_texMinFilterMode, a_texMagFilterMode);
+}
+
+void OGLRenderBackend::destroyTextureArray(TextureArray& a_textureArray)
+{
+  if (a_textureArray.isCreated())
+    a_textureArray.destroyArray();
+}
+
+Status OGLRenderBackend::initVertexBuffer(VertexBuffer& a_buffer, const void* a_data)
+{
+  return a_buffer.initBuffer(a_data);
+}
+
+void OGLRenderBackend::destroyVertexBuffer(VertexBuffer& a_buffer)
+{
+  if (a_buffer.isCreated())
+    a_buffer.destroyBuffer();
+}
+
+Status OGLRenderBackend::useVertexBuffer(VertexBuffer& a_buffer)
+{
+  return a_buffer.useBuffer();
+}
+
+Status OGLRenderBackend::updateVertexBuffer(VertexBuffer& a_buffer, const void* a_data, std::size_t a_dataSize, std::size_t a_offset)
+{
+  return a_buffer.updateData(a_data, a_dataSize, a_offset);
+}
+
+Status OGLRenderBackend::mapTransient(VertexBuffer& a_buffer, std::size_t a_dataSize, void** a_writePtr, std::size_t& a_offset)
+{
+  return a_buffer.mapTransient(a_dataSize, a_writePtr, a_offset);
+}
+
+Status OGLRenderBackend::unmapTransient(VertexBuffer& a_buffer)
+{
+  return a_buffer.unmapTransient();
+}
+
+void OGLRenderBackend::fenceTransients(VertexBuffer& a_buffer)
+{
+  a_buffer.fenceTransients();
+}
+
+Status OGLRenderBackend::initGeometry(IndexedGeometry& a_geometry)
+{
+  return a_geometry.initGeometry();
+}
+
+void OGLRenderBackend::destroyGeometry(IndexedGeometry& a_geometry)
+{
+  if (a_geometry.isGeometryInitialized())
+    a_geometry.destroyGeometry();
+}
+
+Status OGLRenderBackend::drawGeometry(IndexedGeometry& a_geometry)
+{
+  return a_geometry.drawGeometry();
+}
+
+Status OGLRenderBackend::drawGeometryInstanced(IndexedGeometry& a_geometry, FlurrHandle a_instanceBufferHandle, uint32_t a_instanceCount)
+{
+  return a_geometry.drawGeometryInstanced(a_instanceBufferHandle, a_instanceCount);
+}
+
+Status OGLRenderBackend::initArena(GeometryArena& a_arena)
+{
+  Status result = a_arena.initArena();
+  if (Status::kSuccess != result)
+    a_arena.destroyArena();
+
+  return result;
+}
+
+void OGLRenderBackend::destroyArena(GeometryArena& a_arena)
+{
+  if (a_arena.isCreated())
+    a_arena.destroyArena();
+}
+
+Status OGLRenderBackend::updateArena(GeometryArena& a_arena, const ArenaMesh& a_mesh, const void* a_vertexData, const uint32_t* a_indexData)
+{
+  return a_arena.uploadMesh(a_mesh, a_vertexData, a_indexData);
+}
+
+Status OGLRenderBackend::copyArena(GeometryArena& a_arena, const std::vector<ArenaMesh>& a_packedMeshes)
+{
+  return a_arena.copyMeshes(a_packedMeshes);
+}
+
+Status OGLRenderBackend::drawArenaMesh(GeometryArena& a_arena, const ArenaMesh& a_mesh)
+{
+  return a_arena.drawOGLMesh(a_mesh);
+}
+
+Status OGLRenderBackend::drawArenaMeshes(GeometryArena& a_arena, const std::vector<FlurrHandle>& a_meshHandles)
+{
+  return a_arena.drawOGLMeshes(a_meshHandles);
+}
+
+Status OGLRenderBackend::initRenderTarget(RenderTarget& a_renderTarget, uint32_t a_width, uint32_t a_height, RenderTargetFormat a_colorFormat, bool a_hasDepth, uint32_t a_sampleCount)
+{
+  return a_renderTarget.initRenderTarget(a_width, a_height, a_colorFormat, a_hasDepth, a_sampleCount);
+}
+
+void OGLRenderBackend::destroyRenderTarget(RenderTarget& a_renderTarget)
+{
+  // Deleting a bound framebuffer reverts the binding to the default framebuffer
+  if (a_renderTarget.isCreated())
+    a_renderTarget.destroyRenderTarget();
+}
+
+Status OGLRenderBackend::readPixels(const RenderTarget& a_renderTarget, std::vector<uint8_t>& a_pixels)
+{
+  // Read tightly packed rows straight into client memory
+  a_pixels.resize(static_cast<std::size_t>(a_renderTarget.getWidth()) * a_renderTarget.getHeight() * 4);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, a_renderTarget.getOGLReadFramebufferId());
+  FlurrCore::Get().getRenderer()->getStateCache().bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(0, 0, a_renderTarget.getWidth(), a_renderTarget.getHeight(), GL_RGBA, GL_UNSIGNED_BYTE, a_pixels.data());
+
+  return Status::kSuccess;
+}
+
+} // namespace flurr
@@ -0,0 +1,245 @@
+#include "flurr/renderer/PixelReadback.h"
+#include "flurr/FlurrCore.h"
+#include "flurr/FlurrLog.h"
+
+#include <algorithm>
+
+namespace flurr
+{
+
+PixelReadback::PixelReadback()
+  : m_initialized(false)
+{
+}
+
+void PixelReadback::init()
+{
+  m_initialized = true;
+}
+
+void PixelReadback::shutdown()
+{
+  if (!m_initialized)
+    return;
+
+  // Drop undelivered readbacks
+  for (auto& readback : m_readbacks)
+    if (ReadbackState::kReading == readback.state)
+      glDeleteSync(readback.oglFence);
+  m_readbacks.clear();
+
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+  for (auto& pixelBuffer : m_pixelBuffers)
+  {
+    glDeleteBuffers(1, &pixelBuffer.oglBufferId);
+    stateCache.onBufferDeleted(pixelBuffer.oglBufferId);
+  }
+  m_pixelBuffers.clear();
+
+  m_initialized = false;
+}
+
+void PixelReadback::update()
+{
+  if (!m_initialized)
+    return;
+
+  // Deliver readbacks whose copies have finished, without waiting for the others;
+  // callbacks may queue new readbacks, so only look at the ones present now
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+  const std::size_t readbackCount = m_readbacks.size();
+  for (std::size_t readbackIndex = 0; readbackIndex < readbackCount; ++readbackIndex)
+  {
+    if (ReadbackState::kReading != m_readbacks[readbackIndex].state)
+      continue;
+
+    GLenum waitResult = glClientWaitSync(m_readbacks[readbackIndex].oglFence, 0, 0);
+    if (GL_ALREADY_SIGNALED != waitResult && GL_CONDITION_SATISFIED != waitResult)
+      continue;
+
+    glDeleteSync(m_readbacks[readbackIndex].oglFence);
+    m_readbacks[readbackIndex].oglFence = nullptr;
+    m_readbacks[readbackIndex].state = ReadbackState::kDone;
+    const std::size_t pixelBufferIndex = m_readbacks[readbackIndex].pixelBufferIndex;
+    const uint32_t width = m_readbacks[readbackIndex].width;
+    const uint32_t height = m_readbacks[readbackIndex].height;
+    auto callback = std::move(m_readbacks[readbackIndex].callback);
+
+    // Map PBO and hand pixels to the callback
+    const std::size_t dataSize = static_cast<std::size_t>(width) * height * 4;
+    stateCache.bindBuffer(GL_PIXEL_PACK_BUFFER, m_pixelBuffers[pixelBufferIndex].oglBufferId);
+    const auto* pixels = static_cast<const uint8_t*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, dataSize, GL_MAP_READ_BIT));
+    if (pixels)
+    {
+      callback(pixels, width, height);
+      stateCache.bindBuffer(GL_PIXEL_PACK_BUFFER, m_pixelBuffers[pixelBufferIndex].oglBufferId); // callback may have rebound it
+      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    else
+    {
+      FLURR_LOG_ERROR("Failed to map pixel buffer for readback of render target %u!", m_readbacks[readbackIndex].targetHandle);
+    }
+    stateCache.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    releasePixelBuffer(pixelBufferIndex);
+  }
+  m_readbacks.erase(std::remove_if(m_readbacks.begin(), m_readbacks.end(),
+    [](const Readback& a_readback) { return ReadbackState::kDone == a_readback.state; }),
+    m_readbacks.end());
+}
+
+void PixelReadback::issueReadbacks(FlurrHandle a_currentTargetHandle)
+{
+  if (!m_initialized)
+    return;
+
+  for (auto& readback : m_readbacks)
+  {
+    if (ReadbackState::kQueued != readback.state)
+      continue;
+
+    if (!startReadback(readback, a_currentTargetHandle))
+      readback.state = ReadbackState::kDone;
+  }
+}
+
+Status PixelReadback::queueReadback(FlurrHandle a_targetHandle, PixelReadbackCallback a_callback)
+{
+  if (!m_initialized)
+  {
+    FLURR_LOG_ERROR("Pixel readback not initialized!");
+    return Status::kNotInitialized;
+  }
+
+  if (!a_callback)
+  {
+    FLURR_LOG_ERROR("Unable to queue pixel readback without a callback!");
+    return Status::kNullArgument;
+  }
+
+  // Every readback needs its own PBO until delivered
+  if (m_readbacks.size() >= kMaxPixelBufferCount)
+  {
+    FLURR_LOG_ERROR("Too many pixel readbacks in flight!");
+    return Status::kInvalidState;
+  }
+
+  m_readbacks.push_back(Readback{a_targetHandle, std::move(a_callback), 0, 0, kInvalidPixelBufferIndex, nullptr, ReadbackState::kQueued});
+  return Status::kSuccess;
+}
+
+bool PixelReadback::startReadback(Readback& a_readback, FlurrHandle a_currentTargetHandle)
+{
+  // Determine framebuffer to read
+  auto* renderer = FlurrCore::Get().getRenderer();
+  const FlurrHandle targetHandle = INVALID_HANDLE != a_readback.targetHandle ? a_readback.targetHandle : a_currentTargetHandle;
+  GLuint oglFramebufferId = 0;
+  GLint x = 0, y = 0;
+  if (INVALID_HANDLE != targetHandle)
+  {
+    auto* renderTarget = renderer->getRenderTarget(targetHandle);
+    if (!renderTarget)
+    {
+      FLURR_LOG_ERROR("Unable to read back pixels; render target %u does not exist!", targetHandle);
+      return false;
+    }
+    oglFramebufferId = renderTarget->getOGLReadFramebufferId();
+    a_readback.width = renderTarget->getWidth();
+    a_readback.height = renderTarget->getHeight();
+  }
+  else
+  {
+    // Default framebuffer, read within the current viewport
+    GLint viewport[4] = {0, 0, 0, 0};
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    x = viewport[0];
+    y = viewport[1];
+    a_readback.width = static_cast<uint32_t>(std::max(viewport[2], 0));
+    a_readback.height = static_cast<uint32_t>(std::max(viewport[3], 0));
+  }
+
+  const std::size_t dataSize = static_cast<std::size_t>(a_readback.width) * a_readback.height * 4;
+  if (0 == dataSize)
+  {
+    FLURR_LOG_ERROR("Unable to read back pixels from empty framebuffer!");
+    return false;
+  }
+
+  std::size_t pixelBufferIndex = acquirePixelBuffer(dataSize);
+  if (kInvalidPixelBufferIndex == pixelBufferIndex)
+  {
+    FLURR_LOG_ERROR("No pixel buffer available for readback!");
+    return false;
+  }
+
+  // Copy framebuffer into PBO on the GPU and fence it
+  auto& stateCache = renderer->getStateCache();
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, oglFramebufferId);
+  stateCache.bindBuffer(GL_PIXEL_PACK_BUFFER, m_pixelBuffers[pixelBufferIndex].oglBufferId);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(x, y, a_readback.width, a_readback.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  stateCache.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  a_readback.pixelBufferIndex = pixelBufferIndex;
+  a_readback.oglFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  a_readback.state = ReadbackState::kReading;
+
+  return true;
+}
+
+std::size_t PixelReadback::acquirePixelBuffer(std::size_t a_dataSize)
+{
+  // Prefer the smallest free PBO that fits
+  std::size_t pixelBufferIndex = kInvalidPixelBufferIndex;
+  std::size_t freePixelBufferIndex = kInvalidPixelBufferIndex;
+  for (std::size_t bufferIndex = 0; bufferIndex < m_pixelBuffers.size(); ++bufferIndex)
+  {
+    const auto& pixelBuffer = m_pixelBuffers[bufferIndex];
+    if (pixelBuffer.inUse)
+      continue;
+
+    freePixelBufferIndex = bufferIndex;
+    if (pixelBuffer.size >= a_dataSize &&
+      (kInvalidPixelBufferIndex == pixelBufferIndex || pixelBuffer.size < m_pixelBuffers[pixelBufferIndex].size))
+    {
+      pixelBufferIndex = bufferIndex;
+    }
+  }
+
+  if (kInvalidPixelBufferIndex == pixelBufferIndex)
+  {
+    if (m_pixelBuffers.size() < kMaxPixelBufferCount)
+    {
+      // Grow the pool
+      PixelBuffer pixelBuffer{0, 0, false};
+      glGenBuffers(1, &pixelBuffer.oglBufferId);
+      m_pixelBuffers.push_back(pixelBuffer);
+      pixelBufferIndex = m_pixelBuffers.size() - 1;
+    }
+    else if (kInvalidPixelBufferIndex != freePixelBufferIndex)
+    {
+      // Pool is full, so resize a free PBO that is too small
+      pixelBufferIndex = freePixelBufferIndex;
+    }
+    else
+    {
+      return kInvalidPixelBufferIndex;
+    }
+
+    auto& pixelBuffer = m_pixelBuffers[pixelBufferIndex];
+    auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+    stateCache.bindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffer.oglBufferId);
+    glBufferData(GL_PIXEL_PACK_BUFFER, a_dataSize, nullptr, GL_STREAM_READ);
+    stateCache.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    pixelBuffer.size = a_dataSize;
+  }
+
+  m_pixelBuffers[pixelBufferIndex].inUse = true;
+  return pixelBufferIndex;
+}
+
+void PixelReadback::releasePixelBuffer(std::size_t a_pixelBufferIndex)
+{
+  if (a_pixelBufferIndex < m_pixelBuffers.size())
+    m_pixelBuffers[a_pixelBufferIndex].inUse = false;
+}
+
+} // namespace flurr
@@ -0,0 +1,182 @@
+#include "flurr/renderer/ProgramBinaryCache.h"
+#include "flurr/FlurrLog.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+namespace flurr
+{
+
+ProgramBinaryCache::ProgramBinaryCache()
+  : m_enabled(true),
+  m_supported(false),
+  m_cacheDirectory(kDefaultCacheDirectory),
+  m_contextHash(0),
+  m_hitCount(0),
+  m_missCount(0)
+{
+}
+
+uint64_t ProgramBinaryCache::Hash(const void* a_data, std::size_t a_dataSize, uint64_t a_hash)
+{
+  const auto* data = static_cast<const uint8_t*>(a_data);
+  for (std::size_t byteIndex = 0; byteIndex < a_dataSize; ++byteIndex)
+  {
+    a_hash ^= data[byteIndex];
+    a_hash *= 1099511628211ull; // FNV prime
+  }
+
+  return a_hash;
+}
+
+void ProgramBinaryCache::init()
+{
+  // Program binaries require driver support for at least one binary format
+  GLint numBinaryFormats = 0;
+  if (GLEW_ARB_get_program_binary)
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numBinaryFormats);
+  m_supported = numBinaryFormats > 0;
+  if (!m_supported)
+  {
+    FLURR_LOG_INFO("Shader program binaries not supported, program binary cache disabled.");
+    return;
+  }
+
+  // Binaries are only valid for the same driver
+  std::string contextStr;
+  for (GLenum oglStringName : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+  {
+    const auto* oglStr = reinterpret_cast<const char*>(glGetString(oglStringName));
+    contextStr += oglStr ? oglStr : "";
+    contextStr += '\n';
+  }
+  m_contextHash = Hash(contextStr.data(), contextStr.size());
+}
+
+Status ProgramBinaryCache::loadProgram(uint64_t a_sourceHash, GLuint a_oglProgramId)
+{
+  if (!isEnabled())
+    return Status::kInvalidState;
+
+  std::ifstream ifs(getEntryPath(a_sourceHash), std::ios::binary);
+  if (!ifs.good())
+  {
+    ++m_missCount;
+    return Status::kResourceFileNotFound;
+  }
+
+  // Validate entry header
+  EntryHeader header;
+  ifs.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!ifs.good() || kEntryMagic != header.magic || kEntryVersion != header.version ||
+    a_sourceHash != header.sourceHash || m_contextHash != header.contextHash)
+  {
+    FLURR_LOG_DEBUG("Program binary cache entry %016" PRIx64 " stale, removing.", a_sourceHash);
+    ifs.close();
+    removeProgram(a_sourceHash);
+    ++m_missCount;
+    return Status::kInvalidState;
+  }
+
+  // Load program from binary
+  std::vector<char> binary(header.binarySize);
+  ifs.read(binary.data(), binary.size());
+  if (!ifs.good())
+  {
+    ifs.close();
+    removeProgram(a_sourceHash);
+    ++m_missCount;
+    return Status::kReadFileError;
+  }
+  glProgramBinary(a_oglProgramId, header.oglBinaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+  // Driver may reject binaries, e.g. after an update that kept the version string
+  GLint linkStatus = 0;
+  glGetProgramiv(a_oglProgramId, GL_LINK_STATUS, &linkStatus);
+  if (!linkStatus)
+  {
+    FLURR_LOG_DEBUG("Program binary cache entry %016" PRIx64 " rejected by driver, removing.", a_sourceHash);
+    ifs.close();
+    removeProgram(a_sourceHash);
+    ++m_missCount;
+    return Status::kLinkingFailed;
+  }
+
+  ++m_hitCount;
+  return Status::kSuccess;
+}
+
+Status ProgramBinaryCache::storeProgram(uint64_t a_sourceHash, GLuint a_oglProgramId)
+{
+  if (!isEnabled())
+    return Status::kInvalidState;
+
+  // Get program binary
+  GLint binarySize = 0;
+  glGetProgramiv(a_oglProgramId, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+  if (binarySize <= 0)
+  {
+    FLURR_LOG_WARN("Unable to cache shader program; no program binary available!");
+    return Status::kFailed;
+  }
+  std::vector<char> binary(binarySize);
+  GLenum oglBinaryFormat = 0;
+  glGetProgramBinary(a_oglProgramId, binarySize, &binarySize, &oglBinaryFormat, binary.data());
+
+  // Write entry to a temporary file first, so readers never see partial entries
+  std::error_code error;
+  std::filesystem::create_directories(m_cacheDirectory, error);
+  const std::string entryPath = getEntryPath(a_sourceHash);
+  const std::string tempEntryPath = entryPath + ".tmp";
+  {
+    std::ofstream ofs(tempEntryPath, std::ios::binary | std::ios::trunc);
+    const EntryHeader header{kEntryMagic, kEntryVersion, a_sourceHash, m_contextHash, oglBinaryFormat, static_cast<uint32_t>(binarySize)};
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    ofs.write(binary.data(), binarySize);
+    if (!ofs.good())
+    {
+      FLURR_LOG_WARN("Failed to write program binary cache entry %s!", tempEntryPath.c_str());
+      ofs.close();
+      std::filesystem::remove(tempEntryPath, error);
+      return Status::kOpenFileError;
+    }
+  }
+  std::filesystem::rename(tempEntryPath, entryPath, error);
+  if (error)
+  {
+    FLURR_LOG_WARN("Failed to write program binary cache entry %s!", entryPath.c_str());
+    std::filesystem::remove(tempEntryPath, error);
+    return Status::kOpenFileError;
+  }
+
+  return Status::kSuccess;
+}
+
+void ProgramBinaryCache::removeProgram(uint64_t a_sourceHash)
+{
+  std::error_code error;
+  std::filesystem::remove(getEntryPath(a_sourceHash), error);
+}
+
+void ProgramBinaryCache::clear()
+{
+  std::error_code error;
+  for (const auto& entry : std::filesystem::directory_iterator(m_cacheDirectory, error))
+  {
+    if (entry.path().extension() == kEntryExtension)
+      std::filesystem::remove(entry.path(), error);
+  }
+}
+
+std::string ProgramBinaryCache::getEntryPath(uint64_t a_sourceHash) const
+{
+  char entryName[32];
+  std::snprintf(entryName, sizeof(entryName), "%016" PRIx64 "%s", a_sourceHash, kEntryExtension);
+  return (std::filesystem::path(m_cacheDirectory) / entryName).string();
+}
+
+} // namespace flurr
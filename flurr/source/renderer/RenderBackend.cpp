@@ -0,0 +1,34 @@
+#include "flurr/renderer/RenderBackend.h"
+#include "flurr/renderer/NullRenderBackend.h"
+#include "flurr/renderer/OGLRenderBackend.h"
+#include "flurr/utils/StringUtils.h"
+
+namespace flurr
+{
+
+std::unique_ptr<RenderBackend> RenderBackend::Create(RenderBackendType a_backendType)
+{
+  switch (a_backendType)
+  {
+  case RenderBackendType::kNull:
+    return std::make_unique<NullRenderBackend>();
+  case RenderBackendType::kOpenGL:
+  default:
+    return std::make_unique<OGLRenderBackend>();
+  }
+}
+
+bool RenderBackend::ParseBackendType(const std::string& a_str, RenderBackendType& a_backendType)
+{
+  const std::string str = TrimString(a_str);
+  if ("OpenGL" == str)
+    a_backendType = RenderBackendType::kOpenGL;
+  else if ("Null" == str)
+    a_backendType = RenderBackendType::kNull;
+  else
+    return false;
+
+  return true;
+}
+
+} // namespace flurr
@@ -0,0 +1,12 @@
+#include "flurr/renderer/RenderCommandList.h"
+
+namespace flurr
+{
+
+void RenderCommandList::addDraw(FlurrHandle a_programHandle, FlurrHandle a_geometryHandle, const glm::mat4& a_modelTransf, FlurrHandle a_texHandle, float a_viewDepth,
+  const glm::vec4& a_drawParams)
+{
+  m_draws.push_back(RenderCommandListDraw{a_programHandle, a_geometryHandle, a_texHandle, a_modelTransf, a_viewDepth, a_drawParams});
+}
+
+} // namespace flurr
@@ -0,0 +1,102 @@
+#include "flurr/renderer/RenderQueue.h"
+#include "flurr/FlurrLog.h"
+#include "flurr/utils/SlotMap.h"
+
+#include <cstring>
+
+namespace flurr
+{
+
+namespace
+{
+
+// Handle generations are dropped from sort keys, since only one live object can occupy a slot
+constexpr FlurrHandle kSlotIndexMask = SlotMap<RenderCommand>::kIndexMask;
+constexpr FlurrHandle kHandleKeyMask = 0xFFFF;
+
+uint64_t MakeHandleKey(FlurrHandle a_handle)
+{
+  // Slot indices beyond 16 bits alias other handles; draws still bind the right objects, but batch worse
+  if ((a_handle & kSlotIndexMask) > kHandleKeyMask)
+    FLURR_ASSERT(false, "Handle %u does not fit into a 16-bit sort key field!", a_handle);
+
+  return a_handle & kHandleKeyMask;
+}
+
+} // namespace
+
+uint64_t RenderQueue::MakeSortKey(FlurrHandle a_programHandle, FlurrHandle a_textureHandle, FlurrHandle a_geometryHandle, float a_viewDepth, bool a_textureArray)
+{
+  // Quantize depth; bit patterns of non-negative floats are ordered like the floats themselves
+  const float viewDepth = a_viewDepth > 0.0f ? a_viewDepth : 0.0f;
+  uint32_t depthBits = 0;
+  std::memcpy(&depthBits, &viewDepth, sizeof(depthBits));
+  const uint64_t depthKey = (depthBits >> 16) & 0x7FFF;
+
+  return (MakeHandleKey(a_programHandle) << 48) |
+    (static_cast<uint64_t>(a_textureArray ? 1 : 0) << 47) |
+    (MakeHandleKey(a_textureHandle) << 31) |
+    (MakeHandleKey(a_geometryHandle) << 15) |
+    depthKey;
+}
+
+void RenderQueue::addCommand(FlurrHandle a_programHandle, FlurrHandle a_textureHandle, FlurrHandle a_geometryHandle, const glm::mat4& a_modelTransf, float a_viewDepth, FlurrHandle a_textureArrayHandle,
+  const glm::vec4& a_drawParams)
+{
+  const bool textureArray = INVALID_HANDLE != a_textureArrayHandle;
+  const uint64_t sortKey = MakeSortKey(a_programHandle, textureArray ? a_textureArrayHandle : a_textureHandle, a_geometryHandle, a_viewDepth, textureArray);
+  m_sortItems.push_back(SortItem{sortKey, static_cast<uint32_t>(m_commands.size())});
+  m_commands.push_back(RenderCommand{sortKey, a_programHandle, a_textureHandle, a_geometryHandle, a_modelTransf, a_drawParams});
+}
+
+void RenderQueue::sort()
+{
+  const std::size_t itemCount = m_sortItems.size();
+  if (itemCount < 2)
+    return;
+
+  // Build histograms for all digits in a single pass
+  uint32_t counts[kRadixPassCount][kRadixSize] = {};
+  for (const auto& item : m_sortItems)
+    for (uint32_t passIndex = 0; passIndex < kRadixPassCount; ++passIndex)
+      ++counts[passIndex][(item.sortKey >> (passIndex * kRadixBits)) & (kRadixSize - 1)];
+
+  // LSD radix sort, skipping digits that are the same for all keys
+  m_sortScratch.resize(itemCount);
+  for (uint32_t passIndex = 0; passIndex < kRadixPassCount; ++passIndex)
+  {
+    uint32_t* passCounts = counts[passIndex];
+    const uint32_t shift = passIndex * kRadixBits;
+    if (passCounts[(m_sortItems[0].sortKey >> shift) & (kRadixSize - 1)] == itemCount)
+      continue;
+
+    // Compute digit offsets
+    uint32_t offset = 0;
+    for (uint32_t digit = 0; digit < kRadixSize; ++digit)
+    {
+      const uint32_t count = passCounts[digit];
+      passCounts[digit] = offset;
+      offset += count;
+    }
+
+    // Scatter items (stable)
+    for (const auto& item : m_sortItems)
+      m_sortScratch[passCounts[(item.sortKey >> shift) & (kRadixSize - 1)]++] = item;
+    m_sortItems.swap(m_sortScratch);
+  }
+}
+
+void RenderQueue::clear()
+{
+  m_commands.clear();
+  m_sortItems.clear();
+}
+
+void RenderQueue::reserve(std::size_t a_commandCount)
+{
+  m_commands.reserve(a_commandCount);
+  m_sortItems.reserve(a_commandCount);
+  m_sortScratch.reserve(a_commandCount);
+}
+
+} // namespace flurr
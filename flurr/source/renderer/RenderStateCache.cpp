@@ -0,0 +1,157 @@
+#include "flurr/renderer/RenderStateCache.h"
+#include "flurr/FlurrLog.h"
+
+namespace flurr
+{
+
+RenderStateCache::RenderStateCache()
+{
+  invalidate();
+}
+
+void RenderStateCache::useProgram(GLuint a_oglProgramId)
+{
+  if (m_oglProgramId == a_oglProgramId)
+  {
+    ++m_stats.programBindsSkipped;
+    return;
+  }
+
+  glUseProgram(a_oglProgramId);
+  m_oglProgramId = a_oglProgramId;
+}
+
+void RenderStateCache::bindVertexArray(GLuint a_oglVaoId)
+{
+  if (m_oglVaoId == a_oglVaoId)
+  {
+    ++m_stats.vertexArrayBindsSkipped;
+    return;
+  }
+
+  glBindVertexArray(a_oglVaoId);
+  m_oglVaoId = a_oglVaoId;
+
+  // Element buffer binding is stored in the VAO, so we no longer know it
+  m_oglElementBufferId = kUnknownBinding;
+}
+
+void RenderStateCache::bindBuffer(GLenum a_oglBufferType, GLuint a_oglBufferId)
+{
+  GLuint* cachedBufferId = nullptr;
+  if (GL_ARRAY_BUFFER == a_oglBufferType)
+    cachedBufferId = &m_oglArrayBufferId;
+  else if (GL_ELEMENT_ARRAY_BUFFER == a_oglBufferType)
+    cachedBufferId = &m_oglElementBufferId;
+
+  if (cachedBufferId && *cachedBufferId == a_oglBufferId)
+  {
+    ++m_stats.bufferBindsSkipped;
+    return;
+  }
+
+  glBindBuffer(a_oglBufferType, a_oglBufferId);
+  if (cachedBufferId)
+    *cachedBufferId = a_oglBufferId;
+}
+
+void RenderStateCache::bindTexture(TextureUnitIndex a_texUnit, GLenum a_oglTexType, GLuint a_oglTexId)
+{
+  FLURR_ASSERT(a_texUnit <= MAX_TEXTURE_UNIT, "Texture unit index out of bounds!");
+
+  auto& texBinding = m_textureBindings[a_texUnit];
+  if (texBinding.oglTexType == a_oglTexType && texBinding.oglTexId == a_oglTexId)
+  {
+    ++m_stats.textureBindsSkipped;
+    return;
+  }
+
+  setActiveTextureUnit(a_texUnit);
+  glBindTexture(a_oglTexType, a_oglTexId);
+  texBinding.oglTexType = a_oglTexType;
+  texBinding.oglTexId = a_oglTexId;
+}
+
+void RenderStateCache::bindTexture(GLenum a_oglTexType, GLuint a_oglTexId)
+{
+  bindTexture(kUnknownTextureUnit != m_activeTexUnit ? m_activeTexUnit : 0, a_oglTexType, a_oglTexId);
+}
+
+void RenderStateCache::setActiveTextureUnit(TextureUnitIndex a_texUnit)
+{
+  if (m_activeTexUnit == a_texUnit)
+  {
+    ++m_stats.activeTextureSwitchesSkipped;
+    return;
+  }
+
+  glActiveTexture(GL_TEXTURE0 + a_texUnit);
+  m_activeTexUnit = a_texUnit;
+}
+
+void RenderStateCache::bindSampler(TextureUnitIndex a_texUnit, GLuint a_oglSamplerId)
+{
+  FLURR_ASSERT(a_texUnit <= MAX_TEXTURE_UNIT, "Texture unit index out of bounds!");
+
+  // Samplers bind to units directly, no need to switch the active unit
+  if (m_oglSamplerIds[a_texUnit] == a_oglSamplerId)
+  {
+    ++m_stats.samplerBindsSkipped;
+    return;
+  }
+
+  glBindSampler(a_texUnit, a_oglSamplerId);
+  m_oglSamplerIds[a_texUnit] = a_oglSamplerId;
+}
+
+void RenderStateCache::onProgramDeleted(GLuint a_oglProgramId)
+{
+  // A deleted program stays in use, but its name can be reused
+  if (m_oglProgramId == a_oglProgramId)
+    m_oglProgramId = kUnknownBinding;
+}
+
+void RenderStateCache::onVertexArrayDeleted(GLuint a_oglVaoId)
+{
+  if (m_oglVaoId == a_oglVaoId)
+  {
+    m_oglVaoId = 0;
+    m_oglElementBufferId = kUnknownBinding;
+  }
+}
+
+void RenderStateCache::onBufferDeleted(GLuint a_oglBufferId)
+{
+  if (m_oglArrayBufferId == a_oglBufferId)
+    m_oglArrayBufferId = 0;
+  if (m_oglElementBufferId == a_oglBufferId)
+    m_oglElementBufferId = 0;
+}
+
+void RenderStateCache::onTextureDeleted(GLuint a_oglTexId)
+{
+  for (auto& texBinding : m_textureBindings)
+    if (texBinding.oglTexId == a_oglTexId)
+      texBinding.oglTexId = 0;
+}
+
+void RenderStateCache::onSamplerDeleted(GLuint a_oglSamplerId)
+{
+  for (auto& oglSamplerId : m_oglSamplerIds)
+    if (oglSamplerId == a_oglSamplerId)
+      oglSamplerId = 0;
+}
+
+void RenderStateCache::invalidate()
+{
+  m_oglProgramId = kUnknownBinding;
+  m_oglVaoId = kUnknownBinding;
+  m_oglArrayBufferId = kUnknownBinding;
+  m_oglElementBufferId = kUnknownBinding;
+  m_activeTexUnit = kUnknownTextureUnit;
+  for (auto& texBinding : m_textureBindings)
+    texBinding = TextureBinding{GL_NONE, kUnknownBinding};
+  m_oglSamplerIds.fill(kUnknownBinding);
+}
+
+} // namespace flurr
@@ -0,0 +1,165 @@
+#include "flurr/renderer/RenderTarget.h"
+#include "flurr/FlurrCore.h"
+#include "flurr/FlurrLog.h"
+
+#include <algorithm>
+
+namespace flurr
+{
+
+RenderTarget::RenderTarget(FlurrHandle a_targetHandle)
+  : m_targetHandle(a_targetHandle),
+  m_width(0),
+  m_height(0),
+  m_colorFormat(RenderTargetFormat::kRGBA8),
+  m_hasDepth(false),
+  m_sampleCount(1),
+  m_oglFramebufferId(0),
+  m_oglResolveFramebufferId(0),
+  m_oglColorTexId(0),
+  m_oglColorRenderbufferId(0),
+  m_oglDepthRenderbufferId(0)
+{
+}
+
+Status RenderTarget::initRenderTarget(uint32_t a_width, uint32_t a_height, RenderTargetFormat a_colorFormat, bool a_hasDepth, uint32_t a_sampleCount)
+{
+  if (isCreated())
+  {
+    FLURR_LOG_ERROR("Render target %u already created!", getTargetHandle());
+    return Status::kInvalidState;
+  }
+
+  if (0 == a_width || 0 == a_height)
+  {
+    FLURR_LOG_ERROR("Unable to create render target with zero size!");
+    return Status::kInvalidArgument;
+  }
+
+  GLint maxRenderbufferSize = 0;
+  glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &maxRenderbufferSize);
+  if (maxRenderbufferSize > 0 && (a_width > static_cast<uint32_t>(maxRenderbufferSize) || a_height > static_cast<uint32_t>(maxRenderbufferSize)))
+  {
+    FLURR_LOG_ERROR("Render target size %ux%u exceeds maximum %d!", a_width, a_height, maxRenderbufferSize);
+    return Status::kInvalidArgument;
+  }
+
+  // Clamp sample count to what the driver supports
+  GLint maxSampleCount = 1;
+  glGetIntegerv(GL_MAX_SAMPLES, &maxSampleCount);
+  const uint32_t sampleCount = std::clamp(a_sampleCount, 1u, static_cast<uint32_t>(std::max(maxSampleCount, 1)));
+  if (sampleCount != a_sampleCount)
+    FLURR_LOG_WARN("%u samples not supported for render target %u, using %u.", a_sampleCount, getTargetHandle(), sampleCount);
+
+  m_width = a_width;
+  m_height = a_height;
+  m_colorFormat = a_colorFormat;
+  m_hasDepth = a_hasDepth;
+  m_sampleCount = sampleCount;
+  const GLenum oglInternalFormat = RenderTargetFormat::kRGBA16F == m_colorFormat ? GL_RGBA16F : GL_RGBA8;
+  const GLenum oglType = RenderTargetFormat::kRGBA16F == m_colorFormat ? GL_HALF_FLOAT : GL_UNSIGNED_BYTE;
+
+  // Create single-sampled colour texture (resolve destination for multisampled targets)
+  glGenTextures(1, &m_oglColorTexId);
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+  stateCache.bindTexture(GL_TEXTURE_2D, m_oglColorTexId);
+  glTexImage2D(GL_TEXTURE_2D, 0, oglInternalFormat, m_width, m_height, 0, GL_RGBA, oglType, nullptr);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+  // Create framebuffer with colour and depth attachments
+  glGenFramebuffers(1, &m_oglFramebufferId);
+  glBindFramebuffer(GL_FRAMEBUFFER, m_oglFramebufferId);
+  if (isMultisampled())
+  {
+    glGenRenderbuffers(1, &m_oglColorRenderbufferId);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_oglColorRenderbufferId);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, m_sampleCount, oglInternalFormat, m_width, m_height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_oglColorRenderbufferId);
+  }
+  else
+  {
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_oglColorTexId, 0);
+  }
+  if (m_hasDepth)
+  {
+    glGenRenderbuffers(1, &m_oglDepthRenderbufferId);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_oglDepthRenderbufferId);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, isMultisampled() ? m_sampleCount : 0, GL_DEPTH24_STENCIL8, m_width, m_height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_oglDepthRenderbufferId);
+  }
+  glBindRenderbuffer(GL_RENDERBUFFER, 0);
+  bool complete = CheckFramebufferComplete("render target");
+
+  // Create resolve framebuffer around the colour texture
+  if (complete && isMultisampled())
+  {
+    glGenFramebuffers(1, &m_oglResolveFramebufferId);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_oglResolveFramebufferId);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_oglColorTexId, 0);
+    complete = CheckFramebufferComplete("render target resolve");
+  }
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+  if (!complete)
+  {
+    destroyRenderTarget();
+    return Status::kFailed;
+  }
+
+  return Status::kSuccess;
+}
+
+void RenderTarget::destroyRenderTarget()
+{
+  if (m_oglFramebufferId)
+  {
+    glDeleteFramebuffers(1, &m_oglFramebufferId);
+    m_oglFramebufferId = 0;
+  }
+  if (m_oglResolveFramebufferId)
+  {
+    glDeleteFramebuffers(1, &m_oglResolveFramebufferId);
+    m_oglResolveFramebufferId = 0;
+  }
+  if (m_oglColorTexId)
+  {
+    glDeleteTextures(1, &m_oglColorTexId);
+    FlurrCore::Get().getRenderer()->getStateCache().onTextureDeleted(m_oglColorTexId);
+    m_oglColorTexId = 0;
+  }
+  if (m_oglColorRenderbufferId)
+  {
+    glDeleteRenderbuffers(1, &m_oglColorRenderbufferId);
+    m_oglColorRenderbufferId = 0;
+  }
+  if (m_oglDepthRenderbufferId)
+  {
+    glDeleteRenderbuffers(1, &m_oglDepthRenderbufferId);
+    m_oglDepthRenderbufferId = 0;
+  }
+}
+
+void RenderTarget::resolve()
+{
+  if (!isCreated() || !isMultisampled())
+    return;
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, m_oglFramebufferId);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_oglResolveFramebufferId);
+  glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+  glBindFramebuffer(GL_FRAMEBUFFER, m_oglFramebufferId);
+}
+
+bool RenderTarget::CheckFramebufferComplete(const char* a_framebufferName)
+{
+  const GLenum framebufferStatus = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+  if (GL_FRAMEBUFFER_COMPLETE != framebufferStatus)
+  {
+    FLURR_LOG_ERROR("Incomplete %s framebuffer (status 0x%x)!", a_framebufferName, framebufferStatus);
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace flurr
@@ -1,32 +1,25 @@
 #include "flurr/renderer/Renderer.h"
+#include "flurr/renderer/FramePacket.h"
 #include "flurr/FlurrCore.h"
 #include "flurr/FlurrLog.h"
 #include "flurr/utils/ConfigFile.h"
 
-#include <GL/glew.h>
-
 #include <algorithm>
+#include <cstddef>
+#include <cstring>
 
 namespace flurr
 {
 
-void GLAPIENTRY OGLDebugMessageCallback(GLenum source,
-  GLenum type,
-  GLuint id,
-  GLenum severity,
-  GLsizei length,
-  const GLchar* message,
-  const void* userParam) {
-  FLURR_LOG_DEBUG("OGL 0x%x type = 0x%x, severity = 0x%x, message = %s",
-    source, type, severity, message);
-}
-
 Renderer::Renderer()
   : m_initialized(false),
-  m_nextShaderProgramHandle(1),
-  m_nextTextureHandle(1),
-  m_nextVertexBufferHandle(1),
-  m_nextIndexedGeometryHandle(1)
+  m_backend(RenderBackend::Create(RenderBackendType::kOpenGL)),
+  m_maxFramesInFlight(DEFAULT_FRAMES_IN_FLIGHT),
+  m_frameIndex(0),
+  m_renderTargetHandle(INVALID_HANDLE),
+  m_offscreenTargetHandle(INVALID_HANDLE),
+  m_viewport(0),
+  m_frameUniforms{glm::mat4(1.0f), glm::mat4(1.0f), glm::mat4(1.0f), glm::vec4(0.0f), glm::vec4(0.0f)}
 {
 }
 
@@ -36,7 +29,7 @@ Renderer::~Renderer()
     shutdown();
 }
 
-Status Renderer::init()
+Status Renderer::init(const ConfigFile* a_config)
 {
   FLURR_LOG_INFO("Initializing flurr renderer...");
   if (isInitialized())
@@ -45,22 +38,58 @@ Status Renderer::init()
     return Status::kSuccess;
   }
 
-  // Initialize GLEW
-  GLenum glewResult = glewInit();
-  if (GLEW_OK != glewResult)
+  // Select backend from config
+  std::string backendStr;
+  RenderBackendType backendType = m_backend->getBackendType();
+  if (a_config && a_config->readStringValue("Renderer", "backend", backendStr))
   {
-    FLURR_LOG_ERROR("Failed to initialize GLEW (error %u)!", glewResult);
-    return Status::kFailed;
+    if (!RenderBackend::ParseBackendType(backendStr, backendType))
+      FLURR_LOG_WARN("Unknown render backend %s, using default.", backendStr.c_str());
+    else if (backendType != m_backend->getBackendType())
+      m_backend = RenderBackend::Create(backendType);
   }
 
-  // Register debug callback
-  glEnable(GL_DEBUG_OUTPUT);
-  glDebugMessageCallback(OGLDebugMessageCallback, 0);
+  // Bindings made before renderer initialization are unknown
+  m_stateCache.invalidate();
+
+  // Bound how far the CPU may run ahead of the GPU
+  int maxFramesInFlight = static_cast<int>(m_maxFramesInFlight);
+  if (a_config && a_config->readIntValue("Renderer", "maxFramesInFlight", maxFramesInFlight) &&
+    Status::kSuccess != setMaxFramesInFlight(static_cast<uint32_t>(std::max(maxFramesInFlight, 0))))
+  {
+    FLURR_LOG_WARN("Invalid maxFramesInFlight %d, using %u.", maxFramesInFlight, m_maxFramesInFlight);
+  }
+  m_frameIndex = 0;
 
-  // Print OpenGL capabilities
-  int numAttributes = 0;
-  glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &numAttributes);
-  FLURR_LOG_INFO("OpenGL info:\nNumber of attributes: %d", numAttributes);
+  // Initialize backend
+  Status result = m_backend->init();
+  if (Status::kSuccess != result)
+  {
+    FLURR_LOG_ERROR("Failed to initialize render backend!");
+    return result;
+  }
+
+  // GPU-side helpers need a live context
+  if (m_backend->hasGpuContext())
+  {
+    m_gpuProfiler.init();
+    m_programBinaryCache.init();
+    m_textureUploader.init();
+    m_pixelReadback.init();
+
+    // Initialize texture filtering from config
+    TextureFilteringQuality filteringQuality = TextureFilteringQuality::kTrilinear;
+    int anisotropyLevel = 1;
+    std::string filteringQualityStr;
+    if (a_config && a_config->readStringValue("Renderer", "textureFiltering", filteringQualityStr) &&
+      !SamplerCache::ParseFilteringQuality(filteringQualityStr, filteringQuality))
+    {
+      FLURR_LOG_WARN("Unknown texture filtering %s, using trilinear.", filteringQualityStr.c_str());
+    }
+    if (a_config)
+      a_config->readIntValue("Renderer", "anisotropyLevel", anisotropyLevel);
+    m_samplerCache.init(filteringQuality, static_cast<uint32_t>(std::max(anisotropyLevel, 1)));
+  }
 
   m_initialized = true;
   FLURR_LOG_INFO("flurr renderer initialized.");
@@ -76,22 +105,40 @@ void Renderer::shutdown()
     return;
   }
 
-  // Destroy renderer resources
-  for (auto&& geometryKvp : m_indexedGeometries)
-    if (geometryKvp.second->isGeometryInitialized())
-      geometryKvp.second->destroyGeometry();
+  // Destroy renderer resources; GPU-side helpers were only initialized with a live context
+  if (m_backend->hasGpuContext())
+  {
+    m_gpuProfiler.shutdown();
+    m_pixelReadback.shutdown();
+    m_textureUploader.shutdown();
+  }
+  m_renderQueue.clear();
+  for (auto&& geometry : m_indexedGeometries)
+    m_backend->destroyGeometry(*geometry);
   m_indexedGeometries.clear();
-  m_indexedGeometryHandles.clear();
-  for (auto&& vertexBufferKvp : m_vertexBuffers)
-    if (vertexBufferKvp.second->isCreated())
-      vertexBufferKvp.second->destroyBuffer();
+  for (auto&& arena : m_geometryArenas)
+    m_backend->destroyArena(*arena);
+  m_geometryArenas.clear();
+  for (auto&& renderTarget : m_renderTargets)
+    m_backend->destroyRenderTarget(*renderTarget);
+  m_renderTargets.clear();
+  m_renderTargetHandle = INVALID_HANDLE;
+  m_offscreenTargetHandle = INVALID_HANDLE;
+  for (auto&& vertexBuffer : m_vertexBuffers)
+    m_backend->destroyVertexBuffer(*vertexBuffer);
   m_vertexBuffers.clear();
-  m_vertexBufferHandles.clear();
-  for (auto&& shaderProgramKvp : m_shaderPrograms)
-    if (shaderProgramKvp.second->getProgramState() != ShaderProgramState::kDestroyed)
-      shaderProgramKvp.second->destroyProgram();
+  for (auto&& texture : m_textures)
+    m_backend->destroyTexture(*texture);
+  m_textures.clear();
+  if (m_backend->hasGpuContext())
+    m_samplerCache.shutdown();
+  for (auto&& textureArray : m_textureArrays)
+    m_backend->destroyTextureArray(*textureArray);
+  m_textureArrays.clear();
+  for (auto&& shaderProgram : m_shaderPrograms)
+    m_backend->destroyProgram(*shaderProgram);
   m_shaderPrograms.clear();
-  m_shaderProgramHandles.clear();
+  m_backend->shutdown();
 
   // Flag renderer as uninitialized
   m_initialized = false;
@@ -106,16 +153,154 @@ Status Renderer::update(float a_deltaTime)
     return Status::kNotInitialized;
   }
 
-  // Clear buffers
-  glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  // Activate shader programs and textures whose links and uploads have completed
+  updatePendingShaderPrograms();
+  m_textureUploader.update();
+  m_pixelReadback.update();
+
+  m_gpuProfiler.beginFrame();
+  {
+    FLURR_GPU_ZONE(m_gpuProfiler, "Frame");
+
+    // Bind render target and clear buffers
+    auto* renderTarget = getRenderTarget(m_renderTargetHandle);
+    {
+      FLURR_GPU_ZONE(m_gpuProfiler, "Clear");
+      m_backend->beginFrame(renderTarget, m_viewport);
+    }
+
+    // Draw everything submitted this frame
+    {
+      FLURR_GPU_ZONE(m_gpuProfiler, "RenderQueue");
+      flushRenderQueue();
+    }
+
+    // Resolve multisampled target and start reading back the finished frame
+    m_backend->endFrame(renderTarget);
+    m_pixelReadback.issueReadbacks(m_renderTargetHandle);
+  }
+  m_gpuProfiler.endFrame();
+
+  // Protect transient data until the GPU has consumed it
+  fenceStreamBuffers();
+
+  // Fence the frame; the next frame reuses the slot of an older frame, so wait for the GPU to finish that one
+  m_backend->insertFrameFence(getFrameSlot());
+  ++m_frameIndex;
+  Status result = m_backend->waitFrameFence(getFrameSlot());
+  if (Status::kSuccess != result)
+  {
+    FLURR_LOG_ERROR("Failed to pace frame %llu!", static_cast<unsigned long long>(m_frameIndex));
+    return result;
+  }
 
   return Status::kSuccess;
 }
 
+Status Renderer::setBackend(std::unique_ptr<RenderBackend> a_backend)
+{
+  if (isInitialized())
+  {
+    FLURR_LOG_ERROR("Unable to change render backend after renderer initialization!");
+    return Status::kInvalidState;
+  }
+
+  if (!a_backend)
+  {
+    FLURR_LOG_ERROR("Render backend cannot be null!");
+    return Status::kNullArgument;
+  }
+
+  m_backend = std::move(a_backend);
+  return Status::kSuccess;
+}
+
 void Renderer::setViewport(int a_x, int a_y, uint32_t a_width, uint32_t a_height)
 {
-  glViewport(a_x, a_y, a_width, a_height);
+  m_viewport = glm::ivec4(a_x, a_y, static_cast<int>(a_width), static_cast<int>(a_height));
+  m_backend->setViewport(a_x, a_y, a_width, a_height);
+}
+
+Status Renderer::setMaxFramesInFlight(uint32_t a_maxFramesInFlight)
+{
+  if (a_maxFramesInFlight < 1 || a_maxFramesInFlight > MAX_FRAMES_IN_FLIGHT)
+  {
+    FLURR_LOG_ERROR("Max frames in flight must be between 1 and %u!", MAX_FRAMES_IN_FLIGHT);
+    return Status::kInvalidArgument;
+  }
+
+  // Frame slots are remapped, so let frames in flight finish first
+  if (isInitialized())
+  {
+    for (uint32_t frameSlot = 0; frameSlot < m_maxFramesInFlight; ++frameSlot)
+    {
+      const Status result = m_backend->waitFrameFence(frameSlot);
+      if (Status::kSuccess != result)
+        return result;
+    }
+  }
+
+  m_maxFramesInFlight = a_maxFramesInFlight;
+  return Status::kSuccess;
+}
+
+Status Renderer::createOffscreenFramebuffer(uint32_t a_width, uint32_t a_height)
+{
+  // Replace existing framebuffer, e.g. when changing resolution
+  destroyOffscreenFramebuffer();
+
+  Status result = createRenderTarget(m_offscreenTargetHandle, a_width, a_height);
+  if (Status::kSuccess != result)
+  {
+    FLURR_LOG_ERROR("Failed to create %ux%u offscreen framebuffer!", a_width, a_height);
+    return result;
+  }
+
+  FLURR_LOG_INFO("Created %ux%u offscreen framebuffer.", a_width, a_height);
+  return setRenderTarget(m_offscreenTargetHandle);
+}
+
+void Renderer::destroyOffscreenFramebuffer()
+{
+  if (INVALID_HANDLE != m_offscreenTargetHandle)
+    destroyRenderTarget(m_offscreenTargetHandle);
+}
+
+uint32_t Renderer::getOffscreenWidth() const
+{
+  const auto* renderTarget = getRenderTarget(m_offscreenTargetHandle);
+  return renderTarget ? renderTarget->getWidth() : 0;
+}
+
+uint32_t Renderer::getOffscreenHeight() const
+{
+  const auto* renderTarget = getRenderTarget(m_offscreenTargetHandle);
+  return renderTarget ? renderTarget->getHeight() : 0;
+}
+
+Status Renderer::readOffscreenPixels(std::vector<uint8_t>& a_pixels)
+{
+  auto* renderTarget = getRenderTarget(m_offscreenTargetHandle);
+  if (!renderTarget)
+  {
+    FLURR_LOG_ERROR("Unable to read pixels; no offscreen framebuffer!");
+    return Status::kInvalidState;
+  }
+
+  return m_backend->readPixels(*renderTarget, a_pixels);
+}
+
+void Renderer::setFrameUniforms(const FrameUniforms& a_frameUniforms)
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("flurr renderer not initialized!");
+    return;
+  }
+
+  // Time changes every frame, so there is no point in checking for redundant uploads
+  m_frameUniforms = a_frameUniforms;
+  m_backend->updateFrameUniforms(m_frameUniforms);
 }
 
 Status Renderer::createShaderProgram(FlurrHandle& a_programHandle)
@@ -127,9 +312,7 @@ Status Renderer::createShaderProgram(FlurrHandle& a_programHandle)
   }
 
   // Create ShaderProgram instance
-  a_programHandle = GenerateHandle(m_nextShaderProgramHandle, [this](FlurrHandle a_h) { return hasShaderProgram(a_h); });
-  m_shaderPrograms.emplace(a_programHandle, std::make_unique<ShaderProgram>(a_programHandle));
-  m_shaderProgramHandles.push_back(a_programHandle);
+  a_programHandle = m_shaderPrograms.insert(std::make_unique<ShaderProgram>(m_shaderPrograms.getNextHandle()));
 
   return Status::kSuccess;
 }
@@ -150,27 +333,24 @@ void Renderer::destroyShaderProgram(FlurrHandle a_programHandle)
     return;
   }
 
-  if (shaderProgram->getProgramState() != ShaderProgramState::kDestroyed)
-    shaderProgram->destroyProgram();
+  m_backend->destroyProgram(*shaderProgram);
   m_shaderPrograms.erase(a_programHandle);
-  m_shaderProgramHandles.erase(std::remove(m_shaderProgramHandles.begin(), m_shaderProgramHandles.end(), a_programHandle), m_shaderProgramHandles.end());
 }
 
 bool Renderer::hasShaderProgram(FlurrHandle a_programHandle) const
 {
-  return m_shaderPrograms.find(a_programHandle) != m_shaderPrograms.end();
+  return m_shaderPrograms.contains(a_programHandle);
 }
 
 ShaderProgram* Renderer::getShaderProgram(FlurrHandle a_programHandle) const
 {
-  auto&& shaderProgramIt = m_shaderPrograms.find(a_programHandle);
-  return m_shaderPrograms.end() == shaderProgramIt ?
-    nullptr : shaderProgramIt->second.get();
+  const auto* shaderProgram = m_shaderPrograms.get(a_programHandle);
+  return shaderProgram ? shaderProgram->get() : nullptr;
 }
 
 ShaderProgram* Renderer::getShaderProgramByIndex(std::size_t a_programIndex) const
 {
-  return a_programIndex < m_shaderProgramHandles.size() ? getShaderProgram(m_shaderProgramHandles[a_programIndex]) : nullptr;
+  return a_programIndex < getShaderProgramCount() ? m_shaderPrograms.getByIndex(a_programIndex).get() : nullptr;
 }
 
 Status Renderer::compileShader(FlurrHandle a_programHandle, ShaderType a_shaderType, FlurrHandle a_shaderResourceHandle)
@@ -189,7 +369,12 @@ Status Renderer::compileShader(FlurrHandle a_programHandle, ShaderType a_shaderT
     return Status::kInvalidArgument;
   }
 
-  return shaderProgram->compileShader(a_shaderType, a_shaderResourceHandle);
+  // Load shader source, then let the backend compile it
+  auto result = shaderProgram->compileShader(a_shaderType, a_shaderResourceHandle);
+  if (result != Status::kSuccess)
+    return result;
+
+  return m_backend->compileShader(*shaderProgram, a_shaderType, a_shaderResourceHandle);
 }
 
 Status Renderer::linkShaderProgram(FlurrHandle a_programHandle)
@@ -208,7 +393,80 @@ Status Renderer::linkShaderProgram(FlurrHandle a_programHandle)
     return Status::kInvalidArgument;
   }
 
-  return shaderProgram->linkProgram();
+  if (ShaderProgramState::kCompiled != shaderProgram->getProgramState())
+  {
+    FLURR_LOG_ERROR("Shader program %u not in compiled state!", a_programHandle);
+    return Status::kInvalidState;
+  }
+
+  return m_backend->linkProgram(*shaderProgram, false);
+}
+
+Status Renderer::linkShaderProgramsAsync(const std::vector<FlurrHandle>& a_programHandles)
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("flurr renderer not initialized!");
+    return Status::kInvalidState;
+  }
+
+  // Submit all compiles and links up front, so the driver can work on them in parallel
+  Status result = Status::kSuccess;
+  for (auto programHandle : a_programHandles)
+  {
+    auto* shaderProgram = getShaderProgram(programHandle);
+    if (!shaderProgram)
+    {
+      FLURR_LOG_WARN("No ShaderProgram with handle %u!", programHandle);
+      result = Status::kInvalidArgument;
+      continue;
+    }
+
+    if (ShaderProgramState::kCompiled != shaderProgram->getProgramState())
+    {
+      FLURR_LOG_ERROR("Shader program %u not in compiled state!", programHandle);
+      result = Status::kInvalidState;
+      continue;
+    }
+
+    Status linkResult = m_backend->linkProgram(*shaderProgram, true);
+    if (Status::kSuccess != linkResult)
+      result = linkResult;
+  }
+
+  return result;
+}
+
+std::size_t Renderer::getPendingShaderProgramCount() const
+{
+  std::size_t pendingCount = 0;
+  for (const auto& shaderProgram : m_shaderPrograms)
+    if (ShaderProgramState::kLinking == shaderProgram->getProgramState())
+      ++pendingCount;
+
+  return pendingCount;
+}
+
+Status Renderer::waitForShaderPrograms()
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("flurr renderer not initialized!");
+    return Status::kInvalidState;
+  }
+
+  Status result = Status::kSuccess;
+  for (auto& shaderProgram : m_shaderPrograms)
+  {
+    if (ShaderProgramState::kLinking != shaderProgram->getProgramState())
+      continue;
+
+    Status linkResult = m_backend->finishLink(*shaderProgram);
+    if (Status::kSuccess != linkResult)
+      result = linkResult;
+  }
+
+  return result;
 }
 
 Status Renderer::useShaderProgram(FlurrHandle a_programHandle)
@@ -227,7 +485,7 @@ Status Renderer::useShaderProgram(FlurrHandle a_programHandle)
     return Status::kInvalidArgument;
   }
 
-  return shaderProgram->useProgram();
+  return m_backend->useProgram(*shaderProgram);
 }
 
 Status Renderer::createTexture(FlurrHandle& a_texHandle, FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode)
@@ -239,17 +497,47 @@ Status Renderer::createTexture(FlurrHandle& a_texHandle, FlurrHandle a_texResour
   }
 
   // Create Texture instance
-  a_texHandle = GenerateHandle(m_nextTextureHandle, [this](FlurrHandle a_h) { return hasTexture(a_h); });
-  m_textures.emplace(a_texHandle, std::make_unique<Texture>(a_texHandle));
-  m_textureHandles.push_back(a_texHandle);
+  a_texHandle = m_textures.insert(std::make_unique<Texture>(m_textures.getNextHandle()));
 
   // Initialize texture with data
-  auto result = getTexture(a_texHandle)->initTexture(a_texResourceHandle, a_texWrapMode, a_texMinFilterMode, a_texMagFilterMode);
+  auto* texture = getTexture(a_texHandle);
+  auto result = texture->checkTextureResource(a_texResourceHandle);
+  if (result == Status::kSuccess)
+    result = m_backend->initTexture(*texture, a_texResourceHandle, a_texWrapMode, a_texMinFilterMode, a_texMagFilterMode, false);
   if (result != Status::kSuccess)
   {
     // Failed to create the texture, clean up
+    m_backend->destroyTexture(*texture);
+    m_textures.erase(a_texHandle);
+    a_texHandle = INVALID_HANDLE;
+  }
+
+  return result;
+}
+
+Status Renderer::createTextureAsync(FlurrHandle& a_texHandle, FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode)
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("flurr renderer not initialized!");
+    return Status::kNotInitialized;
+  }
+
+  // Create Texture instance
+  a_texHandle = m_textures.insert(std::make_unique<Texture>(m_textures.getNextHandle()));
+
+  // Allocate texture storage and queue data upload
+  auto* texture = getTexture(a_texHandle);
+  auto result = texture->checkTextureResource(a_texResourceHandle);
+  if (result == Status::kSuccess)
+    result = m_backend->initTexture(*texture, a_texResourceHandle, a_texWrapMode, a_texMinFilterMode, a_texMagFilterMode, true);
+  if (result == Status::kSuccess && texture->isUploadPending())
+    result = m_textureUploader.queueUpload(a_texHandle, a_texResourceHandle, texture->getDataSize());
+  if (result != Status::kSuccess)
+  {
+    // Failed to create the texture, clean up
+    m_backend->destroyTexture(*texture);
     m_textures.erase(a_texHandle);
-    m_textureHandles.pop_back();
     a_texHandle = INVALID_HANDLE;
   }
 
@@ -272,27 +560,26 @@ void Renderer::destroyTexture(FlurrHandle a_texHandle)
     return;
   }
 
-  // Destroy vertex buffer
-  if (INVALID_HANDLE != texture->getResourceHandle())
-    texture->destroyTexture();
+  // Destroy texture
+  m_textureUploader.cancelUpload(a_texHandle);
+  m_backend->destroyTexture(*texture);
   m_textures.erase(a_texHandle);
-  m_textureHandles.erase(std::remove(m_textureHandles.begin(), m_textureHandles.end(), a_texHandle), m_textureHandles.end());
 }
 
 bool Renderer::hasTexture(FlurrHandle a_texHandle) const
 {
-  return m_textures.find(a_texHandle) != m_textures.end();
+  return m_textures.contains(a_texHandle);
 }
 
 Texture* Renderer::getTexture(FlurrHandle a_texHandle) const
 {
-  auto&& texIt = m_textures.find(a_texHandle);
-  return m_textures.end() == texIt ? nullptr : texIt->second.get();
+  const auto* texture = m_textures.get(a_texHandle);
+  return texture ? texture->get() : nullptr;
 }
 
 Texture* Renderer::getTextureByIndex(std::size_t a_texIndex) const
 {
-  return a_texIndex < getTextureCount() ? getTexture(m_textureHandles[a_texIndex]) : nullptr;
+  return a_texIndex < getTextureCount() ? m_textures.getByIndex(a_texIndex).get() : nullptr;
 }
 
 Status Renderer::useTexture(FlurrHandle a_texHandle, TextureUnitIndex a_texUnit)
@@ -312,7 +599,81 @@ Status Renderer::useTexture(FlurrHandle a_texHandle, TextureUnitIndex a_texUnit)
   }
 
   // Use as current texture
-  return texture->useTexture(a_texUnit);
+  return m_backend->useTexture(*texture, a_texUnit);
+}
+
+Status Renderer::createTextureInArray(FlurrHandle& a_texHandle, FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode)
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("flurr renderer not initialized!");
+    return Status::kNotInitialized;
+  }
+
+  // Create Texture instance
+  a_texHandle = m_textures.insert(std::make_unique<Texture>(m_textures.getNextHandle()));
+
+  // Initialize texture in a layer of a matching texture array
+  auto* texture = getTexture(a_texHandle);
+  auto result = texture->checkTextureResource(a_texResourceHandle);
+  if (result == Status::kSuccess)
+    result = m_backend->initTextureInArray(*texture, a_texResourceHandle, a_texWrapMode, a_texMinFilterMode, a_texMagFilterMode);
+  if (result != Status::kSuccess)
+  {
+    // Failed to create the texture, clean up
+    m_backend->destroyTexture(*texture);
+    m_textures.erase(a_texHandle);
+    a_texHandle = INVALID_HANDLE;
+  }
+
+  return result;
+}
+
+bool Renderer::hasTextureArray(FlurrHandle a_arrayHandle) const
+{
+  return m_textureArrays.contains(a_arrayHandle);
+}
+
+TextureArray* Renderer::getTextureArray(FlurrHandle a_arrayHandle) const
+{
+  const auto* textureArray = m_textureArrays.get(a_arrayHandle);
+  return textureArray ? textureArray->get() : nullptr;
+}
+
+TextureArray* Renderer::getTextureArrayByIndex(std::size_t a_arrayIndex) const
+{
+  return a_arrayIndex < getTextureArrayCount() ? m_textureArrays.getByIndex(a_arrayIndex).get() : nullptr;
+}
+
+Status Renderer::allocateTextureArrayLayer(uint32_t a_width, uint32_t a_height, TextureFormat a_texFormat, uint32_t a_mipLevelCount,
+  TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode,
+  FlurrHandle& a_arrayHandle, uint32_t& a_layer)
+{
+  // Use a free layer of an existing array if there is one
+  for (auto&& textureArray : m_textureArrays)
+  {
+    if (textureArray->hasFreeLayer() && textureArray->isCompatible(a_width, a_height, a_texFormat, a_mipLevelCount, a_texWrapMode, a_texMinFilterMode, a_texMagFilterMode))
+    {
+      a_arrayHandle = textureArray->getArrayHandle();
+      return textureArray->allocateLayer(a_layer);
+    }
+  }
+
+  // Otherwise create a new array
+  a_arrayHandle = m_textureArrays.insert(std::make_unique<TextureArray>(m_textureArrays.getNextHandle()));
+  auto* textureArray = getTextureArray(a_arrayHandle);
+  auto result = m_backend->initTextureArray(*textureArray, a_width, a_height, a_texFormat, a_mipLevelCount, TextureArray::kDefaultLayerCapacity,
+    a_texWrapMode, a_texMinFilterMode, a_texMagFilterMode);
+  if (result != Status::kSuccess)
+  {
+    // Failed to create the array, clean up
+    m_backend->destroyTextureArray(*textureArray);
+    m_textureArrays.erase(a_arrayHandle);
+    a_arrayHandle = INVALID_HANDLE;
+    return result;
+  }
+
+  return textureArray->allocateLayer(a_layer);
 }
 
 Status Renderer::createVertexBuffer(FlurrHandle& a_bufferHandle, VertexBufferType a_bufferType, std::size_t a_dataSize, void* a_data, std::size_t a_attributeSize, VertexDataUsage a_dataUsage)
@@ -324,22 +685,24 @@ Status Renderer::createVertexBuffer(FlurrHandle& a_bufferHandle, VertexBufferTyp
   }
 
   // Create VertexBuffer instance
-  a_bufferHandle = GenerateHandle(m_nextVertexBufferHandle, [this](FlurrHandle a_h) { return hasVertexBuffer(a_h); });
-  m_vertexBuffers.emplace(a_bufferHandle, std::make_unique<VertexBuffer>(a_bufferHandle));
-  m_vertexBufferHandles.push_back(a_bufferHandle);
+  a_bufferHandle = m_vertexBuffers.insert(std::make_unique<VertexBuffer>(m_vertexBuffers.getNextHandle()));
 
   // Initialize vertex buffer with data
-  auto result = getVertexBuffer(a_bufferHandle)->initBuffer(a_bufferType, a_dataSize, a_data, a_attributeSize, a_dataUsage);
+  auto* vertexBuffer = getVertexBuffer(a_bufferHandle);
+  auto result = vertexBuffer->setBufferProperties(a_bufferType, a_dataSize, a_data, a_attributeSize, a_dataUsage);
+  if (result == Status::kSuccess)
+    result = m_backend->initVertexBuffer(*vertexBuffer, a_data);
   if (result != Status::kSuccess)
   {
     // Failed to create vertex buffer, clean up
     m_vertexBuffers.erase(a_bufferHandle);
-    m_indexedGeometryHandles.pop_back();
-    a_bufferHandle = INVALID_HANDLE;    
+    a_bufferHandle = INVALID_HANDLE;
   }
+
+  return result;
 }
 
-Status Renderer::createIndexBuffer(FlurrHandle& a_bufferHandle, std::size_t a_dataSize, void* a_data, VertexDataUsage a_dataUsage)
+Status Renderer::createIndexBuffer(FlurrHandle& a_bufferHandle, std::size_t a_dataSize, void* a_data, VertexDataUsage a_dataUsage, IndexType a_indexType)
 {
   if (!isInitialized())
   {
@@ -348,12 +711,21 @@ Status Renderer::createIndexBuffer(FlurrHandle& a_bufferHandle, std::size_t a_da
   }
 
   // Create VertexBuffer instance
-  a_bufferHandle = GenerateHandle(m_nextVertexBufferHandle, [this](FlurrHandle a_h) { return hasVertexBuffer(a_h); });
-  m_vertexBuffers.emplace(a_bufferHandle, std::make_unique<VertexBuffer>(a_bufferHandle));
-  m_vertexBufferHandles.push_back(a_bufferHandle);
+  a_bufferHandle = m_vertexBuffers.insert(std::make_unique<VertexBuffer>(m_vertexBuffers.getNextHandle()));
 
   // Initialize index buffer with data
-  return getVertexBuffer(a_bufferHandle)->initIndexBuffer(a_dataSize, a_data, a_dataUsage);
+  auto* indexBuffer = getVertexBuffer(a_bufferHandle);
+  auto result = indexBuffer->setIndexBufferProperties(a_dataSize, a_data, a_dataUsage, a_indexType);
+  if (result == Status::kSuccess)
+    result = m_backend->initVertexBuffer(*indexBuffer, a_data);
+  if (result != Status::kSuccess)
+  {
+    // Failed to create index buffer, clean up
+    m_vertexBuffers.erase(a_bufferHandle);
+    a_bufferHandle = INVALID_HANDLE;
+  }
+
+  return result;
 }
 
 void Renderer::destroyVertexBuffer(FlurrHandle a_bufferHandle)
@@ -373,26 +745,24 @@ void Renderer::destroyVertexBuffer(FlurrHandle a_bufferHandle)
   }
 
   // Destroy vertex buffer
-  if (vertexBuffer->isCreated())
-    vertexBuffer->destroyBuffer();
+  m_backend->destroyVertexBuffer(*vertexBuffer);
   m_vertexBuffers.erase(a_bufferHandle);
-  m_vertexBufferHandles.erase(std::remove(m_vertexBufferHandles.begin(), m_vertexBufferHandles.end(), a_bufferHandle), m_vertexBufferHandles.end());
 }
 
 bool Renderer::hasVertexBuffer(FlurrHandle a_bufferHandle) const
 {
-  return m_vertexBuffers.find(a_bufferHandle) != m_vertexBuffers.end();
+  return m_vertexBuffers.contains(a_bufferHandle);
 }
 
 VertexBuffer* Renderer::getVertexBuffer(FlurrHandle a_bufferHandle) const
 {
-  auto&& bufferIt = m_vertexBuffers.find(a_bufferHandle);
-  return m_vertexBuffers.end() == bufferIt ? nullptr : bufferIt->second.get();
+  const auto* vertexBuffer = m_vertexBuffers.get(a_bufferHandle);
+  return vertexBuffer ? vertexBuffer->get() : nullptr;
 }
 
 VertexBuffer* Renderer::getVertexBufferByIndex(std::size_t a_bufferIndex) const
 {
-  return a_bufferIndex < getVertexBufferCount() ? getVertexBuffer(m_vertexBufferHandles[a_bufferIndex]) : nullptr;
+  return a_bufferIndex < getVertexBufferCount() ? m_vertexBuffers.getByIndex(a_bufferIndex).get() : nullptr;
 }
 
 Status Renderer::useVertexBuffer(FlurrHandle a_bufferHandle)
@@ -412,7 +782,94 @@ Status Renderer::useVertexBuffer(FlurrHandle a_bufferHandle)
   }
 
   // Use as current vertex buffer
-  return vertexBuffer->useBuffer();
+  return m_backend->useVertexBuffer(*vertexBuffer);
+}
+
+Status Renderer::updateVertexBuffer(FlurrHandle a_bufferHandle, const void* a_data, std::size_t a_dataSize, std::size_t& a_offset)
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("flurr renderer not initialized!");
+    return Status::kInvalidState;
+  }
+
+  // Get VertexBuffer object
+  auto* vertexBuffer = getVertexBuffer(a_bufferHandle);
+  if (!vertexBuffer)
+  {
+    FLURR_LOG_WARN("No VertexBuffer with handle %u!", a_bufferHandle);
+    return Status::kInvalidArgument;
+  }
+
+  if (nullptr == a_data)
+  {
+    FLURR_LOG_ERROR("data cannot be null!");
+    return Status::kNullArgument;
+  }
+
+  // Static and dynamic buffers are updated in place
+  if (VertexDataUsage::kStream != vertexBuffer->getDataUsage())
+  {
+    Status result = vertexBuffer->prepareUpdate(a_data, a_dataSize, a_offset);
+    if (Status::kSuccess != result)
+      return result;
+
+    return m_backend->updateVertexBuffer(*vertexBuffer, a_data, a_dataSize, a_offset);
+  }
+
+  // Stream buffers append data to the ring
+  void* writePtr = nullptr;
+  Status result = m_backend->mapTransient(*vertexBuffer, a_dataSize, &writePtr, a_offset);
+  if (Status::kSuccess != result)
+    return result;
+  std::memcpy(writePtr, a_data, a_dataSize);
+  return m_backend->unmapTransient(*vertexBuffer);
+}
+
+Status Renderer::allocateTransient(FlurrHandle a_bufferHandle, std::size_t a_dataSize, void** a_writePtr, std::size_t& a_offset)
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("flurr renderer not initialized!");
+    return Status::kInvalidState;
+  }
+
+  if (nullptr == a_writePtr)
+  {
+    FLURR_LOG_ERROR("writePtr cannot be null!");
+    return Status::kNullArgument;
+  }
+
+  // Get VertexBuffer object
+  auto* vertexBuffer = getVertexBuffer(a_bufferHandle);
+  if (!vertexBuffer)
+  {
+    FLURR_LOG_WARN("No VertexBuffer with handle %u!", a_bufferHandle);
+    return Status::kInvalidArgument;
+  }
+
+  // Map range of stream ring buffer
+  return m_backend->mapTransient(*vertexBuffer, a_dataSize, a_writePtr, a_offset);
+}
+
+Status Renderer::commitTransient(FlurrHandle a_bufferHandle)
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("flurr renderer not initialized!");
+    return Status::kInvalidState;
+  }
+
+  // Get VertexBuffer object
+  auto* vertexBuffer = getVertexBuffer(a_bufferHandle);
+  if (!vertexBuffer)
+  {
+    FLURR_LOG_WARN("No VertexBuffer with handle %u!", a_bufferHandle);
+    return Status::kInvalidArgument;
+  }
+
+  // Unmap stream ring buffer
+  return m_backend->unmapTransient(*vertexBuffer);
 }
 
 Status Renderer::createIndexedGeometry(FlurrHandle& a_geometryHandle, const std::vector<FlurrHandle>& a_attributeBufferHandles, FlurrHandle a_indexBufferHandle)
@@ -424,24 +881,88 @@ Status Renderer::createIndexedGeometry(FlurrHandle& a_geometryHandle, const std:
   }
 
   // Create IndexedGeometry instance
-  a_geometryHandle = GenerateHandle(m_nextIndexedGeometryHandle, [this](FlurrHandle a_h) { return hasIndexedGeometry(a_h); });
-  m_indexedGeometries.emplace(a_geometryHandle, std::make_unique<IndexedGeometry>(a_geometryHandle));
-  m_indexedGeometryHandles.push_back(a_geometryHandle);
+  a_geometryHandle = m_indexedGeometries.insert(std::make_unique<IndexedGeometry>(m_indexedGeometries.getNextHandle()));
 
   // Initialize indexed geometry with vertex and index buffers
   auto* geometry = getIndexedGeometry(a_geometryHandle);
-  auto result = geometry->initGeometry(a_attributeBufferHandles, a_indexBufferHandle);
+  auto result = setGeometryBuffers(*geometry, a_attributeBufferHandles, a_indexBufferHandle, nullptr);
+  if (result == Status::kSuccess)
+    result = m_backend->initGeometry(*geometry);
+  if (result != Status::kSuccess)
+  {
+    // Failed to create the indexed geometry, clean up
+    m_indexedGeometries.erase(a_geometryHandle);
+    a_geometryHandle = INVALID_HANDLE;
+  }
+
+  return result;
+}
+
+Status Renderer::createIndexedGeometry(FlurrHandle& a_geometryHandle, const std::vector<FlurrHandle>& a_attributeBufferHandles, FlurrHandle a_indexBufferHandle, const VertexLayout& a_vertexLayout)
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("flurr renderer not initialized!");
+    return Status::kNotInitialized;
+  }
+
+  // Create IndexedGeometry instance
+  a_geometryHandle = m_indexedGeometries.insert(std::make_unique<IndexedGeometry>(m_indexedGeometries.getNextHandle()));
+
+  // Initialize indexed geometry with vertex and index buffers laid out as specified
+  auto* geometry = getIndexedGeometry(a_geometryHandle);
+  auto result = setGeometryBuffers(*geometry, a_attributeBufferHandles, a_indexBufferHandle, &a_vertexLayout);
+  if (result == Status::kSuccess)
+    result = m_backend->initGeometry(*geometry);
   if (result != Status::kSuccess)
   {
     // Failed to create the indexed geometry, clean up
     m_indexedGeometries.erase(a_geometryHandle);
-    m_indexedGeometryHandles.pop_back();
     a_geometryHandle = INVALID_HANDLE;
   }
 
   return result;
 }
 
+Status Renderer::setGeometryBuffers(IndexedGeometry& a_geometry, const std::vector<FlurrHandle>& a_attributeBufferHandles, FlurrHandle a_indexBufferHandle, const VertexLayout* a_vertexLayout)
+{
+  // Get vertex attribute buffers
+  std::vector<const VertexBuffer*> attributeBuffers;
+  for (auto attributeBufferHandle : a_attributeBufferHandles)
+  {
+    const auto* buffer = getVertexBuffer(attributeBufferHandle);
+    if (!buffer)
+    {
+      FLURR_LOG_ERROR("Unable to add vertex attribute buffer; no buffer with handle %u!", attributeBufferHandle);
+      return Status::kInvalidHandle;
+    }
+
+    if (buffer->getBufferType() != VertexBufferType::kVertexAttribute)
+    {
+      FLURR_LOG_ERROR("Unable to add vertex attribute buffer; wrong buffer type!");
+      return Status::kUnsupportedType;
+    }
+
+    attributeBuffers.push_back(buffer);
+  }
+
+  // Get index buffer
+  const auto* indexBuffer = getVertexBuffer(a_indexBufferHandle);
+  if (!indexBuffer)
+  {
+    FLURR_LOG_ERROR("Unable to set index buffer; no buffer with handle %u!", a_indexBufferHandle);
+    return Status::kInvalidHandle;
+  }
+
+  if (indexBuffer->getBufferType() != VertexBufferType::kIndex)
+  {
+    FLURR_LOG_ERROR("Unable to set index buffer; wrong buffer type!");
+    return Status::kUnsupportedType;
+  }
+
+  return a_geometry.setBuffers(a_attributeBufferHandles, attributeBuffers, a_indexBufferHandle, *indexBuffer, a_vertexLayout);
+}
+
 void Renderer::destroyIndexedGeometry(FlurrHandle a_geometryHandle)
 {
   if (!isInitialized())
@@ -459,27 +980,24 @@ void Renderer::destroyIndexedGeometry(FlurrHandle a_geometryHandle)
   }
 
   // Destroy indexed geometry
-  if (geometry->isGeometryInitialized())
-    geometry->destroyGeometry();
+  m_backend->destroyGeometry(*geometry);
   m_indexedGeometries.erase(a_geometryHandle);
-  m_indexedGeometryHandles.erase(std::remove(m_indexedGeometryHandles.begin(), m_indexedGeometryHandles.end(), a_geometryHandle), m_indexedGeometryHandles.end());
 }
 
 bool Renderer::hasIndexedGeometry(FlurrHandle a_geometryHandle) const
 {
-  return m_indexedGeometries.find(a_geometryHandle) != m_indexedGeometries.end();
+  return m_indexedGeometries.contains(a_geometryHandle);
 }
 
 IndexedGeometry* Renderer::getIndexedGeometry(FlurrHandle a_geometryHandle) const
 {
-  auto&& arrayIt = m_indexedGeometries.find(a_geometryHandle);
-  return m_indexedGeometries.end() == arrayIt ?
-    nullptr : arrayIt->second.get();
+  const auto* geometry = m_indexedGeometries.get(a_geometryHandle);
+  return geometry ? geometry->get() : nullptr;
 }
 
 IndexedGeometry* Renderer::getIndexedGeometryByIndex(std::size_t a_geometryIndex) const
 {
-  return a_geometryIndex < getIndexedGeometryCount() ? getIndexedGeometry(m_indexedGeometryHandles[a_geometryIndex]) : nullptr;
+  return a_geometryIndex < getIndexedGeometryCount() ? m_indexedGeometries.getByIndex(a_geometryIndex).get() : nullptr;
 }
 
 Status Renderer::drawIndexedGeometry(FlurrHandle a_geometryHandle)
@@ -499,7 +1017,406 @@ Status Renderer::drawIndexedGeometry(FlurrHandle a_geometryHandle)
   }
 
   // Draw indexed geometry
-  return geometry->drawGeometry();
+  return m_backend->drawGeometry(*geometry);
+}
+
+Status Renderer::drawIndexedGeometryInstanced(FlurrHandle a_geometryHandle, FlurrHandle a_instanceBufferHandle, uint32_t a_instanceCount)
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("flurr renderer not initialized!");
+    return Status::kInvalidState;
+  }
+
+  // Get IndexedGeometry object
+  auto* geometry = getIndexedGeometry(a_geometryHandle);
+  if (!geometry)
+  {
+    FLURR_LOG_WARN("No IndexedGeometry with handle %u!", a_geometryHandle);
+    return Status::kInvalidArgument;
+  }
+
+  // Get instance buffer, which must hold InstanceData (possibly without trailing members)
+  const auto* instanceBuffer = getVertexBuffer(a_instanceBufferHandle);
+  if (!instanceBuffer)
+  {
+    FLURR_LOG_ERROR("Unable to draw indexed geometry instances; no instance buffer with handle %u!", a_instanceBufferHandle);
+    return Status::kInvalidHandle;
+  }
+
+  if (instanceBuffer->getBufferType() != VertexBufferType::kInstanceAttribute)
+  {
+    FLURR_LOG_ERROR("Unable to draw indexed geometry instances; wrong buffer type!");
+    return Status::kUnsupportedType;
+  }
+
+  const std::size_t stride = instanceBuffer->getAttributeSize();
+  if (stride != sizeof(glm::mat4) && stride != offsetof(InstanceData, params) && stride != sizeof(InstanceData))
+  {
+    FLURR_LOG_ERROR("Unable to draw indexed geometry instances; unsupported instance data size %u!", static_cast<uint32_t>(stride));
+    return Status::kInvalidArgument;
+  }
+
+  // Draw all instances in the buffer unless fewer are requested
+  const std::size_t maxInstanceCount = instanceBuffer->getDataSize() / stride;
+  if (0 == a_instanceCount || a_instanceCount > maxInstanceCount)
+    a_instanceCount = static_cast<uint32_t>(maxInstanceCount);
+
+  // Draw instances of indexed geometry
+  return m_backend->drawGeometryInstanced(*geometry, a_instanceBufferHandle, a_instanceCount);
+}
+
+Status Renderer::createGeometryArena(FlurrHandle& a_arenaHandle, const VertexLayout& a_vertexLayout, std::size_t a_vertexCapacity, std::size_t a_indexCapacity, IndexType a_indexType)
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("flurr renderer not initialized!");
+    return Status::kNotInitialized;
+  }
+
+  // Create GeometryArena instance
+  a_arenaHandle = m_geometryArenas.insert(std::make_unique<GeometryArena>(m_geometryArenas.getNextHandle(), m_backend.get()));
+
+  // Initialize geometry arena buffers with the specified layout and capacities
+  auto* arena = getGeometryArena(a_arenaHandle);
+  auto result = arena->setArenaProperties(a_vertexLayout, a_vertexCapacity, a_indexCapacity, a_indexType);
+  if (result == Status::kSuccess)
+    result = m_backend->initArena(*arena);
+  if (result != Status::kSuccess)
+  {
+    // Failed to create the geometry arena, clean up
+    m_geometryArenas.erase(a_arenaHandle);
+    a_arenaHandle = INVALID_HANDLE;
+  }
+
+  return result;
+}
+
+void Renderer::destroyGeometryArena(FlurrHandle a_arenaHandle)
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("flurr renderer not initialized!");
+    return;
+  }
+
+  // Get GeometryArena object
+  auto* arena = getGeometryArena(a_arenaHandle);
+  if (!arena)
+  {
+    FLURR_LOG_WARN("No GeometryArena with handle %u!", a_arenaHandle);
+    return;
+  }
+
+  // Destroy geometry arena
+  m_backend->destroyArena(*arena);
+  m_geometryArenas.erase(a_arenaHandle);
+}
+
+bool Renderer::hasGeometryArena(FlurrHandle a_arenaHandle) const
+{
+  return m_geometryArenas.contains(a_arenaHandle);
+}
+
+GeometryArena* Renderer::getGeometryArena(FlurrHandle a_arenaHandle) const
+{
+  const auto* arena = m_geometryArenas.get(a_arenaHandle);
+  return arena ? arena->get() : nullptr;
+}
+
+GeometryArena* Renderer::getGeometryArenaByIndex(std::size_t a_arenaIndex) const
+{
+  return a_arenaIndex < getGeometryArenaCount() ? m_geometryArenas.getByIndex(a_arenaIndex).get() : nullptr;
+}
+
+Status Renderer::createRenderTarget(FlurrHandle& a_targetHandle, uint32_t a_width, uint32_t a_height, RenderTargetFormat a_colorFormat, bool a_hasDepth, uint32_t a_sampleCount)
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("flurr renderer not initialized!");
+    return Status::kNotInitialized;
+  }
+
+  // Create RenderTarget instance
+  a_targetHandle = m_renderTargets.insert(std::make_unique<RenderTarget>(m_renderTargets.getNextHandle()));
+
+  // Initialize render target framebuffer
+  auto* renderTarget = getRenderTarget(a_targetHandle);
+  auto result = m_backend->initRenderTarget(*renderTarget, a_width, a_height, a_colorFormat, a_hasDepth, a_sampleCount);
+  if (result != Status::kSuccess)
+  {
+    // Failed to create the render target, clean up
+    m_backend->destroyRenderTarget(*renderTarget);
+    m_renderTargets.erase(a_targetHandle);
+    a_targetHandle = INVALID_HANDLE;
+  }
+
+  return result;
+}
+
+void Renderer::destroyRenderTarget(FlurrHandle a_targetHandle)
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("flurr renderer not initialized!");
+    return;
+  }
+
+  // Get RenderTarget object
+  auto* renderTarget = getRenderTarget(a_targetHandle);
+  if (!renderTarget)
+  {
+    FLURR_LOG_WARN("No RenderTarget with handle %u!", a_targetHandle);
+    return;
+  }
+
+  // Fall back to the default framebuffer if the target is in use
+  if (m_renderTargetHandle == a_targetHandle)
+    m_renderTargetHandle = INVALID_HANDLE;
+  if (m_offscreenTargetHandle == a_targetHandle)
+    m_offscreenTargetHandle = INVALID_HANDLE;
+
+  // Destroy render target
+  m_backend->destroyRenderTarget(*renderTarget);
+  m_renderTargets.erase(a_targetHandle);
+}
+
+bool Renderer::hasRenderTarget(FlurrHandle a_targetHandle) const
+{
+  return m_renderTargets.contains(a_targetHandle);
+}
+
+RenderTarget* Renderer::getRenderTarget(FlurrHandle a_targetHandle) const
+{
+  const auto* renderTarget = m_renderTargets.get(a_targetHandle);
+  return renderTarget ? renderTarget->get() : nullptr;
+}
+
+RenderTarget* Renderer::getRenderTargetByIndex(std::size_t a_targetIndex) const
+{
+  return a_targetIndex < getRenderTargetCount() ? m_renderTargets.getByIndex(a_targetIndex).get() : nullptr;
+}
+
+Status Renderer::setRenderTarget(FlurrHandle a_targetHandle)
+{
+  if (INVALID_HANDLE != a_targetHandle && !hasRenderTarget(a_targetHandle))
+  {
+    FLURR_LOG_ERROR("No RenderTarget with handle %u!", a_targetHandle);
+    return Status::kInvalidHandle;
+  }
+
+  m_renderTargetHandle = a_targetHandle;
+  return Status::kSuccess;
+}
+
+Status Renderer::readPixelsAsync(PixelReadbackCallback a_callback, FlurrHandle a_targetHandle)
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("flurr renderer not initialized!");
+    return Status::kNotInitialized;
+  }
+
+  if (INVALID_HANDLE != a_targetHandle && !hasRenderTarget(a_targetHandle))
+  {
+    FLURR_LOG_ERROR("No RenderTarget with handle %u!", a_targetHandle);
+    return Status::kInvalidHandle;
+  }
+
+  return m_pixelReadback.queueReadback(a_targetHandle, std::move(a_callback));
+}
+
+Status Renderer::submitDraw(FlurrHandle a_programHandle, FlurrHandle a_geometryHandle, const glm::mat4& a_modelTransf, FlurrHandle a_texHandle, float a_viewDepth,
+  const glm::vec4& a_drawParams)
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("flurr renderer not initialized!");
+    return Status::kInvalidState;
+  }
+
+  if (!hasShaderProgram(a_programHandle))
+  {
+    FLURR_LOG_WARN("No ShaderProgram with handle %u!", a_programHandle);
+    return Status::kInvalidArgument;
+  }
+
+  if (!hasIndexedGeometry(a_geometryHandle))
+  {
+    FLURR_LOG_WARN("No IndexedGeometry with handle %u!", a_geometryHandle);
+    return Status::kInvalidArgument;
+  }
+
+  if (INVALID_HANDLE != a_texHandle && !hasTexture(a_texHandle))
+  {
+    FLURR_LOG_WARN("No Texture with handle %u!", a_texHandle);
+    return Status::kInvalidArgument;
+  }
+
+  // Queue the draw; it is executed on the next renderer update
+  // Layers of one texture array are batched together
+  const FlurrHandle texArrayHandle = INVALID_HANDLE != a_texHandle ? getTexture(a_texHandle)->getTextureArrayHandle() : INVALID_HANDLE;
+  m_renderQueue.addCommand(a_programHandle, a_texHandle, a_geometryHandle, a_modelTransf, a_viewDepth, texArrayHandle, a_drawParams);
+
+  return Status::kSuccess;
+}
+
+Status Renderer::submitCommandList(const RenderCommandList& a_commandList)
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("flurr renderer not initialized!");
+    return Status::kInvalidState;
+  }
+
+  // Merge recorded draws into the render queue; invalid draws are skipped, the rest are still queued
+  Status result = Status::kSuccess;
+  for (const auto& draw : a_commandList.getDraws())
+  {
+    const Status drawResult = submitDraw(draw.programHandle, draw.geometryHandle, draw.modelTransf, draw.texHandle, draw.viewDepth, draw.drawParams);
+    if (Status::kSuccess != drawResult)
+      result = drawResult;
+  }
+
+  return result;
+}
+
+Status Renderer::submitFramePacket(const FramePacket& a_framePacket)
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("flurr renderer not initialized!");
+    return Status::kInvalidState;
+  }
+
+  // Apply buffer updates before any draws read from the buffers
+  for (std::size_t updateIndex = 0; updateIndex < a_framePacket.getBufferUpdateCount(); ++updateIndex)
+  {
+    const auto& update = a_framePacket.getBufferUpdate(updateIndex);
+    std::size_t offset = update.offset;
+    const Status result = updateVertexBuffer(update.bufferHandle, a_framePacket.getBufferUpdateData(update), update.dataSize, offset);
+    if (Status::kSuccess != result)
+    {
+      FLURR_LOG_ERROR("Failed to apply frame packet update to buffer %u!", update.bufferHandle);
+      return result;
+    }
+  }
+
+  // Camera data
+  if (a_framePacket.hasFrameUniforms())
+    setFrameUniforms(a_framePacket.getFrameUniforms());
+  if (a_framePacket.hasViewport())
+  {
+    const auto& viewport = a_framePacket.getViewport();
+    setViewport(viewport.x, viewport.y, static_cast<uint32_t>(viewport.z), static_cast<uint32_t>(viewport.w));
+  }
+
+  return submitCommandList(a_framePacket.getCommandList());
+}
+
+void Renderer::updatePendingShaderPrograms()
+{
+  // Finish only links the driver reports as complete, so the render loop never stalls
+  for (auto& shaderProgram : m_shaderPrograms)
+  {
+    if (ShaderProgramState::kLinking != shaderProgram->getProgramState() || !m_backend->isLinkComplete(*shaderProgram))
+      continue;
+
+    if (Status::kSuccess != m_backend->finishLink(*shaderProgram))
+      FLURR_LOG_ERROR("Failed to link shader program %u!", shaderProgram->getProgramHandle());
+  }
+}
+
+void Renderer::flushRenderQueue()
+{
+  // Sort render commands to minimize state changes
+  m_renderQueue.sort();
+
+  // Submit render commands
+  ShaderProgram* program = nullptr;
+  UniformHandle modelTransfUniform = INVALID_UNIFORM_HANDLE;
+  UniformHandle texLayerUniform = INVALID_UNIFORM_HANDLE;
+  UniformHandle drawParamsUniform = INVALID_UNIFORM_HANDLE;
+  FlurrHandle currentProgramHandle = INVALID_HANDLE;
+  FlurrHandle currentTexHandle = INVALID_HANDLE;
+  for (std::size_t commandIndex = 0; commandIndex < m_renderQueue.getCommandCount(); ++commandIndex)
+  {
+    const auto& command = m_renderQueue.getSortedCommand(commandIndex);
+
+    // Switch shader program
+    if (command.programHandle != currentProgramHandle)
+    {
+      currentProgramHandle = command.programHandle;
+      program = getShaderProgram(currentProgramHandle);
+      if (program && ShaderProgramState::kLinking == program->getProgramState())
+      {
+        // Program still linking, skip its draws until it is ready
+        program = nullptr;
+        continue;
+      }
+      if (!program || Status::kSuccess != m_backend->useProgram(*program))
+      {
+        FLURR_LOG_WARN("Skipping render commands for invalid shader program %u!", currentProgramHandle);
+        program = nullptr;
+        continue;
+      }
+      modelTransfUniform = program->getUniformHandle(MODEL_TRANSFORM_UNIFORM_NAME);
+      texLayerUniform = program->getUniformHandle(TEXTURE_LAYER_UNIFORM_NAME);
+      drawParamsUniform = program->getUniformHandle(DRAW_PARAMS_UNIFORM_NAME);
+      currentTexHandle = INVALID_HANDLE; // layer uniform is per program
+    }
+    if (!program)
+      continue;
+
+    // Switch texture
+    if (INVALID_HANDLE != command.textureHandle && command.textureHandle != currentTexHandle)
+    {
+      auto* texture = getTexture(command.textureHandle);
+      if (texture && texture->isUploadPending())
+        continue; // still uploading, skip the draw until it is ready
+      if (!texture || Status::kSuccess != m_backend->useTexture(*texture, 0))
+      {
+        FLURR_LOG_WARN("Skipping render command with invalid texture %u!", command.textureHandle);
+        continue;
+      }
+      currentTexHandle = command.textureHandle;
+
+      // Layers of the bound array need no rebind, just a layer switch
+      if (texture->isArrayLayer())
+        m_backend->setIntUniform(*program, texLayerUniform, static_cast<int>(texture->getArrayLayer()));
+    }
+
+    // Draw geometry
+    auto* geometry = getIndexedGeometry(command.geometryHandle);
+    if (!geometry)
+    {
+      FLURR_LOG_WARN("Skipping render command with invalid geometry %u!", command.geometryHandle);
+      continue;
+    }
+    m_backend->setMat4Uniform(*program, modelTransfUniform, command.modelTransf);
+    if (INVALID_UNIFORM_HANDLE != drawParamsUniform)
+      m_backend->setVec4Uniform(*program, drawParamsUniform, command.drawParams);
+    m_backend->drawGeometry(*geometry);
+  }
+
+  m_renderQueue.clear();
+}
+
+void Renderer::fenceStreamBuffers()
+{
+  for (auto& vertexBuffer : m_vertexBuffers)
+  {
+    if (VertexDataUsage::kStream != vertexBuffer->getDataUsage())
+      continue;
+
+    // Transient data must be committed before the GPU can read it
+    if (vertexBuffer->isMapped())
+    {
+      FLURR_LOG_WARN("Transient data in VertexBuffer %u not committed by end of frame!", vertexBuffer->getBufferHandle());
+      m_backend->unmapTransient(*vertexBuffer);
+    }
+    m_backend->fenceTransients(*vertexBuffer);
+  }
 }
 
 } // namespace flurr
@@ -0,0 +1,141 @@
+#include "flurr/renderer/SamplerCache.h"
+#include "flurr/FlurrCore.h"
+#include "flurr/FlurrLog.h"
+#include "flurr/utils/StringUtils.h"
+#include "flurr/utils/TypeCasts.h"
+
+#include <algorithm>
+
+namespace flurr
+{
+
+SamplerCache::SamplerCache()
+  : m_filteringQuality(TextureFilteringQuality::kTrilinear),
+  m_anisotropyLevel(1),
+  m_maxAnisotropyLevel(1)
+{
+}
+
+void SamplerCache::init(TextureFilteringQuality a_filteringQuality, uint32_t a_anisotropyLevel)
+{
+  // Determine supported anisotropy
+  m_maxAnisotropyLevel = 1;
+  if (GLEW_EXT_texture_filter_anisotropic || GLEW_ARB_texture_filter_anisotropic)
+  {
+    GLfloat maxAnisotropy = 1.0f;
+    glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropy);
+    m_maxAnisotropyLevel = std::max(1u, static_cast<uint32_t>(maxAnisotropy));
+  }
+
+  setFilteringQuality(a_filteringQuality, a_anisotropyLevel);
+}
+
+void SamplerCache::shutdown()
+{
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+  for (const auto& samplerKvp : m_oglSamplerIdsByKey)
+  {
+    glDeleteSamplers(1, &samplerKvp.second);
+    stateCache.onSamplerDeleted(samplerKvp.second);
+  }
+  m_oglSamplerIdsByKey.clear();
+}
+
+GLuint SamplerCache::getSampler(const SamplerDesc& a_samplerDesc)
+{
+  const uint32_t samplerKey = MakeSamplerKey(a_samplerDesc);
+  auto samplerIt = m_oglSamplerIdsByKey.find(samplerKey);
+  if (m_oglSamplerIdsByKey.end() != samplerIt)
+    return samplerIt->second;
+
+  // Create sampler on first use
+  GLuint oglSamplerId = 0;
+  glGenSamplers(1, &oglSamplerId);
+  setSamplerParameters(oglSamplerId, a_samplerDesc);
+  m_oglSamplerIdsByKey.emplace(samplerKey, oglSamplerId);
+
+  return oglSamplerId;
+}
+
+void SamplerCache::setFilteringQuality(TextureFilteringQuality a_filteringQuality, uint32_t a_anisotropyLevel)
+{
+  m_filteringQuality = a_filteringQuality;
+  m_anisotropyLevel = std::clamp(a_anisotropyLevel, 1u, m_maxAnisotropyLevel);
+  if (TextureFilteringQuality::kAnisotropic == m_filteringQuality && a_anisotropyLevel > m_maxAnisotropyLevel)
+    FLURR_LOG_WARN("Anisotropy level %u not supported, using %u.", a_anisotropyLevel, m_anisotropyLevel);
+
+  // Update samplers that follow the global quality; textures keep using the same sampler objects
+  for (const auto& samplerKvp : m_oglSamplerIdsByKey)
+  {
+    const SamplerDesc samplerDesc = GetSamplerDesc(samplerKvp.first);
+    if (0 == samplerDesc.anisotropyLevel)
+      setSamplerParameters(samplerKvp.second, samplerDesc);
+  }
+}
+
+uint32_t SamplerCache::MakeSamplerKey(const SamplerDesc& a_samplerDesc)
+{
+  return (static_cast<uint32_t>(FromEnum(a_samplerDesc.wrapMode)) << 24) |
+    (static_cast<uint32_t>(FromEnum(a_samplerDesc.minFilterMode)) << 16) |
+    (static_cast<uint32_t>(FromEnum(a_samplerDesc.magFilterMode)) << 8) |
+    a_samplerDesc.anisotropyLevel;
+}
+
+SamplerDesc SamplerCache::GetSamplerDesc(uint32_t a_samplerKey)
+{
+  SamplerDesc samplerDesc;
+  samplerDesc.wrapMode = static_cast<TextureWrapMode>((a_samplerKey >> 24) & 0xFF);
+  samplerDesc.minFilterMode = static_cast<TextureMinFilterMode>((a_samplerKey >> 16) & 0xFF);
+  samplerDesc.magFilterMode = static_cast<TextureMagFilterMode>((a_samplerKey >> 8) & 0xFF);
+  samplerDesc.anisotropyLevel = static_cast<uint8_t>(a_samplerKey & 0xFF);
+
+  return samplerDesc;
+}
+
+bool SamplerCache::ParseFilteringQuality(const std::string& a_str, TextureFilteringQuality& a_filteringQuality)
+{
+  const std::string str = TrimString(a_str);
+  if ("Bilinear" == str)
+    a_filteringQuality = TextureFilteringQuality::kBilinear;
+  else if ("Trilinear" == str)
+    a_filteringQuality = TextureFilteringQuality::kTrilinear;
+  else if ("Anisotropic" == str)
+    a_filteringQuality = TextureFilteringQuality::kAnisotropic;
+  else
+    return false;
+
+  return true;
+}
+
+void SamplerCache::setSamplerParameters(GLuint a_oglSamplerId, const SamplerDesc& a_samplerDesc) const
+{
+  // Set wrap mode
+  const GLint oglWrapMode = Texture::GetOGLTextureWrapMode(a_samplerDesc.wrapMode);
+  glSamplerParameteri(a_oglSamplerId, GL_TEXTURE_WRAP_S, oglWrapMode);
+  glSamplerParameteri(a_oglSamplerId, GL_TEXTURE_WRAP_T, oglWrapMode);
+  glSamplerParameteri(a_oglSamplerId, GL_TEXTURE_WRAP_R, oglWrapMode);
+
+  // Linear mipmap filtering follows the global quality, unless the sampler sets its own anisotropy
+  GLint oglMinFilterMode = Texture::GetOGLTextureMinFilterMode(a_samplerDesc.minFilterMode);
+  uint32_t anisotropyLevel = a_samplerDesc.anisotropyLevel;
+  if (0 == anisotropyLevel)
+  {
+    if (TextureMinFilterMode::kLinearMipmapNearest == a_samplerDesc.minFilterMode ||
+      TextureMinFilterMode::kLinearMipmapLinear == a_samplerDesc.minFilterMode)
+    {
+      oglMinFilterMode = TextureFilteringQuality::kBilinear == m_filteringQuality ? GL_LINEAR_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_LINEAR;
+    }
+    anisotropyLevel = TextureFilteringQuality::kAnisotropic == m_filteringQuality ? m_anisotropyLevel : 1;
+  }
+  glSamplerParameteri(a_oglSamplerId, GL_TEXTURE_MIN_FILTER, oglMinFilterMode);
+  glSamplerParameteri(a_oglSamplerId, GL_TEXTURE_MAG_FILTER, Texture::GetOGLTextureMagFilterMode(a_samplerDesc.magFilterMode));
+
+  // Set anisotropy
+  if (m_maxAnisotropyLevel > 1)
+  {
+    anisotropyLevel = std::clamp(anisotropyLevel, 1u, m_maxAnisotropyLevel);
+    glSamplerParameterf(a_oglSamplerId, GL_TEXTURE_MAX_ANISOTROPY_EXT, static_cast<GLfloat>(anisotropyLevel));
+  }
+}
+
+} // namespace flurr
@@ -15,10 +15,9 @@ Shader::Shader(ShaderType a_shaderType, ShaderProgram* a_owningProgram)
 {
 }
 
-Status Shader::compile(FlurrHandle a_shaderResourceHandle)
+Status Shader::loadSource(FlurrHandle a_shaderResourceHandle)
 {
-  GLenum oglShaderType = getOGLShaderType(getShaderType());
-  if (0 == oglShaderType)
+  if (0 == getOGLShaderType(getShaderType()))
   {
     FLURR_LOG_ERROR("Unsupported shader type %u!", FromEnum(getShaderType()));
     return Status::kUnsupportedType;
@@ -44,21 +43,33 @@ Status Shader::compile(FlurrHandle a_shaderResourceHandle)
     return Status::kResourceNotLoaded;
   }
 
+  // Keep a copy of the source, the resource may be unloaded before the program is linked
+  m_source = shaderResource->getShaderSource();
+  m_sourcePath = shaderResource->getResourcePath();
+
+  return Status::kSuccess;
+}
+
+Status Shader::compile()
+{
   // Create and compile shader
-  const auto& shaderSource = shaderResource->getShaderSource();
-  const auto* shaderSourceData = shaderSource.data();
-  GLint shaderSourceLength = static_cast<GLint>(shaderSource.length());
-  m_oglShaderId = glCreateShader(oglShaderType);
+  const auto* shaderSourceData = m_source.data();
+  GLint shaderSourceLength = static_cast<GLint>(m_source.length());
+  m_oglShaderId = glCreateShader(getOGLShaderType(getShaderType()));
   if (0 == m_oglShaderId)
   {
-    FLURR_LOG_ERROR("Failed to create shader %s!", shaderResource->getResourcePath().c_str());
+    FLURR_LOG_ERROR("Failed to create shader %s!", m_sourcePath.c_str());
     return Status::kFailed;
   }
   glShaderSource(m_oglShaderId, 1, &shaderSourceData, &shaderSourceLength);
   glCompileShader(m_oglShaderId);
-  resourceLock.unlock();
 
-  // Check for compilation errors
+  return Status::kSuccess;
+}
+
+Status Shader::checkCompileStatus() const
+{
+  // Check for compilation errors (blocks until compilation is complete)
   GLint result = 0;
   glGetShaderiv(m_oglShaderId, GL_COMPILE_STATUS, &result);
   if (!result)
@@ -66,7 +77,7 @@ Status Shader::compile(FlurrHandle a_shaderResourceHandle)
     static const int kInfoLogSize = 1024;
     GLchar infoLog[kInfoLogSize];
     glGetShaderInfoLog(m_oglShaderId, kInfoLogSize, nullptr, &infoLog[0]);
-    FLURR_LOG_ERROR("Failed to compile shader %s!\n%s", shaderResource->getResourcePath().c_str(), infoLog);
+    FLURR_LOG_ERROR("Failed to compile shader %s!\n%s", m_sourcePath.c_str(), infoLog);
 
     return Status::kCompilationFailed;
   }
@@ -77,7 +88,10 @@ Status Shader::compile(FlurrHandle a_shaderResourceHandle)
 void Shader::destroy()
 {
   if (m_oglShaderId)
+  {
     glDeleteShader(m_oglShaderId);
+    m_oglShaderId = 0;
+  }
 }
 
 GLenum Shader::getOGLShaderType(ShaderType shader_type) const
@@ -1,90 +1,120 @@
 #include "flurr/renderer/ShaderProgram.h"
+#include "flurr/FlurrCore.h"
 #include "flurr/FlurrLog.h"
 #include "flurr/utils/TypeCasts.h"
 
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
+#include <cstring>
+
 namespace flurr
 {
 
 ShaderProgram::ShaderProgram(FlurrHandle a_programHandle)
   : m_programHandle(a_programHandle),
   m_programState(ShaderProgramState::kDestroyed),
+  m_sourceHash(0),
+  m_linkedFromCache(false),
   m_oglProgramId(0)
 {
 }
 
-bool ShaderProgram::setFloatValue(const std::string& a_name, float a_value)
+template <typename T>
+bool ShaderProgram::updateUniformShadowValue(UniformHandle a_uniform, const T& a_value)
+{
+  static_assert(sizeof(T) <= kMaxUniformValueSize, "Uniform value type too large!");
+
+  // Skip update if the value has not changed
+  auto& uniform = m_uniforms[a_uniform];
+  if (uniform.shadowValueSet && 0 == std::memcmp(uniform.shadowValue, &a_value, sizeof(T)))
+    return false;
+
+  std::memcpy(uniform.shadowValue, &a_value, sizeof(T));
+  uniform.shadowValueSet = true;
+  return true;
+}
+
+UniformHandle ShaderProgram::getUniformHandle(const char* a_name) const
+{
+  for (std::size_t uniformIndex = 0; uniformIndex < m_uniforms.size(); ++uniformIndex)
+    if (0 == std::strcmp(m_uniforms[uniformIndex].name.c_str(), a_name))
+      return static_cast<UniformHandle>(uniformIndex);
+
+  return INVALID_UNIFORM_HANDLE;
+}
+
+bool ShaderProgram::setFloatValue(UniformHandle a_uniform, float a_value)
 {
-  GLint loc = glGetUniformLocation(m_oglProgramId, a_name.c_str());
-  if (-1 == loc) return false;
+  if (!isValidUniformHandle(a_uniform)) return false;
 
-  glUniform1f(loc, a_value);
+  if (updateUniformShadowValue(a_uniform, a_value))
+    glUniform1f(m_uniforms[a_uniform].oglLocation, a_value);
   return true;
 }
 
-bool ShaderProgram::setVec2Value(const std::string& a_name, const glm::vec2& a_value)
+bool ShaderProgram::setVec2Value(UniformHandle a_uniform, const glm::vec2& a_value)
 {
-  GLint loc = glGetUniformLocation(m_oglProgramId, a_name.c_str());
-  if (-1 == loc) return false;
+  if (!isValidUniformHandle(a_uniform)) return false;
 
-  glUniform2f(loc, a_value.x, a_value.y);
+  if (updateUniformShadowValue(a_uniform, a_value))
+    glUniform2f(m_uniforms[a_uniform].oglLocation, a_value.x, a_value.y);
   return true;
 }
 
-bool ShaderProgram::setVec3Value(const std::string& a_name, const glm::vec3& a_value)
+bool ShaderProgram::setVec3Value(UniformHandle a_uniform, const glm::vec3& a_value)
 {
-  GLint loc = glGetUniformLocation(m_oglProgramId, a_name.c_str());
-  if (-1 == loc) return false;
+  if (!isValidUniformHandle(a_uniform)) return false;
 
-  glUniform3f(loc, a_value.x, a_value.y, a_value.z);
+  if (updateUniformShadowValue(a_uniform, a_value))
+    glUniform3f(m_uniforms[a_uniform].oglLocation, a_value.x, a_value.y, a_value.z);
   return true;
 }
 
-bool ShaderProgram::setVec4Value(const std::string& a_name, const glm::vec4& a_value)
+bool ShaderProgram::setVec4Value(UniformHandle a_uniform, const glm::vec4& a_value)
 {
-  GLint loc = glGetUniformLocation(m_oglProgramId, a_name.c_str());
-  if (-1 == loc) return false;
+  if (!isValidUniformHandle(a_uniform)) return false;
 
-  glUniform4f(loc, a_value.x, a_value.y, a_value.z, a_value.w);
+  if (updateUniformShadowValue(a_uniform, a_value))
+    glUniform4f(m_uniforms[a_uniform].oglLocation, a_value.x, a_value.y, a_value.z, a_value.w);
   return true;
 }
 
-bool ShaderProgram::setMat4Value(const std::string& a_name, const glm::mat4& a_value)
+bool ShaderProgram::setMat4Value(UniformHandle a_uniform, const glm::mat4& a_value)
 {
-  GLint loc = glGetUniformLocation(m_oglProgramId, a_name.c_str());
-  if (-1 == loc) return false;
+  if (!isValidUniformHandle(a_uniform)) return false;
 
-  glUniformMatrix4fv(loc, 1, GL_FALSE, glm::value_ptr(a_value));
+  if (updateUniformShadowValue(a_uniform, a_value))
+    glUniformMatrix4fv(m_uniforms[a_uniform].oglLocation, 1, GL_FALSE, glm::value_ptr(a_value));
   return true;
 }
 
-bool ShaderProgram::setIntValue(const std::string& a_name, int a_value)
+bool ShaderProgram::setIntValue(UniformHandle a_uniform, int a_value)
 {
-  GLint loc = glGetUniformLocation(m_oglProgramId, a_name.c_str());
-  if (-1 == loc) return false;
+  if (!isValidUniformHandle(a_uniform)) return false;
 
-  glUniform1i(loc, a_value);
+  if (updateUniformShadowValue(a_uniform, a_value))
+    glUniform1i(m_uniforms[a_uniform].oglLocation, a_value);
   return true;
 }
 
-bool ShaderProgram::setUIntValue(const std::string& a_name, uint32_t a_value)
+bool ShaderProgram::setUIntValue(UniformHandle a_uniform, uint32_t a_value)
 {
-  GLint loc = glGetUniformLocation(m_oglProgramId, a_name.c_str());
-  if (-1 == loc) return false;
+  if (!isValidUniformHandle(a_uniform)) return false;
 
-  glUniform1ui(loc, a_value);
+  if (updateUniformShadowValue(a_uniform, a_value))
+    glUniform1ui(m_uniforms[a_uniform].oglLocation, a_value);
   return true;
 }
 
-bool ShaderProgram::setBoolValue(const std::string& a_name, bool a_value)
+bool ShaderProgram::setBoolValue(UniformHandle a_uniform, bool a_value)
 {
-  return setIntValue(a_name, a_value);
+  return setIntValue(a_uniform, a_value);
 }
 
 Status ShaderProgram::compileShader(ShaderType a_shaderType, FlurrHandle a_shaderResourceHandle)
 {
-  if (ShaderProgramState::kLinked == m_programState)
+  if (ShaderProgramState::kLinked == m_programState || ShaderProgramState::kLinking == m_programState)
   {
     FLURR_LOG_ERROR("Unable to compile shader, program already linked!");
     return Status::kInvalidState;
@@ -96,14 +126,14 @@ Status ShaderProgram::compileShader(ShaderType a_shaderType, FlurrHandle a_shade
     m_shadersByType.at(a_shaderType)->destroy();
   }
 
-  m_shadersByType.emplace(a_shaderType, std::make_unique<Shader>(a_shaderType, this));
+  // Shader is compiled when the program is linked, unless the program binary is cached
+  m_shadersByType[a_shaderType] = std::make_unique<Shader>(a_shaderType, this);
   auto* shader = getShader(a_shaderType);
-  Status compileStatus = shader->compile(a_shaderResourceHandle);
-  if (Status::kSuccess != compileStatus)
+  Status loadStatus = shader->loadSource(a_shaderResourceHandle);
+  if (Status::kSuccess != loadStatus)
   {
-    shader->destroy();
     m_shadersByType.erase(a_shaderType);
-    return compileStatus;
+    return loadStatus;
   }
 
   m_programState = ShaderProgramState::kCompiled;
@@ -123,6 +153,15 @@ Shader* ShaderProgram::getShader(ShaderType a_shaderType) const
 }
 
 Status ShaderProgram::linkProgram()
+{
+  Status result = beginLink();
+  if (Status::kSuccess != result)
+    return result;
+
+  return finishLink();
+}
+
+Status ShaderProgram::beginLink()
 {
   if (ShaderProgramState::kCompiled != getProgramState())
   {
@@ -137,26 +176,100 @@ Status ShaderProgram::linkProgram()
     return Status::kFailed;
   }
 
-  // Link current program
-  for (const auto& shaderKvp : m_shadersByType)
-    glAttachShader(m_oglProgramId, shaderKvp.second.get()->getOGLShaderId());
-  glLinkProgram(m_oglProgramId);
+  // Try to load program from binary cache
+  auto& binaryCache = FlurrCore::Get().getRenderer()->getProgramBinaryCache();
+  m_sourceHash = computeSourceHash();
+  m_linkedFromCache = binaryCache.isEnabled() && Status::kSuccess == binaryCache.loadProgram(m_sourceHash, m_oglProgramId);
+  if (!m_linkedFromCache)
+  {
+    // Submit shader compilation, without waiting for the results
+    for (const auto& shaderKvp : m_shadersByType)
+    {
+      Status compileStatus = shaderKvp.second->compile();
+      if (Status::kSuccess != compileStatus)
+      {
+        cancelLink();
+        return compileStatus;
+      }
+    }
+
+    // Submit link of current program
+    if (binaryCache.isEnabled())
+      glProgramParameteri(m_oglProgramId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    for (const auto& shaderKvp : m_shadersByType)
+      glAttachShader(m_oglProgramId, shaderKvp.second.get()->getOGLShaderId());
+    glLinkProgram(m_oglProgramId);
+  }
+
+  m_programState = ShaderProgramState::kLinking;
+  return Status::kSuccess;
+}
+
+bool ShaderProgram::isLinkComplete() const
+{
+  if (ShaderProgramState::kLinking != getProgramState())
+    return true;
+
+  // Without parallel compilation, querying results always blocks
+  if (m_linkedFromCache || !FlurrCore::Get().getRenderer()->hasParallelShaderCompile())
+    return true;
+
+  GLint completionStatus = GL_FALSE;
+  glGetProgramiv(m_oglProgramId, GL_COMPLETION_STATUS_KHR, &completionStatus);
+  return GL_FALSE != completionStatus;
+}
 
-  // Check for linking errors
-  GLint result;
-  glGetProgramiv(m_oglProgramId, GL_LINK_STATUS, &result);
-  if (!result)
+Status ShaderProgram::finishLink()
+{
+  if (ShaderProgramState::kLinking != getProgramState())
   {
-    static const int kInfoLogSize = 1024;
-    GLchar infoLog[kInfoLogSize];
-    glGetProgramInfoLog(m_oglProgramId, kInfoLogSize, nullptr, &infoLog[0]);
-    FLURR_LOG_ERROR("Failed to link shader program!\n%s", infoLog);
+    FLURR_LOG_ERROR("Shader program not in linking state!");
+    return Status::kInvalidState;
+  }
 
-    return Status::kLinkingFailed;
+  if (!m_linkedFromCache)
+  {
+    // Check for compilation errors
+    for (const auto& shaderKvp : m_shadersByType)
+    {
+      Status compileStatus = shaderKvp.second->checkCompileStatus();
+      if (Status::kSuccess != compileStatus)
+      {
+        cancelLink();
+        return compileStatus;
+      }
+    }
+
+    // Check for linking errors
+    GLint result;
+    glGetProgramiv(m_oglProgramId, GL_LINK_STATUS, &result);
+    if (!result)
+    {
+      static const int kInfoLogSize = 1024;
+      GLchar infoLog[kInfoLogSize];
+      glGetProgramInfoLog(m_oglProgramId, kInfoLogSize, nullptr, &infoLog[0]);
+      FLURR_LOG_ERROR("Failed to link shader program!\n%s", infoLog);
+      cancelLink();
+
+      return Status::kLinkingFailed;
+    }
+
+    // Cache program binary for the next run
+    auto& binaryCache = FlurrCore::Get().getRenderer()->getProgramBinaryCache();
+    if (binaryCache.isEnabled())
+      binaryCache.storeProgram(m_sourceHash, m_oglProgramId);
   }
-  
+
   m_programState = ShaderProgramState::kLinked;
 
+  // Build table of active uniforms
+  reflectUniforms();
+
+  // Bind per-frame uniform block, if used
+  const GLuint frameBlockIndex = glGetUniformBlockIndex(m_oglProgramId, FRAME_UNIFORM_BLOCK_NAME);
+  if (GL_INVALID_INDEX != frameBlockIndex)
+    glUniformBlockBinding(m_oglProgramId, frameBlockIndex, FRAME_UNIFORM_BLOCK_BINDING);
+
   // Safe to destroy shaders once program is linked
   for (auto& shaderKvp : m_shadersByType)
     shaderKvp.second.get()->destroy();
@@ -164,11 +277,47 @@ Status ShaderProgram::linkProgram()
   return Status::kSuccess;
 }
 
+void ShaderProgram::cancelLink()
+{
+  // Delete OGL objects, but keep shader sources, so the program can be linked again
+  if (m_oglProgramId)
+  {
+    glDeleteProgram(m_oglProgramId);
+    FlurrCore::Get().getRenderer()->getStateCache().onProgramDeleted(m_oglProgramId);
+    m_oglProgramId = 0;
+  }
+  for (auto& shaderKvp : m_shadersByType)
+    shaderKvp.second->destroy();
+  m_programState = ShaderProgramState::kCompiled;
+}
+
+uint64_t ShaderProgram::computeSourceHash() const
+{
+  // Hash stage sources in a fixed order
+  uint64_t sourceHash = ProgramBinaryCache::kHashSeed;
+  for (ShaderType shaderType : {ShaderType::kVertex, ShaderType::kGeometry, ShaderType::kFragment})
+  {
+    const auto* shader = getShader(shaderType);
+    if (!shader)
+      continue;
+
+    sourceHash = ProgramBinaryCache::Hash(&shaderType, sizeof(shaderType), sourceHash);
+    sourceHash = ProgramBinaryCache::Hash(shader->getSource().data(), shader->getSource().size(), sourceHash);
+  }
+
+  return sourceHash;
+}
+
 void ShaderProgram::destroyProgram()
 {
-  if (!m_oglProgramId)
+  if (m_oglProgramId)
+  {
     glDeleteProgram(m_oglProgramId);
+    FlurrCore::Get().getRenderer()->getStateCache().onProgramDeleted(m_oglProgramId);
+    m_oglProgramId = 0;
+  }
   m_programState = ShaderProgramState::kDestroyed;
+  m_uniforms.clear();
 
   // Also destroy shaders
   for (auto& shaderKvp : m_shadersByType)
@@ -184,8 +333,50 @@ Status ShaderProgram::useProgram()
     return Status::kInvalidState;
   }
 
-  glUseProgram(m_oglProgramId);
+  FlurrCore::Get().getRenderer()->getStateCache().useProgram(m_oglProgramId);
   return Status::kSuccess;
 }
 
+void ShaderProgram::reflectUniforms()
+{
+  m_uniforms.clear();
+
+  // Get active uniform count and max. name length
+  GLint uniformCount = 0;
+  GLint maxNameLength = 0;
+  glGetProgramiv(m_oglProgramId, GL_ACTIVE_UNIFORMS, &uniformCount);
+  glGetProgramiv(m_oglProgramId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+  std::vector<GLchar> nameBuffer(std::max<GLint>(maxNameLength, 1));
+  m_uniforms.reserve(uniformCount);
+
+  // Query name, type and location of each uniform
+  for (GLint uniformIndex = 0; uniformIndex < uniformCount; ++uniformIndex)
+  {
+    GLsizei nameLength = 0;
+    GLint arraySize = 0;
+    GLenum oglType = GL_NONE;
+    glGetActiveUniform(m_oglProgramId, static_cast<GLuint>(uniformIndex), static_cast<GLsizei>(nameBuffer.size()),
+      &nameLength, &arraySize, &oglType, nameBuffer.data());
+    const GLint oglLocation = glGetUniformLocation(m_oglProgramId, nameBuffer.data());
+    if (-1 == oglLocation)
+      continue; // uniform block member
+
+    // Strip array suffix, so arrays can be looked up by name
+    std::string name(nameBuffer.data(), nameLength);
+    const std::size_t arraySuffixPos = name.rfind("[0]");
+    if (std::string::npos != arraySuffixPos && arraySuffixPos + 3 == name.size())
+      name.erase(arraySuffixPos);
+
+    Uniform uniform;
+    uniform.name = std::move(name);
+    uniform.oglLocation = oglLocation;
+    uniform.oglType = oglType;
+    uniform.arraySize = arraySize;
+    uniform.shadowValueSet = false;
+    m_uniforms.push_back(std::move(uniform));
+  }
+
+  FLURR_LOG_DEBUG("Shader program %u has %u active uniforms.", getProgramHandle(), static_cast<uint32_t>(m_uniforms.size()));
+}
+
 } // namespace flurr
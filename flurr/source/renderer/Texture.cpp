@@ -12,22 +12,151 @@ Texture::Texture(FlurrHandle a_texHandle)
   m_texWrapMode(TextureWrapMode::kRepeat),
   m_texMinFilterMode(TextureMinFilterMode::kLinearMipmapLinear),
   m_texMagFilterMode(TextureMagFilterMode::kLinear),
-  m_oglTexId(0)
+  m_texWidth(0),
+  m_texHeight(0),
+  m_texDataSize(0),
+  m_compressed(false),
+  m_uploadPending(false),
+  m_arrayHandle(INVALID_HANDLE),
+  m_arrayLayer(0),
+  m_oglTexId(0),
+  m_oglSamplerId(0),
+  m_oglInternalTexFormat(GL_RGB8),
+  m_oglTexFormat(GL_RGB)
 {
 }
 
-Status Texture::initTexture(FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode)
+Status Texture::initTexture(FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode, bool a_asyncUpload)
 {
-  if (m_oglTexId)
+  if (INVALID_HANDLE != m_texResourceHandle)
+  {
+    FLURR_LOG_ERROR("Texture already created!");
+    return Status::kInvalidState;
+  }
+
+  // Ensure we have a valid and loaded texture resource
+  std::unique_lock<std::mutex> resourceLock;
+  TextureResource* texResource = nullptr;
+  Status result = lockTextureResource(a_texResourceHandle, resourceLock, &texResource);
+  if (Status::kSuccess != result)
+    return result;
+
+  // Initialize texture
+  m_texResourceHandle = a_texResourceHandle;
+  m_texWrapMode = a_texWrapMode;
+  m_texMinFilterMode = a_texMinFilterMode;
+  m_texMagFilterMode = a_texMagFilterMode;
+
+  // Determine texture format
+  GLint oglInternalTexFormat = GL_RGB8;
+  GLint oglTexFormat = GL_RGB;
+  if (!GetOGLTextureFormat(texResource->getTextureFormat(), oglInternalTexFormat, oglTexFormat))
+  {
+    FLURR_LOG_ERROR("Unsupported texture format %u for texture %u!",
+      FromEnum(texResource->getTextureFormat()), getTextureHandle());
+    return Status::kUnsupportedTextureFormat;
+  }
+
+  m_texWidth = texResource->getTextureWidth();
+  m_texHeight = texResource->getTextureHeight();
+  m_texDataSize = texResource->getTextureDataSize();
+  m_mipLevels.clear();
+  for (std::size_t mipLevel = 0; mipLevel < texResource->getMipLevelCount(); ++mipLevel)
+    m_mipLevels.push_back(texResource->getMipLevel(mipLevel));
+  m_compressed = texResource->isCompressed();
+  m_oglInternalTexFormat = oglInternalTexFormat;
+  m_oglTexFormat = oglTexFormat;
+
+  // Create OGL texture ID
+  glGenTextures(1, &m_oglTexId);
+  FlurrCore::Get().getRenderer()->getStateCache().bindTexture(GL_TEXTURE_2D, m_oglTexId);
+
+  // Wrap and filter modes live in a shared sampler object
+  m_oglSamplerId = FlurrCore::Get().getRenderer()->getSamplerCache().getSampler(getSamplerDesc());
+
+  // Compressed mips can't be generated, so sample only the levels stored in the resource
+  if (m_compressed)
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(m_mipLevels.size()) - 1);
+
+  // Async upload only allocates storage here; data is uploaded later from a PBO
+  if (a_asyncUpload)
+  {
+    setTextureLevels(nullptr);
+    m_uploadPending = true;
+    return Status::kSuccess;
+  }
+
+  // Load texture data
+  setTextureLevels(texResource->getTextureData());
+  if (hasMipmaps() && !m_compressed)
+    glGenerateMipmap(GL_TEXTURE_2D);
+
+  return Status::kSuccess;
+}
+
+Status Texture::initArrayLayer(FlurrHandle a_texResourceHandle, TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode)
+{
+  if (INVALID_HANDLE != m_texResourceHandle)
   {
     FLURR_LOG_ERROR("Texture already created!");
     return Status::kInvalidState;
   }
 
   // Ensure we have a valid and loaded texture resource
+  std::unique_lock<std::mutex> resourceLock;
+  TextureResource* texResource = nullptr;
+  Status result = lockTextureResource(a_texResourceHandle, resourceLock, &texResource);
+  if (Status::kSuccess != result)
+    return result;
+
+  // Uncompressed arrays get a full mip chain, compressed arrays the levels stored in the resource
+  const bool compressed = texResource->isCompressed();
+  uint32_t mipLevelCount = static_cast<uint32_t>(texResource->getMipLevelCount());
+  if (!compressed)
+    mipLevelCount = IsMipmapFilterMode(a_texMinFilterMode) ? TextureArray::FullMipLevelCount(texResource->getTextureWidth(), texResource->getTextureHeight()) : 1;
+
+  // Find or create an array with a free layer of matching size, format and sampling
+  auto* renderer = FlurrCore::Get().getRenderer();
+  FlurrHandle arrayHandle = INVALID_HANDLE;
+  uint32_t arrayLayer = 0;
+  result = renderer->allocateTextureArrayLayer(texResource->getTextureWidth(), texResource->getTextureHeight(), texResource->getTextureFormat(),
+    mipLevelCount, a_texWrapMode, a_texMinFilterMode, a_texMagFilterMode, arrayHandle, arrayLayer);
+  if (Status::kSuccess != result)
+    return result;
+
+  // Upload texture data into the layer
+  auto* textureArray = renderer->getTextureArray(arrayHandle);
+  std::vector<TextureMipLevel> mipLevels;
+  for (std::size_t mipLevel = 0; mipLevel < texResource->getMipLevelCount(); ++mipLevel)
+    mipLevels.push_back(texResource->getMipLevel(mipLevel));
+  result = textureArray->uploadLayer(arrayLayer, texResource->getTextureData(), mipLevels);
+  if (Status::kSuccess != result)
+  {
+    textureArray->freeLayer(arrayLayer);
+    return result;
+  }
+
+  m_texResourceHandle = a_texResourceHandle;
+  m_texWrapMode = a_texWrapMode;
+  m_texMinFilterMode = a_texMinFilterMode;
+  m_texMagFilterMode = a_texMagFilterMode;
+  m_texWidth = texResource->getTextureWidth();
+  m_texHeight = texResource->getTextureHeight();
+  m_texDataSize = texResource->getTextureDataSize();
+  m_mipLevels = std::move(mipLevels);
+  m_compressed = compressed;
+  m_arrayHandle = arrayHandle;
+  m_arrayLayer = arrayLayer;
+  m_oglSamplerId = renderer->getSamplerCache().getSampler(getSamplerDesc());
+
+  return Status::kSuccess;
+}
+
+Status Texture::lockTextureResource(FlurrHandle a_texResourceHandle, std::unique_lock<std::mutex>& a_resourceLock, TextureResource** a_texResource) const
+{
   auto* resourceManager = FlurrCore::Get().getResourceManager();
   Resource* resource = nullptr;
-  auto resourceLock = resourceManager->lockAndGetResource(&resource, a_texResourceHandle);
+  a_resourceLock = resourceManager->lockAndGetResource(&resource, a_texResourceHandle);
   if (!resource)
   {
     FLURR_LOG_ERROR("Unable to initialize texture; texture resource %u does not exist!", a_texResourceHandle);
@@ -44,60 +173,116 @@ Status Texture::initTexture(FlurrHandle a_texResourceHandle, TextureWrapMode a_t
     return Status::kResourceNotLoaded;
   }
 
-  // Initialize texture
-  m_texResourceHandle = a_texResourceHandle;
-  m_texWrapMode = a_texWrapMode;
-  m_texMinFilterMode = a_texMinFilterMode;
-  m_texMagFilterMode = a_texMagFilterMode;
-  auto* texResource = static_cast<TextureResource*>(resource);
+  *a_texResource = static_cast<TextureResource*>(resource);
+  return Status::kSuccess;
+}
 
-  // Determine texture format
+Status Texture::checkTextureResource(FlurrHandle a_texResourceHandle) const
+{
+  if (INVALID_HANDLE != m_texResourceHandle)
+  {
+    FLURR_LOG_ERROR("Texture already created!");
+    return Status::kInvalidState;
+  }
+
+  // Ensure we have a valid and loaded texture resource
+  std::unique_lock<std::mutex> resourceLock;
+  TextureResource* texResource = nullptr;
+  Status result = lockTextureResource(a_texResourceHandle, resourceLock, &texResource);
+  if (Status::kSuccess != result)
+    return result;
+
+  // Ensure the texture format is supported
   GLint oglInternalTexFormat = GL_RGB8;
   GLint oglTexFormat = GL_RGB;
-  if (!getOGLTextureFormat(texResource->getTextureFormat(), oglInternalTexFormat, oglTexFormat))
+  if (!GetOGLTextureFormat(texResource->getTextureFormat(), oglInternalTexFormat, oglTexFormat))
   {
     FLURR_LOG_ERROR("Unsupported texture format %u for texture %u!",
       FromEnum(texResource->getTextureFormat()), getTextureHandle());
     return Status::kUnsupportedTextureFormat;
   }
 
-  // Create OGL texture ID
-  glGenTextures(1, &m_oglTexId);
-
-  // Determine texture wrap mode
-  GLint oglTexWrapMode = getOGLTextureWrapMode(getWrapMode());
+  return Status::kSuccess;
+}
 
-  // Determine texture minificiation filter mode
-  GLint oglTexMinFilterMode = getOGLTextureMinFilterMode(getMinFilterMode());
+void Texture::setTextureLevels(const void* a_data)
+{
+  if (!m_compressed)
+  {
+    glTexImage2D(GL_TEXTURE_2D, 0, m_oglInternalTexFormat, m_texWidth, m_texHeight,
+      0, m_oglTexFormat, GL_UNSIGNED_BYTE, a_data);
+    return;
+  }
 
-  // Determine texture magnification filter mode
-  GLint oglTexMagFilterMode = getOGLTextureMagFilterMode(getMagFilterMode());
+  // Pass block-compressed levels through unchanged; null data only allocates storage
+  for (std::size_t mipLevel = 0; mipLevel < m_mipLevels.size(); ++mipLevel)
+  {
+    const auto& level = m_mipLevels[mipLevel];
+    const void* levelData = a_data ? static_cast<const uint8_t*>(a_data) + level.offset : nullptr;
+    glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(mipLevel), m_oglInternalTexFormat, level.width, level.height,
+      0, static_cast<GLsizei>(level.size), levelData);
+  }
+}
 
-  // Set texture wrap and filter parameters
-  glBindTexture(GL_TEXTURE_2D, m_oglTexId);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, oglTexWrapMode);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, oglTexWrapMode);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, oglTexMinFilterMode);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, oglTexMagFilterMode);
+Status Texture::uploadFromPixelBuffer(GLuint a_oglPixelBufferId)
+{
+  if (!m_oglTexId)
+  {
+    FLURR_LOG_ERROR("Unable to upload texture data; texture not created yet!");
+    return Status::kInvalidState;
+  }
 
-  // Load texture data
-  glTexImage2D(GL_TEXTURE_2D, 0, oglInternalTexFormat, texResource->getTextureWidth(), texResource->getTextureHeight(),
-    0, oglTexFormat, GL_UNSIGNED_BYTE, texResource->getTextureData());
-  if (getMinFilterMode() >= TextureMinFilterMode::kNearestMipmapNearest &&
-    getMinFilterMode() <= TextureMinFilterMode::kLinearMipmapLinear)
+  // Source the pixels from the PBO; the driver copies them without stalling the CPU
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+  stateCache.bindTexture(GL_TEXTURE_2D, m_oglTexId);
+  stateCache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, a_oglPixelBufferId);
+  if (m_compressed)
   {
-    glGenerateMipmap(GL_TEXTURE_2D);
+    for (std::size_t mipLevel = 0; mipLevel < m_mipLevels.size(); ++mipLevel)
+    {
+      const auto& level = m_mipLevels[mipLevel];
+      glCompressedTexSubImage2D(GL_TEXTURE_2D, static_cast<GLint>(mipLevel), 0, 0, level.width, level.height,
+        m_oglInternalTexFormat, static_cast<GLsizei>(level.size), reinterpret_cast<const void*>(level.offset));
+    }
   }
+  else
+  {
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_texWidth, m_texHeight, m_oglTexFormat, GL_UNSIGNED_BYTE, nullptr);
+  }
+  stateCache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0); // client pointers are offsets while a PBO is bound
+  if (hasMipmaps() && !m_compressed)
+    glGenerateMipmap(GL_TEXTURE_2D);
 
   return Status::kSuccess;
 }
 
+bool Texture::hasMipmaps() const
+{
+  return IsMipmapFilterMode(getMinFilterMode());
+}
+
 void Texture::destroyTexture()
 {
   if (m_oglTexId)
+  {
     glDeleteTextures(1, &m_oglTexId);
+    FlurrCore::Get().getRenderer()->getStateCache().onTextureDeleted(m_oglTexId);
+    m_oglTexId = 0;
+  }
+
+  // Return array layer for reuse
+  if (isArrayLayer())
+  {
+    auto* textureArray = FlurrCore::Get().getRenderer()->getTextureArray(m_arrayHandle);
+    if (textureArray)
+      textureArray->freeLayer(m_arrayLayer);
+    m_arrayHandle = INVALID_HANDLE;
+    m_arrayLayer = 0;
+  }
 
   m_texResourceHandle = INVALID_HANDLE;
+  m_oglSamplerId = 0; // owned by the sampler cache
+  m_uploadPending = false;
 }
 
 Status Texture::useTexture(TextureUnitIndex a_texUnit)
@@ -114,13 +299,28 @@ Status Texture::useTexture(TextureUnitIndex a_texUnit)
     return Status::kIndexOutOfBounds;
   }
 
-  glActiveTexture(GL_TEXTURE0 + a_texUnit);
-  glBindTexture(GL_TEXTURE_2D, m_oglTexId);
+  // Array layers bind the whole array; shaders select the layer
+  auto* renderer = FlurrCore::Get().getRenderer();
+  if (isArrayLayer())
+  {
+    auto* textureArray = renderer->getTextureArray(m_arrayHandle);
+    if (!textureArray)
+    {
+      FLURR_LOG_ERROR("Unable to use texture; texture array %u no longer exists!", m_arrayHandle);
+      return Status::kInvalidState;
+    }
+    renderer->getStateCache().bindTexture(a_texUnit, GL_TEXTURE_2D_ARRAY, textureArray->getOGLTextureArrayId());
+    renderer->getStateCache().bindSampler(a_texUnit, m_oglSamplerId);
+    return Status::kSuccess;
+  }
+
+  renderer->getStateCache().bindTexture(a_texUnit, GL_TEXTURE_2D, m_oglTexId);
+  renderer->getStateCache().bindSampler(a_texUnit, m_oglSamplerId);
 
   return Status::kSuccess;
 }
 
-bool Texture::getOGLTextureFormat(TextureFormat a_texFormat, GLint& a_oglInternalTexFormat, GLint& a_oglTexFormat) const
+bool Texture::GetOGLTextureFormat(TextureFormat a_texFormat, GLint& a_oglInternalTexFormat, GLint& a_oglTexFormat)
 {
   switch (a_texFormat)
   {
@@ -136,6 +336,18 @@ bool Texture::getOGLTextureFormat(TextureFormat a_texFormat, GLint& a_oglInterna
     a_oglInternalTexFormat = GL_RGBA8;
     a_oglTexFormat = GL_RGBA;
     break;
+  case TextureFormat::kBC1:
+    a_oglInternalTexFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+    a_oglTexFormat = GL_RGBA;
+    return GLEW_EXT_texture_compression_s3tc;
+  case TextureFormat::kBC2:
+    a_oglInternalTexFormat = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+    a_oglTexFormat = GL_RGBA;
+    return GLEW_EXT_texture_compression_s3tc;
+  case TextureFormat::kBC3:
+    a_oglInternalTexFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    a_oglTexFormat = GL_RGBA;
+    return GLEW_EXT_texture_compression_s3tc;
   default:
     return false;
   }
@@ -143,7 +355,7 @@ bool Texture::getOGLTextureFormat(TextureFormat a_texFormat, GLint& a_oglInterna
   return true;
 }
 
-GLint Texture::getOGLTextureWrapMode(TextureWrapMode a_texWrapMode) const
+GLint Texture::GetOGLTextureWrapMode(TextureWrapMode a_texWrapMode)
 {
   switch (a_texWrapMode)
   {
@@ -161,7 +373,7 @@ GLint Texture::getOGLTextureWrapMode(TextureWrapMode a_texWrapMode) const
 }
 
 
-GLint Texture::getOGLTextureMinFilterMode(TextureMinFilterMode a_texMinFilterMode) const
+GLint Texture::GetOGLTextureMinFilterMode(TextureMinFilterMode a_texMinFilterMode)
 {
   switch (a_texMinFilterMode)
   {
@@ -183,7 +395,7 @@ GLint Texture::getOGLTextureMinFilterMode(TextureMinFilterMode a_texMinFilterMod
 }
 
 
-GLint Texture::getOGLTextureMagFilterMode(TextureMagFilterMode a_texMagFilterMode) const
+GLint Texture::GetOGLTextureMagFilterMode(TextureMagFilterMode a_texMagFilterMode)
 {
   switch (a_texMagFilterMode)
   {
@@ -196,4 +408,10 @@ GLint Texture::getOGLTextureMagFilterMode(TextureMagFilterMode a_texMagFilterMod
   }
 }
 
+bool Texture::IsMipmapFilterMode(TextureMinFilterMode a_texMinFilterMode)
+{
+  return a_texMinFilterMode >= TextureMinFilterMode::kNearestMipmapNearest &&
+    a_texMinFilterMode <= TextureMinFilterMode::kLinearMipmapLinear;
+}
+
 } // namespace flurr
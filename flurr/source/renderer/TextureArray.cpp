@@ -0,0 +1,180 @@
+#include "flurr/renderer/TextureArray.h"
+#include "flurr/FlurrCore.h"
+#include "flurr/FlurrLog.h"
+#include "flurr/utils/TypeCasts.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace flurr
+{
+
+TextureArray::TextureArray(FlurrHandle a_arrayHandle)
+  : m_arrayHandle(a_arrayHandle),
+  m_texWidth(0),
+  m_texHeight(0),
+  m_texFormat(TextureFormat::kRGBA),
+  m_mipLevelCount(0),
+  m_layerCapacity(0),
+  m_texWrapMode(TextureWrapMode::kRepeat),
+  m_texMinFilterMode(TextureMinFilterMode::kLinearMipmapLinear),
+  m_texMagFilterMode(TextureMagFilterMode::kLinear),
+  m_oglTexArrayId(0),
+  m_oglInternalTexFormat(GL_RGBA8),
+  m_oglTexFormat(GL_RGBA)
+{
+}
+
+bool TextureArray::isCompatible(uint32_t a_width, uint32_t a_height, TextureFormat a_texFormat, uint32_t a_mipLevelCount,
+  TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode) const
+{
+  return a_width == m_texWidth && a_height == m_texHeight && a_texFormat == m_texFormat && a_mipLevelCount == m_mipLevelCount &&
+    a_texWrapMode == m_texWrapMode && a_texMinFilterMode == m_texMinFilterMode && a_texMagFilterMode == m_texMagFilterMode;
+}
+
+uint32_t TextureArray::FullMipLevelCount(uint32_t a_width, uint32_t a_height)
+{
+  uint32_t mipLevelCount = 1;
+  for (uint32_t size = std::max(a_width, a_height); size > 1; size /= 2)
+    ++mipLevelCount;
+
+  return mipLevelCount;
+}
+
+Status TextureArray::initArray(uint32_t a_width, uint32_t a_height, TextureFormat a_texFormat, uint32_t a_mipLevelCount, uint32_t a_layerCapacity,
+  TextureWrapMode a_texWrapMode, TextureMinFilterMode a_texMinFilterMode, TextureMagFilterMode a_texMagFilterMode)
+{
+  if (isCreated())
+  {
+    FLURR_LOG_ERROR("Texture array already created!");
+    return Status::kInvalidState;
+  }
+
+  if (0 == a_width || 0 == a_height || 0 == a_mipLevelCount || 0 == a_layerCapacity)
+  {
+    FLURR_LOG_ERROR("Unable to create texture array with zero size!");
+    return Status::kInvalidArgument;
+  }
+
+  if (!GLEW_ARB_texture_storage)
+  {
+    FLURR_LOG_ERROR("Unable to create texture array; immutable texture storage not supported!");
+    return Status::kUnsupportedMode;
+  }
+
+  // Determine texture format
+  if (!Texture::GetOGLTextureFormat(a_texFormat, m_oglInternalTexFormat, m_oglTexFormat))
+  {
+    FLURR_LOG_ERROR("Unsupported texture format %u for texture array %u!", FromEnum(a_texFormat), getArrayHandle());
+    return Status::kUnsupportedTextureFormat;
+  }
+
+  // Clamp capacity to what the driver supports
+  GLint maxLayerCount = 0;
+  glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayerCount);
+  if (maxLayerCount > 0)
+    a_layerCapacity = std::min(a_layerCapacity, static_cast<uint32_t>(maxLayerCount));
+
+  m_texWidth = a_width;
+  m_texHeight = a_height;
+  m_texFormat = a_texFormat;
+  m_mipLevelCount = a_mipLevelCount;
+  m_layerCapacity = a_layerCapacity;
+  m_texWrapMode = a_texWrapMode;
+  m_texMinFilterMode = a_texMinFilterMode;
+  m_texMagFilterMode = a_texMagFilterMode;
+  m_freeLayers.clear();
+  for (uint32_t layer = m_layerCapacity; layer > 0; --layer)
+    m_freeLayers.push_back(layer - 1);
+
+  // Create array with immutable storage for all layers and levels
+  glGenTextures(1, &m_oglTexArrayId);
+  FlurrCore::Get().getRenderer()->getStateCache().bindTexture(GL_TEXTURE_2D_ARRAY, m_oglTexArrayId);
+  glTexStorage3D(GL_TEXTURE_2D_ARRAY, m_mipLevelCount, m_oglInternalTexFormat, m_texWidth, m_texHeight, m_layerCapacity);
+
+  return Status::kSuccess;
+}
+
+void TextureArray::destroyArray()
+{
+  if (m_oglTexArrayId)
+  {
+    glDeleteTextures(1, &m_oglTexArrayId);
+    FlurrCore::Get().getRenderer()->getStateCache().onTextureDeleted(m_oglTexArrayId);
+    m_oglTexArrayId = 0;
+  }
+
+  m_freeLayers.clear();
+  m_layerCapacity = 0;
+}
+
+Status TextureArray::allocateLayer(uint32_t& a_layer)
+{
+  if (m_freeLayers.empty())
+  {
+    FLURR_LOG_ERROR("No free layers in texture array %u!", getArrayHandle());
+    return Status::kInvalidState;
+  }
+
+  a_layer = m_freeLayers.back();
+  m_freeLayers.pop_back();
+
+  return Status::kSuccess;
+}
+
+void TextureArray::freeLayer(uint32_t a_layer)
+{
+  if (a_layer >= m_layerCapacity || std::find(m_freeLayers.begin(), m_freeLayers.end(), a_layer) != m_freeLayers.end())
+  {
+    FLURR_LOG_WARN("Layer %u of texture array %u not allocated!", a_layer, getArrayHandle());
+    return;
+  }
+
+  // Keep the lowest free layer on top, so arrays fill up from the bottom
+  m_freeLayers.insert(std::upper_bound(m_freeLayers.begin(), m_freeLayers.end(), a_layer, std::greater<uint32_t>()), a_layer);
+}
+
+Status TextureArray::uploadLayer(uint32_t a_layer, const uint8_t* a_data, const std::vector<TextureMipLevel>& a_mipLevels)
+{
+  if (!isCreated())
+  {
+    FLURR_LOG_ERROR("Unable to upload texture array layer; array not created yet!");
+    return Status::kInvalidState;
+  }
+
+  if (a_layer >= m_layerCapacity)
+  {
+    FLURR_LOG_ERROR("Texture array layer %u out of bounds!", a_layer);
+    return Status::kIndexOutOfBounds;
+  }
+
+  if (!a_data || a_mipLevels.empty())
+  {
+    FLURR_LOG_ERROR("Unable to upload texture array layer; no texture data!");
+    return Status::kNullArgument;
+  }
+
+  FlurrCore::Get().getRenderer()->getStateCache().bindTexture(GL_TEXTURE_2D_ARRAY, m_oglTexArrayId);
+  if (TextureResource::IsCompressedFormat(m_texFormat))
+  {
+    // Pass stored block-compressed levels through unchanged
+    const std::size_t mipLevelCount = std::min<std::size_t>(a_mipLevels.size(), m_mipLevelCount);
+    for (std::size_t mipLevel = 0; mipLevel < mipLevelCount; ++mipLevel)
+    {
+      const auto& level = a_mipLevels[mipLevel];
+      glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLint>(mipLevel), 0, 0, a_layer, level.width, level.height, 1,
+        m_oglInternalTexFormat, static_cast<GLsizei>(level.size), a_data + level.offset);
+    }
+  }
+  else
+  {
+    // Upload base level; mips are regenerated for the whole array
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, a_layer, m_texWidth, m_texHeight, 1, m_oglTexFormat, GL_UNSIGNED_BYTE, a_data);
+    if (m_mipLevelCount > 1)
+      glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+  }
+
+  return Status::kSuccess;
+}
+
+} // namespace flurr
@@ -0,0 +1,350 @@
+#include "flurr/renderer/TextureUploader.h"
+#include "flurr/FlurrCore.h"
+#include "flurr/FlurrLog.h"
+#include "flurr/resource/TextureResource.h"
+#include "flurr/utils/TypeCasts.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace flurr
+{
+
+TextureUploader::TextureUploader()
+  : m_initialized(false),
+  m_stopUploadThread(false)
+{
+}
+
+TextureUploader::~TextureUploader()
+{
+  // OGL objects are released in shutdown; only make sure the thread is not left running
+  m_stopUploadThread = true;
+  if (m_uploadThread.joinable())
+    m_uploadThread.join();
+}
+
+void TextureUploader::init()
+{
+  if (m_initialized)
+    return;
+
+  m_stopUploadThread = false;
+  m_uploadThread = std::thread(&TextureUploader::uploadThread, this);
+  m_initialized = true;
+}
+
+void TextureUploader::shutdown()
+{
+  if (!m_initialized)
+    return;
+
+  // Stop upload thread, so nothing writes into mapped PBOs anymore
+  m_stopUploadThread = true;
+  if (m_uploadThread.joinable())
+    m_uploadThread.join();
+  m_copyJobQueue.clear();
+  m_copyResultQueue.clear();
+
+  // Release PBOs and fences of unfinished uploads
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+  for (auto& upload : m_uploads)
+  {
+    if (UploadState::kCopying == upload.state)
+    {
+      stateCache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pixelBuffers[upload.pixelBufferIndex].oglBufferId);
+      glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    }
+    else if (UploadState::kTransferring == upload.state)
+    {
+      glDeleteSync(upload.oglFence);
+    }
+  }
+  stateCache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  m_uploads.clear();
+
+  for (auto& pixelBuffer : m_pixelBuffers)
+  {
+    glDeleteBuffers(1, &pixelBuffer.oglBufferId);
+    stateCache.onBufferDeleted(pixelBuffer.oglBufferId);
+  }
+  m_pixelBuffers.clear();
+
+  m_initialized = false;
+}
+
+void TextureUploader::update()
+{
+  if (!m_initialized)
+    return;
+
+  // Submit GPU copies for textures the upload thread has finished writing
+  std::unique_lock<std::mutex> copyResultLock(m_copyResultMutex);
+  std::swap(m_copyResultQueue, m_activeCopyResults);
+  copyResultLock.unlock();
+  for (const auto& copyResult : m_activeCopyResults)
+  {
+    auto* upload = findUpload(copyResult.texHandle);
+    if (upload && UploadState::kCopying == upload->state)
+      finishCopy(*upload, copyResult.status);
+  }
+  m_activeCopyResults.clear();
+
+  // Complete uploads whose GPU copies have finished, without waiting for the others
+  auto* renderer = FlurrCore::Get().getRenderer();
+  for (auto& upload : m_uploads)
+  {
+    if (UploadState::kTransferring != upload.state)
+      continue;
+
+    GLenum waitResult = glClientWaitSync(upload.oglFence, 0, 0);
+    if (GL_ALREADY_SIGNALED != waitResult && GL_CONDITION_SATISFIED != waitResult)
+      continue;
+
+    glDeleteSync(upload.oglFence);
+    upload.oglFence = nullptr;
+    releasePixelBuffer(upload.pixelBufferIndex);
+    if (!upload.cancelled)
+    {
+      auto* texture = renderer->getTexture(upload.texHandle);
+      if (texture)
+        texture->onUploadComplete();
+    }
+    upload.pixelBufferIndex = kInvalidPixelBufferIndex;
+    upload.state = UploadState::kDone;
+  }
+  m_uploads.erase(std::remove_if(m_uploads.begin(), m_uploads.end(),
+    [](const Upload& a_upload) { return UploadState::kDone == a_upload.state; }),
+    m_uploads.end());
+
+  // Start queued uploads in order while PBOs are available
+  for (auto& upload : m_uploads)
+  {
+    if (UploadState::kQueued != upload.state)
+      continue;
+
+    if (!startUpload(upload))
+      break;
+  }
+}
+
+Status TextureUploader::queueUpload(FlurrHandle a_texHandle, FlurrHandle a_texResourceHandle, std::size_t a_dataSize)
+{
+  if (!m_initialized)
+  {
+    FLURR_LOG_ERROR("Texture uploader not initialized!");
+    return Status::kNotInitialized;
+  }
+
+  if (findUpload(a_texHandle))
+  {
+    FLURR_LOG_ERROR("Upload for texture %u already queued!", a_texHandle);
+    return Status::kInvalidState;
+  }
+
+  if (0 == a_dataSize)
+  {
+    FLURR_LOG_ERROR("Unable to upload empty texture %u!", a_texHandle);
+    return Status::kInvalidArgument;
+  }
+
+  m_uploads.push_back(Upload{a_texHandle, a_texResourceHandle, a_dataSize, UploadState::kQueued, kInvalidPixelBufferIndex, nullptr, false});
+  return Status::kSuccess;
+}
+
+void TextureUploader::cancelUpload(FlurrHandle a_texHandle)
+{
+  auto* upload = findUpload(a_texHandle);
+  if (!upload)
+    return;
+
+  // Queued uploads own no resources yet; others are cleaned up when their PBO is done
+  if (UploadState::kQueued == upload->state)
+    m_uploads.erase(m_uploads.begin() + (upload - m_uploads.data()));
+  else
+    upload->cancelled = true;
+}
+
+bool TextureUploader::startUpload(Upload& a_upload)
+{
+  std::size_t pixelBufferIndex = acquirePixelBuffer(a_upload.dataSize);
+  if (kInvalidPixelBufferIndex == pixelBufferIndex)
+    return false;
+
+  // Map PBO for the upload thread to write into; the mapping stays valid after unbinding
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+  stateCache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pixelBuffers[pixelBufferIndex].oglBufferId);
+  void* dst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, a_upload.dataSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+  stateCache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  if (!dst)
+  {
+    FLURR_LOG_ERROR("Failed to map pixel buffer for texture %u!", a_upload.texHandle);
+    releasePixelBuffer(pixelBufferIndex);
+    return false;
+  }
+  a_upload.pixelBufferIndex = pixelBufferIndex;
+  a_upload.state = UploadState::kCopying;
+
+  // Hand the copy over to the upload thread
+  std::lock_guard<std::mutex> copyJobLock(m_copyJobMutex);
+  m_copyJobQueue.push_back(CopyJob{a_upload.texHandle, a_upload.texResourceHandle, dst, a_upload.dataSize});
+
+  return true;
+}
+
+void TextureUploader::finishCopy(Upload& a_upload, Status a_copyStatus)
+{
+  // Unmap PBO; contents may be lost (e.g. on display mode change), in which case retry
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+  const GLuint oglBufferId = m_pixelBuffers[a_upload.pixelBufferIndex].oglBufferId;
+  stateCache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, oglBufferId);
+  const bool unmapped = GL_TRUE == glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+  stateCache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  if (!unmapped && Status::kSuccess == a_copyStatus && !a_upload.cancelled)
+  {
+    FLURR_LOG_WARN("Pixel buffer contents lost for texture %u, retrying upload.", a_upload.texHandle);
+    releasePixelBuffer(a_upload.pixelBufferIndex);
+    a_upload.pixelBufferIndex = kInvalidPixelBufferIndex;
+    a_upload.state = UploadState::kQueued;
+    return;
+  }
+
+  auto* texture = FlurrCore::Get().getRenderer()->getTexture(a_upload.texHandle);
+  if (Status::kSuccess != a_copyStatus || a_upload.cancelled || !texture)
+  {
+    if (Status::kSuccess != a_copyStatus && !a_upload.cancelled)
+      FLURR_LOG_ERROR("Failed to upload texture %u (status %u)!", a_upload.texHandle, FromEnum(a_copyStatus));
+    releasePixelBuffer(a_upload.pixelBufferIndex);
+    a_upload.pixelBufferIndex = kInvalidPixelBufferIndex;
+    a_upload.state = UploadState::kDone;
+    return;
+  }
+
+  // Copy PBO into texture on the GPU and fence it, so we know when the PBO is free
+  texture->uploadFromPixelBuffer(oglBufferId);
+  a_upload.oglFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  a_upload.state = UploadState::kTransferring;
+}
+
+std::size_t TextureUploader::acquirePixelBuffer(std::size_t a_dataSize)
+{
+  // Prefer the smallest free PBO that fits
+  std::size_t pixelBufferIndex = kInvalidPixelBufferIndex;
+  std::size_t freePixelBufferIndex = kInvalidPixelBufferIndex;
+  for (std::size_t bufferIndex = 0; bufferIndex < m_pixelBuffers.size(); ++bufferIndex)
+  {
+    const auto& pixelBuffer = m_pixelBuffers[bufferIndex];
+    if (pixelBuffer.inUse)
+      continue;
+
+    freePixelBufferIndex = bufferIndex;
+    if (pixelBuffer.size >= a_dataSize &&
+      (kInvalidPixelBufferIndex == pixelBufferIndex || pixelBuffer.size < m_pixelBuffers[pixelBufferIndex].size))
+    {
+      pixelBufferIndex = bufferIndex;
+    }
+  }
+
+  auto& stateCache = FlurrCore::Get().getRenderer()->getStateCache();
+  if (kInvalidPixelBufferIndex == pixelBufferIndex)
+  {
+    if (m_pixelBuffers.size() < kMaxPixelBufferCount)
+    {
+      // Grow the pool
+      PixelBuffer pixelBuffer{0, 0, false};
+      glGenBuffers(1, &pixelBuffer.oglBufferId);
+      m_pixelBuffers.push_back(pixelBuffer);
+      pixelBufferIndex = m_pixelBuffers.size() - 1;
+    }
+    else if (kInvalidPixelBufferIndex != freePixelBufferIndex)
+    {
+      // Pool is full, so resize a free PBO that is too small
+      pixelBufferIndex = freePixelBufferIndex;
+    }
+    else
+    {
+      return kInvalidPixelBufferIndex;
+    }
+
+    auto& pixelBuffer = m_pixelBuffers[pixelBufferIndex];
+    stateCache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer.oglBufferId);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, a_dataSize, nullptr, GL_STREAM_DRAW);
+    stateCache.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    pixelBuffer.size = a_dataSize;
+  }
+
+  m_pixelBuffers[pixelBufferIndex].inUse = true;
+  return pixelBufferIndex;
+}
+
+void TextureUploader::releasePixelBuffer(std::size_t a_pixelBufferIndex)
+{
+  if (a_pixelBufferIndex < m_pixelBuffers.size())
+    m_pixelBuffers[a_pixelBufferIndex].inUse = false;
+}
+
+TextureUploader::Upload* TextureUploader::findUpload(FlurrHandle a_texHandle)
+{
+  for (auto& upload : m_uploads)
+    if (upload.texHandle == a_texHandle && UploadState::kDone != upload.state)
+      return &upload;
+
+  return nullptr;
+}
+
+void TextureUploader::uploadThread()
+{
+  bool running = true;
+  while (running)
+  {
+    // This will be the last run of the upload thread
+    if (m_stopUploadThread)
+      running = false;
+
+    // Execute copy jobs
+    std::unique_lock<std::mutex> copyJobLock(m_copyJobMutex);
+    if (!m_copyJobQueue.empty())
+    {
+      // Get copy job queue
+      std::swap(m_copyJobQueue, m_activeCopyJobs);
+      copyJobLock.unlock();
+
+      for (const auto& copyJob : m_activeCopyJobs)
+      {
+        Status copyStatus = executeCopyJob(copyJob);
+
+        // Add copy result to queue
+        std::lock_guard<std::mutex> copyResultLock(m_copyResultMutex);
+        m_copyResultQueue.push_back(CopyResult{copyJob.texHandle, copyStatus});
+      }
+      m_activeCopyJobs.clear();
+    }
+    else
+    {
+      copyJobLock.unlock();
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(kUploadThreadSleepTime));
+  }
+}
+
+Status TextureUploader::executeCopyJob(const CopyJob& a_job)
+{
+  // Ensure the texture resource is still loaded and matches the PBO size
+  auto* resourceManager = FlurrCore::Get().getResourceManager();
+  Resource* resource = nullptr;
+  auto resourceLock = resourceManager->lockAndGetResource(&resource, a_job.texResourceHandle);
+  if (!resource || ResourceType::kTexture != resource->getResourceType())
+    return Status::kResourceNotCreated;
+  if (ResourceState::kLoaded != resource->getResourceState())
+    return Status::kResourceNotLoaded;
+  auto* texResource = static_cast<TextureResource*>(resource);
+  if (texResource->getTextureDataSize() != a_job.dataSize)
+    return Status::kInvalidState;
+
+  std::memcpy(a_job.dst, texResource->getTextureData(), a_job.dataSize);
+  return Status::kSuccess;
+}
+
+} // namespace flurr
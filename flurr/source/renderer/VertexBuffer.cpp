@@ -1,6 +1,10 @@
 #include "flurr/renderer/VertexBuffer.h"
+#include "flurr/FlurrCore.h"
 #include "flurr/FlurrLog.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace flurr
 {
 
@@ -10,13 +14,19 @@ VertexBuffer::VertexBuffer(FlurrHandle a_bufferHandle)
   m_dataSize(0),
   m_attributeSize(0),
   m_dataUsage(VertexDataUsage::kStatic),
+  m_indexType(IndexType::kUnsigned32),
+  m_maxIndex(0),
+  m_mapped(false),
+  m_streamHead(0),
+  m_streamUsedSize(0),
+  m_streamUnfencedSize(0),
   m_oglVboId(0)
 {
 }
 
-Status VertexBuffer::initBuffer(VertexBufferType a_bufferType, std::size_t a_dataSize, void* a_data, std::size_t a_attributeSize, VertexDataUsage a_dataUsage)
+Status VertexBuffer::setBufferProperties(VertexBufferType a_bufferType, std::size_t a_dataSize, const void* a_data, std::size_t a_attributeSize, VertexDataUsage a_dataUsage)
 {
-  if (nullptr == a_data)
+  if (nullptr == a_data && VertexDataUsage::kStream != a_dataUsage)
   {
     FLURR_LOG_ERROR("data cannot be null!");
     return Status::kNullArgument;
@@ -34,7 +44,7 @@ Status VertexBuffer::initBuffer(VertexBufferType a_bufferType, std::size_t a_dat
     return Status::kInvalidArgument;
   }
 
-  if (m_oglVboId)
+  if (isCreated())
   {
     FLURR_LOG_ERROR("Vertex buffer already created!");
     return Status::kInvalidState;
@@ -46,8 +56,64 @@ Status VertexBuffer::initBuffer(VertexBufferType a_bufferType, std::size_t a_dat
   m_dataSize = a_dataSize;
   m_attributeSize = a_attributeSize;
 
+  return Status::kSuccess;
+}
+
+Status VertexBuffer::setIndexBufferProperties(std::size_t a_dataSize, const void* a_data, VertexDataUsage a_dataUsage, IndexType a_indexType)
+{
+  if (a_dataSize % sizeof(uint32_t) != 0)
+  {
+    FLURR_LOG_ERROR("Index data size must be a multiple of %u!", static_cast<uint32_t>(sizeof(uint32_t)));
+    return Status::kInvalidArgument;
+  }
+
+  // Find the largest index, to check if 16-bit indices suffice
+  const auto* indices = static_cast<const uint32_t*>(a_data);
+  const std::size_t indexCount = a_dataSize / sizeof(uint32_t);
+  uint32_t maxIndex = 0;
+  if (indices)
+  {
+    for (std::size_t index = 0; index < indexCount; ++index)
+      maxIndex = std::max(maxIndex, indices[index]);
+  }
+
+  // Determine index type; only static buffers are converted automatically, since updates could exceed 16 bits
+  IndexType indexType = a_indexType;
+  if (IndexType::kAuto == indexType)
+    indexType = indices && VertexDataUsage::kStatic == a_dataUsage && maxIndex <= UINT16_MAX ? IndexType::kUnsigned16 : IndexType::kUnsigned32;
+  else if (IndexType::kUnsigned16 == indexType && maxIndex > UINT16_MAX)
+  {
+    FLURR_LOG_ERROR("Index %u does not fit into a 16-bit index buffer!", maxIndex);
+    return Status::kInvalidArgument;
+  }
+
+  const std::size_t indexSize = IndexType::kUnsigned16 == indexType ? sizeof(uint16_t) : sizeof(uint32_t);
+  auto result = setBufferProperties(VertexBufferType::kIndex, indexCount * indexSize, a_data, indexSize, a_dataUsage);
+  if (result == Status::kSuccess)
+  {
+    m_indexType = indexType;
+    m_maxIndex = maxIndex;
+  }
+
+  return result;
+}
+
+Status VertexBuffer::initBuffer(const void* a_data)
+{
+  if (!isCreated())
+  {
+    FLURR_LOG_ERROR("Unable to create vertex buffer; buffer properties not set!");
+    return Status::kInvalidState;
+  }
+
+  if (m_oglVboId)
+  {
+    FLURR_LOG_ERROR("Vertex buffer already created!");
+    return Status::kInvalidState;
+  }
+
   // Determine OGL buffer type
-  GLenum oglBufferType = getBufferType() == VertexBufferType::kVertexAttribute ?
+  GLenum oglBufferType = getBufferType() != VertexBufferType::kIndex ?
     GL_ARRAY_BUFFER : GL_ELEMENT_ARRAY_BUFFER;
 
   // Determine OGL buffer usage
@@ -60,27 +126,44 @@ Status VertexBuffer::initBuffer(VertexBufferType a_bufferType, std::size_t a_dat
   case VertexDataUsage::kDynamic:
     oglDataUsage = GL_DYNAMIC_DRAW;
     break;
+  case VertexDataUsage::kStream:
+    oglDataUsage = GL_STREAM_DRAW;
+    break;
   default:
     FLURR_ASSERT(false, "Unsupported OGL vertex buffer usage!");
     return Status::kFailed;
   }
 
+  // Index data is supplied as 32-bit indices, convert it for 16-bit buffers
+  std::vector<uint16_t> shortIndices;
+  if (VertexBufferType::kIndex == getBufferType() && IndexType::kUnsigned16 == m_indexType && a_data)
+  {
+    const auto* indices = static_cast<const uint32_t*>(a_data);
+    shortIndices.assign(indices, indices + getIndexCount());
+    a_data = shortIndices.data();
+  }
+
   // Create OGL buffer and fill it with data
   glGenBuffers(1, &m_oglVboId);
-  glBindBuffer(oglBufferType, m_oglVboId);
+  FlurrCore::Get().getRenderer()->getStateCache().bindBuffer(oglBufferType, m_oglVboId);
   glBufferData(oglBufferType, getDataSize(), a_data, oglDataUsage);
 
   return Status::kSuccess;
 }
 
-Status VertexBuffer::initIndexBuffer(std::size_t a_dataSize, void* a_data, VertexDataUsage a_dataUsage) {
-  return initBuffer(VertexBufferType::kIndex, a_dataSize, a_data, sizeof(uint32_t), a_dataUsage);
-}
-
 void VertexBuffer::destroyBuffer()
 {
+  if (m_mapped)
+    unmapTransient();
+  destroyFences();
+  m_streamHead = m_streamUsedSize = m_streamUnfencedSize = 0;
+
   if (m_oglVboId)
+  {
     glDeleteBuffers(1, &m_oglVboId);
+    FlurrCore::Get().getRenderer()->getStateCache().onBufferDeleted(m_oglVboId);
+    m_oglVboId = 0;
+  }
 
   m_dataSize = 0;
 }
@@ -93,11 +176,173 @@ Status VertexBuffer::useBuffer()
     return Status::kInvalidState;
   }
 
-  GLenum oglBufferType = getBufferType() == VertexBufferType::kVertexAttribute ?
+  GLenum oglBufferType = getBufferType() != VertexBufferType::kIndex ?
     GL_ARRAY_BUFFER : GL_ELEMENT_ARRAY_BUFFER;
-  glBindBuffer(oglBufferType, m_oglVboId);
+  FlurrCore::Get().getRenderer()->getStateCache().bindBuffer(oglBufferType, m_oglVboId);
 
   return Status::kSuccess;
 }
 
+Status VertexBuffer::prepareUpdate(const void* a_data, std::size_t a_dataSize, std::size_t a_offset)
+{
+  if (!isCreated())
+  {
+    FLURR_LOG_ERROR("Unable to update vertex buffer; not created yet!");
+    return Status::kInvalidState;
+  }
+
+  if (nullptr == a_data)
+  {
+    FLURR_LOG_ERROR("data cannot be null!");
+    return Status::kNullArgument;
+  }
+
+  if (a_offset + a_dataSize > getDataSize())
+  {
+    FLURR_LOG_ERROR("Unable to update vertex buffer; data out of bounds!");
+    return Status::kIndexOutOfBounds;
+  }
+
+  // Track largest index for bounds checks
+  if (VertexBufferType::kIndex == getBufferType())
+  {
+    if (IndexType::kUnsigned16 == m_indexType)
+    {
+      const auto* indices = static_cast<const uint16_t*>(a_data);
+      for (std::size_t index = 0; index < a_dataSize / sizeof(uint16_t); ++index)
+        m_maxIndex = std::max<uint32_t>(m_maxIndex, indices[index]);
+    }
+    else
+    {
+      const auto* indices = static_cast<const uint32_t*>(a_data);
+      for (std::size_t index = 0; index < a_dataSize / sizeof(uint32_t); ++index)
+        m_maxIndex = std::max(m_maxIndex, indices[index]);
+    }
+  }
+
+  return Status::kSuccess;
+}
+
+Status VertexBuffer::updateData(const void* a_data, std::size_t a_dataSize, std::size_t a_offset)
+{
+  if (!m_oglVboId)
+  {
+    FLURR_LOG_ERROR("Unable to update vertex buffer; not created yet!");
+    return Status::kInvalidState;
+  }
+
+  // Overwrite buffer data
+  GLenum oglBufferType = getBufferType() != VertexBufferType::kIndex ?
+    GL_ARRAY_BUFFER : GL_ELEMENT_ARRAY_BUFFER;
+  FlurrCore::Get().getRenderer()->getStateCache().bindBuffer(oglBufferType, m_oglVboId);
+  glBufferSubData(oglBufferType, a_offset, a_dataSize, a_data);
+
+  return Status::kSuccess;
+}
+
+Status VertexBuffer::mapTransient(std::size_t a_dataSize, void** a_writePtr, std::size_t& a_offset)
+{
+  if (!isCreated() || VertexDataUsage::kStream != getDataUsage())
+  {
+    FLURR_LOG_ERROR("Unable to allocate transient data; not a stream buffer!");
+    return Status::kInvalidState;
+  }
+
+  if (m_mapped)
+  {
+    FLURR_LOG_ERROR("Unable to allocate transient data; previous allocation not committed!");
+    return Status::kInvalidState;
+  }
+
+  // Align allocation to attribute size, so the offset can be converted to a vertex index
+  const std::size_t capacity = getDataSize();
+  std::size_t offset = (m_streamHead + m_attributeSize - 1) / m_attributeSize * m_attributeSize;
+  if (offset + a_dataSize > capacity)
+    offset = 0; // wrap around
+  const std::size_t allocatedSize = (offset >= m_streamHead ? offset - m_streamHead : capacity - m_streamHead + offset) + a_dataSize;
+  if (a_dataSize == 0 || allocatedSize > capacity)
+  {
+    FLURR_LOG_ERROR("Unable to allocate %u bytes of transient data; stream buffer capacity is %u!",
+      static_cast<uint32_t>(a_dataSize), static_cast<uint32_t>(capacity));
+    return Status::kInvalidArgument;
+  }
+
+  // Wait for the GPU to finish reading the oldest data, until there is enough free space
+  while (capacity - m_streamUsedSize < allocatedSize)
+  {
+    if (m_streamFences.empty())
+    {
+      FLURR_LOG_ERROR("Unable to allocate transient data; stream buffer full within a single frame!");
+      return Status::kFailed;
+    }
+
+    const auto& fence = m_streamFences.front();
+    GLenum waitResult = glClientWaitSync(fence.oglSync, GL_SYNC_FLUSH_COMMANDS_BIT, kStreamFenceTimeout);
+    if (GL_TIMEOUT_EXPIRED == waitResult || GL_WAIT_FAILED == waitResult)
+    {
+      FLURR_LOG_ERROR("Unable to allocate transient data; failed waiting for the GPU!");
+      return Status::kFailed;
+    }
+    glDeleteSync(fence.oglSync);
+    m_streamUsedSize -= fence.allocatedSize;
+    m_streamFences.pop_front();
+  }
+
+  // Map the allocated range without synchronization; fences guarantee the GPU is not using it
+  FlurrCore::Get().getRenderer()->getStateCache().bindBuffer(GL_ARRAY_BUFFER, m_oglVboId);
+  void* writePtr = glMapBufferRange(GL_ARRAY_BUFFER, offset, a_dataSize,
+    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+  if (!writePtr)
+  {
+    FLURR_LOG_ERROR("Unable to allocate transient data; failed to map buffer range!");
+    return Status::kFailed;
+  }
+
+  m_streamHead = offset + a_dataSize;
+  m_streamUsedSize += allocatedSize;
+  m_streamUnfencedSize += allocatedSize;
+  m_mapped = true;
+  *a_writePtr = writePtr;
+  a_offset = offset;
+
+  return Status::kSuccess;
+}
+
+Status VertexBuffer::unmapTransient()
+{
+  if (!m_mapped)
+  {
+    FLURR_LOG_ERROR("Unable to commit transient data; nothing allocated!");
+    return Status::kInvalidState;
+  }
+
+  FlurrCore::Get().getRenderer()->getStateCache().bindBuffer(GL_ARRAY_BUFFER, m_oglVboId);
+  const bool dataValid = GL_TRUE == glUnmapBuffer(GL_ARRAY_BUFFER);
+  m_mapped = false;
+  if (!dataValid)
+  {
+    FLURR_LOG_ERROR("Transient vertex data corrupted while mapped!");
+    return Status::kFailed;
+  }
+
+  return Status::kSuccess;
+}
+
+void VertexBuffer::fenceTransients()
+{
+  if (0 == m_streamUnfencedSize)
+    return;
+
+  // Fence data allocated since the previous fence
+  m_streamFences.push_back(StreamFence{glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), m_streamUnfencedSize});
+  m_streamUnfencedSize = 0;
+}
+
+void VertexBuffer::destroyFences()
+{
+  for (const auto& fence : m_streamFences)
+    glDeleteSync(fence.oglSync);
+  m_streamFences.clear();
+}
+
 } // namespace flurr
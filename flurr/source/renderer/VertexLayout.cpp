@@ -0,0 +1,139 @@
+#include "flurr/renderer/VertexLayout.h"
+#include "flurr/FlurrLog.h"
+
+#include <algorithm>
+
+namespace flurr
+{
+
+std::size_t VertexLayout::GetAttributeTypeSize(VertexAttributeType a_type, uint32_t a_componentCount)
+{
+  switch (a_type)
+  {
+  case VertexAttributeType::kFloat:
+    return a_componentCount * sizeof(GLfloat);
+  case VertexAttributeType::kHalfFloat:
+    return a_componentCount * sizeof(GLhalf);
+  case VertexAttributeType::kByte:
+  case VertexAttributeType::kUnsignedByte:
+    return a_componentCount * sizeof(GLubyte);
+  case VertexAttributeType::kShort:
+  case VertexAttributeType::kUnsignedShort:
+    return a_componentCount * sizeof(GLushort);
+  case VertexAttributeType::kInt2_10_10_10:
+  case VertexAttributeType::kUnsignedInt2_10_10_10:
+    return sizeof(GLuint);
+  default:
+    return 0;
+  }
+}
+
+GLenum VertexLayout::GetOGLAttributeType(VertexAttributeType a_type)
+{
+  switch (a_type)
+  {
+  case VertexAttributeType::kFloat:
+    return GL_FLOAT;
+  case VertexAttributeType::kHalfFloat:
+    return GL_HALF_FLOAT;
+  case VertexAttributeType::kByte:
+    return GL_BYTE;
+  case VertexAttributeType::kUnsignedByte:
+    return GL_UNSIGNED_BYTE;
+  case VertexAttributeType::kShort:
+    return GL_SHORT;
+  case VertexAttributeType::kUnsignedShort:
+    return GL_UNSIGNED_SHORT;
+  case VertexAttributeType::kInt2_10_10_10:
+    return GL_INT_2_10_10_10_REV;
+  case VertexAttributeType::kUnsignedInt2_10_10_10:
+    return GL_UNSIGNED_INT_2_10_10_10_REV;
+  default:
+    return GL_FLOAT;
+  }
+}
+
+VertexLayout& VertexLayout::addAttribute(GLuint a_location, VertexAttributeType a_type, uint32_t a_componentCount, bool a_normalized, uint32_t a_streamIndex)
+{
+  // Pack after the last attribute in the same stream
+  return addAttribute(a_location, a_type, a_componentCount, a_normalized, a_streamIndex, getStreamPackedSize(a_streamIndex));
+}
+
+VertexLayout& VertexLayout::addAttribute(GLuint a_location, VertexAttributeType a_type, uint32_t a_componentCount, bool a_normalized, uint32_t a_streamIndex, std::size_t a_offset)
+{
+  if (a_streamIndex >= m_streamStrides.size())
+    m_streamStrides.resize(a_streamIndex + 1, 0);
+  m_attributes.push_back(VertexAttribute{a_location, a_type, a_componentCount, a_normalized, a_streamIndex, a_offset});
+
+  return *this;
+}
+
+void VertexLayout::setStreamStride(uint32_t a_streamIndex, std::size_t a_stride)
+{
+  if (a_streamIndex >= m_streamStrides.size())
+    m_streamStrides.resize(a_streamIndex + 1, 0);
+  m_streamStrides[a_streamIndex] = a_stride;
+}
+
+std::size_t VertexLayout::getStreamStride(uint32_t a_streamIndex) const
+{
+  return a_streamIndex < m_streamStrides.size() ? m_streamStrides[a_streamIndex] : 0;
+}
+
+std::size_t VertexLayout::getStreamPackedSize(uint32_t a_streamIndex) const
+{
+  std::size_t packedSize = 0;
+  for (const auto& attribute : m_attributes)
+  {
+    if (attribute.streamIndex == a_streamIndex)
+      packedSize = std::max(packedSize, attribute.offset + GetAttributeTypeSize(attribute.type, attribute.componentCount));
+  }
+
+  return packedSize;
+}
+
+Status VertexLayout::validate() const
+{
+  for (std::size_t attributeIndex = 0; attributeIndex < m_attributes.size(); ++attributeIndex)
+  {
+    const auto& attribute = m_attributes[attributeIndex];
+    if (attribute.componentCount < 1 || attribute.componentCount > 4)
+    {
+      FLURR_LOG_ERROR("Vertex attribute at location %u must have 1 to 4 components!", attribute.location);
+      return Status::kInvalidArgument;
+    }
+
+    if ((VertexAttributeType::kInt2_10_10_10 == attribute.type || VertexAttributeType::kUnsignedInt2_10_10_10 == attribute.type) &&
+      4 != attribute.componentCount)
+    {
+      FLURR_LOG_ERROR("Packed vertex attribute at location %u must have 4 components!", attribute.location);
+      return Status::kInvalidArgument;
+    }
+
+    if (attribute.offset % 4 != 0)
+    {
+      FLURR_LOG_ERROR("Vertex attribute at location %u must be 4-byte aligned!", attribute.location);
+      return Status::kInvalidArgument;
+    }
+
+    const std::size_t stride = getStreamStride(attribute.streamIndex);
+    if (stride > 0 && attribute.offset + GetAttributeTypeSize(attribute.type, attribute.componentCount) > stride)
+    {
+      FLURR_LOG_ERROR("Vertex attribute at location %u exceeds stream stride!", attribute.location);
+      return Status::kInvalidArgument;
+    }
+
+    for (std::size_t prevAttributeIndex = 0; prevAttributeIndex < attributeIndex; ++prevAttributeIndex)
+    {
+      if (m_attributes[prevAttributeIndex].location == attribute.location)
+      {
+        FLURR_LOG_ERROR("Vertex attribute location %u used more than once!", attribute.location);
+        return Status::kInvalidArgument;
+      }
+    }
+  }
+
+  return Status::kSuccess;
+}
+
+} // namespace flurr
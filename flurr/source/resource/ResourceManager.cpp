@@ -12,8 +12,7 @@ namespace flurr
 
 ResourceManager::ResourceManager()
   : m_running(false),
-  m_stopResourceThread(false),
-  m_nextResourceHandle(1)
+  m_stopResourceThread(false)
 {
 }
 
@@ -90,7 +89,7 @@ Status ResourceManager::createResource(FlurrHandle& a_resourceHandle, ResourceTy
   // Try to create resource
   std::lock_guard<std::mutex> resourceLock(m_resourceMutex);
   const auto&& resourceHandleIt = m_resourceHandlesByPath.find(a_resourcePath);
-  Resource* resource = resourceHandleIt != m_resourceHandlesByPath.end() ? m_resources.at(resourceHandleIt->second).get() : nullptr;
+  Resource* resource = resourceHandleIt != m_resourceHandlesByPath.end() ? m_resources.get(resourceHandleIt->second)->get() : nullptr;
   if (resource)
   {
     FLURR_LOG_ERROR("Unable to create resource %s; resource already exists!", a_resourcePath.c_str());
@@ -103,11 +102,10 @@ Status ResourceManager::createResource(FlurrHandle& a_resourceHandle, ResourceTy
     if (findResourceResult.resourceFound)
     {
       // Resource file found, create resource
-      auto* resource = createResourceOfType(a_resourceType, m_nextResourceHandle, a_resourcePath, findResourceResult.resourceDirectoryIndex);
-      m_resources[resource->getResourceHandle()] = std::unique_ptr<Resource>(resource);
+      auto* resource = createResourceOfType(a_resourceType, m_resources.getNextHandle(), a_resourcePath, findResourceResult.resourceDirectoryIndex);
+      m_resources.insert(std::unique_ptr<Resource>(resource));
       m_resourceHandlesByPath[a_resourcePath] = resource->getResourceHandle();
       resource->setResourceState(ResourceState::kCreated);
-      ++m_nextResourceHandle;
 
       FLURR_LOG_DEBUG("Resource %u (%s) created successfully (resolved at %s).", resource->getResourceHandle(), a_resourcePath.c_str(), findResourceResult.fullResourcePath.c_str());
       a_resourceHandle = resource->getResourceHandle();
@@ -170,8 +168,7 @@ Status ResourceManager::destroyResource(FlurrHandle a_resourceHandle)
 
   // Try to destroy the resource
   std::unique_lock<std::mutex> allResourcesLock(m_resourceMutex);
-  const auto&& resourceIt = m_resources.find(a_resourceHandle);
-  Resource* resource = resourceIt != m_resources.end() ? resourceIt->second.get() : nullptr;
+  Resource* resource = getResource(a_resourceHandle);
   if (resource)
   {
     // Mark resource as Destroying to prevent it from getting loaded/unloaded on another thread
@@ -209,9 +206,7 @@ Status ResourceManager::destroyAllResources()
 
   // Get list of resources to destroy
   std::unique_lock<std::mutex> resourceLock(m_resourceMutex);
-  std::vector<FlurrHandle> resourcesToDestroy;
-  for (const auto& resourceKvp : m_resources)
-    resourcesToDestroy.push_back(resourceKvp.first);
+  const std::vector<FlurrHandle> resourcesToDestroy = m_resources.getHandles();
   resourceLock.unlock();
 
   // Destroy the resources
@@ -229,7 +224,7 @@ Status ResourceManager::destroyAllResources()
 bool ResourceManager::hasResource(FlurrHandle a_resourceHandle) const
 {
   std::lock_guard<std::mutex> resourceLock(m_resourceMutex);
-  return m_resources.find(a_resourceHandle) != m_resources.end();
+  return m_resources.contains(a_resourceHandle);
 }
 
 bool ResourceManager::hasResource(const std::string& a_resourcePath) const
@@ -255,17 +250,15 @@ std::unique_lock<std::mutex> ResourceManager::lockAndGetResource(Resource** a_re
 
 Resource* ResourceManager::getResource(FlurrHandle a_resourceHandle) const
 {
-  const auto&& resourceIt = m_resources.find(a_resourceHandle);
-  return (resourceIt != m_resources.end()) ?
-    resourceIt->second.get() :
-    nullptr;
+  const auto* resource = m_resources.get(a_resourceHandle);
+  return resource ? resource->get() : nullptr;
 }
 
 Resource* ResourceManager::getResource(const std::string& a_resourcePath) const
 {
   const auto&& resourceHandleIt = m_resourceHandlesByPath.find(a_resourcePath);
   return (resourceHandleIt != m_resourceHandlesByPath.end()) ?
-    m_resources.find(resourceHandleIt->second)->second.get() :
+    m_resources.get(resourceHandleIt->second)->get() :
     nullptr;
 }
 
@@ -399,7 +392,6 @@ void ResourceManager::resourceThread()
 
   // Force-delete any remaining resources
   std::lock_guard<std::mutex> resourceLock(m_resourceMutex);
-  m_nextResourceHandle = 1;
   m_resources.clear();
   m_resourceHandlesByPath.clear();
 }
@@ -436,8 +428,7 @@ ResourceOperationResult ResourceManager::executeLoadResource(FlurrHandle a_resou
 
   // Try to load resource
   std::unique_lock<std::mutex> allResourcesLock(m_resourceMutex);
-  auto resourceIt = m_resources.find(a_resourceHandle);
-  Resource* resource = resourceIt != m_resources.end() ? resourceIt->second.get() : nullptr;
+  Resource* resource = getResource(a_resourceHandle);
   if (resource)
   {
     if (resource->getResourceState() == ResourceState::kLoaded)
@@ -490,8 +481,7 @@ ResourceOperationResult ResourceManager::executeUnloadResource(FlurrHandle a_res
 
   // Try to unload resource
   std::unique_lock<std::mutex> allResourcesLock(m_resourceMutex);
-  const auto&& resourceIt = m_resources.find(a_resourceHandle);
-  Resource* resource = resourceIt != m_resources.end() ? resourceIt->second.get() : nullptr;
+  Resource* resource = getResource(a_resourceHandle);
   if (resource)
   {
     if (resource->getResourceState() == ResourceState::kCreated)
@@ -22,7 +22,7 @@ Status ShaderResource::onLoad(const std::string& a_fullPath)
     return Status::kOpenFileError;
   }
   m_shaderSource = std::string((std::istreambuf_iterator<char>(ifs)), (std::istreambuf_iterator<char>()));
-  // TODO: add support for precompiled shaders
+  // Precompiled programs are cached by the renderer (see ProgramBinaryCache)
 
   return Status::kSuccess;
 }
@@ -8,13 +8,81 @@ extern "C" {
 #include "stbi_DDS_aug.h"
 }
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
+#include <cstring>
 #include <vector>
 
 namespace flurr
 {
 
+namespace
+{
+
+constexpr uint32_t MakeFourCC(char a_c0, char a_c1, char a_c2, char a_c3)
+{
+  return static_cast<uint32_t>(a_c0) | (static_cast<uint32_t>(a_c1) << 8) |
+    (static_cast<uint32_t>(a_c2) << 16) | (static_cast<uint32_t>(a_c3) << 24);
+}
+
+// DDS file layout: magic, then a 124-byte header (all fields little-endian uint32)
+constexpr uint32_t kDDSMagic = MakeFourCC('D', 'D', 'S', ' ');
+constexpr std::size_t kDDSFileHeaderSize = 128;
+constexpr uint32_t kDDSHeaderSize = 124;
+constexpr uint32_t kDDSFlagMipMapCount = 0x20000;
+constexpr uint32_t kDDSPixelFormatFlagFourCC = 0x4;
+constexpr std::size_t kDDSSizeOffset = 4;
+constexpr std::size_t kDDSFlagsOffset = 8;
+constexpr std::size_t kDDSHeightOffset = 12;
+constexpr std::size_t kDDSWidthOffset = 16;
+constexpr std::size_t kDDSMipMapCountOffset = 28;
+constexpr std::size_t kDDSPixelFormatFlagsOffset = 80;
+constexpr std::size_t kDDSFourCCOffset = 84;
+
+uint32_t ReadUInt32LE(const uint8_t* a_data)
+{
+  return static_cast<uint32_t>(a_data[0]) | (static_cast<uint32_t>(a_data[1]) << 8) |
+    (static_cast<uint32_t>(a_data[2]) << 16) | (static_cast<uint32_t>(a_data[3]) << 24);
+}
+
+// Reverse the first a_rowCount pixel rows of a 4x4 block
+void FlipBlockY(uint8_t* a_block, TextureFormat a_texFormat, uint32_t a_rowCount)
+{
+  // Color block (BC1, or second half of BC2/BC3) stores one byte of 2-bit indices per row
+  uint8_t* colorBlock = TextureFormat::kBC1 == a_texFormat ? a_block : a_block + 8;
+  std::reverse(colorBlock + 4, colorBlock + 4 + a_rowCount);
+
+  if (TextureFormat::kBC2 == a_texFormat)
+  {
+    // Explicit alpha stores 2 bytes of 4-bit alphas per row
+    for (uint32_t rowIndex = 0; rowIndex < a_rowCount/2; ++rowIndex)
+    {
+      std::swap(a_block[2*rowIndex], a_block[2*(a_rowCount-rowIndex-1)]);
+      std::swap(a_block[2*rowIndex + 1], a_block[2*(a_rowCount-rowIndex-1) + 1]);
+    }
+  }
+  else if (TextureFormat::kBC3 == a_texFormat)
+  {
+    // Interpolated alpha stores 48 bits of 3-bit indices after the endpoints, 12 bits per row
+    uint64_t alphaBits = 0;
+    for (int byteIndex = 0; byteIndex < 6; ++byteIndex)
+      alphaBits |= static_cast<uint64_t>(a_block[2 + byteIndex]) << (8*byteIndex);
+    uint64_t flippedAlphaBits = alphaBits;
+    for (uint32_t rowIndex = 0; rowIndex < a_rowCount; ++rowIndex)
+    {
+      const uint64_t row = (alphaBits >> (12*rowIndex)) & 0xFFF;
+      const uint32_t flippedRowIndex = a_rowCount - rowIndex - 1;
+      flippedAlphaBits &= ~(static_cast<uint64_t>(0xFFF) << (12*flippedRowIndex));
+      flippedAlphaBits |= row << (12*flippedRowIndex);
+    }
+    for (int byteIndex = 0; byteIndex < 6; ++byteIndex)
+      a_block[2 + byteIndex] = static_cast<uint8_t>(flippedAlphaBits >> (8*byteIndex));
+  }
+}
+
+} // namespace
+
 TextureResource::TextureResource(FlurrHandle a_resourceHandle, const std::string& a_resourcePath, std::size_t a_resourceDirectoryIndex, ResourceManager* a_owningManager)
   : Resource(a_resourceHandle, a_resourcePath, a_resourceDirectoryIndex, a_owningManager),
   m_texData(nullptr)
@@ -26,6 +94,14 @@ uint32_t TextureResource::getTexelSize() const
   return TexelSize(m_texFormat);
 }
 
+uint32_t TextureResource::getTextureDataSize() const
+{
+  if (isCompressed())
+    return static_cast<uint32_t>(m_compressedTexData.size());
+
+  return m_texWidth*m_texHeight*getTexelSize();
+}
+
 constexpr uint32_t TextureResource::TexelSize(TextureFormat a_texFormat)
 {
   switch (a_texFormat)
@@ -42,6 +118,12 @@ constexpr uint32_t TextureResource::TexelSize(TextureFormat a_texFormat)
     {
       return 4;
     }
+    case TextureFormat::kBC1:
+    case TextureFormat::kBC2:
+    case TextureFormat::kBC3:
+    {
+      return 0;
+    }
     default:
     {
       FLURR_ASSERT(false, "Unhandled texture format %u!", FromEnum(a_texFormat));
@@ -49,6 +131,33 @@ constexpr uint32_t TextureResource::TexelSize(TextureFormat a_texFormat)
   }
 }
 
+uint32_t TextureResource::BlockSize(TextureFormat a_texFormat)
+{
+  switch (a_texFormat)
+  {
+    case TextureFormat::kBC1:
+    {
+      return 8;
+    }
+    case TextureFormat::kBC2:
+    case TextureFormat::kBC3:
+    {
+      return 16;
+    }
+    default:
+    {
+      return 0;
+    }
+  }
+}
+
+std::size_t TextureResource::CompressedLevelSize(TextureFormat a_texFormat, uint32_t a_width, uint32_t a_height)
+{
+  const std::size_t blockCountX = std::max<uint32_t>(1, (a_width + 3)/4);
+  const std::size_t blockCountY = std::max<uint32_t>(1, (a_height + 3)/4);
+  return blockCountX*blockCountY*BlockSize(a_texFormat);
+}
+
 Status TextureResource::onLoad(const std::string& a_fullPath)
 {
   // Make sure it's a supported file extension
@@ -74,6 +183,21 @@ Status TextureResource::onLoad(const std::string& a_fullPath)
       return Status::kOpenFileError;
     }
 
+    // Keep block-compressed data as-is, decompress anything else
+    Status compressedResult = loadCompressedDDS(textureFile, a_fullPath);
+    if (Status::kSuccess == compressedResult)
+    {
+      fclose(textureFile);
+      FlipCompressedY();
+      return Status::kSuccess;
+    }
+    if (Status::kUnsupportedTextureFormat != compressedResult)
+    {
+      fclose(textureFile);
+      return compressedResult;
+    }
+    fseek(textureFile, 0, SEEK_SET);
+
     // Load texture from the file
     m_texData = stbi_dds_load_from_file(textureFile, reinterpret_cast<int*>(&m_texWidth), reinterpret_cast<int*>(&m_texHeight), &numChannels, 0);
     if (!m_texData)
@@ -129,12 +253,97 @@ Status TextureResource::onLoad(const std::string& a_fullPath)
     }
   }
 
+  m_mipLevels.assign(1, TextureMipLevel{m_texWidth, m_texHeight, 0, getTextureDataSize()});
+
   // Flip image around horizontal axis
   FlipY();
 
   return Status::kSuccess;
 }
 
+Status TextureResource::loadCompressedDDS(FILE* a_textureFile, const std::string& a_fullPath)
+{
+  // Read and validate header
+  uint8_t header[kDDSFileHeaderSize];
+  if (1 != fread(header, kDDSFileHeaderSize, 1, a_textureFile) ||
+    kDDSMagic != ReadUInt32LE(header) || kDDSHeaderSize != ReadUInt32LE(header + kDDSSizeOffset))
+  {
+    FLURR_LOG_ERROR("File %s has an invalid .dds header!", a_fullPath.c_str());
+    return Status::kReadFileError;
+  }
+
+  // Only BC1-3 are passed through; other formats are decoded by stb_image
+  if (!(ReadUInt32LE(header + kDDSPixelFormatFlagsOffset) & kDDSPixelFormatFlagFourCC))
+    return Status::kUnsupportedTextureFormat;
+  switch (ReadUInt32LE(header + kDDSFourCCOffset))
+  {
+    case MakeFourCC('D', 'X', 'T', '1'):
+    {
+      m_texFormat = TextureFormat::kBC1;
+      break;
+    }
+    case MakeFourCC('D', 'X', 'T', '3'):
+    {
+      m_texFormat = TextureFormat::kBC2;
+      break;
+    }
+    case MakeFourCC('D', 'X', 'T', '5'):
+    {
+      m_texFormat = TextureFormat::kBC3;
+      break;
+    }
+    default:
+    {
+      return Status::kUnsupportedTextureFormat;
+    }
+  }
+  m_texWidth = ReadUInt32LE(header + kDDSWidthOffset);
+  m_texHeight = ReadUInt32LE(header + kDDSHeightOffset);
+  if (0 == m_texWidth || 0 == m_texHeight)
+  {
+    FLURR_LOG_ERROR("File %s has invalid .dds dimensions!", a_fullPath.c_str());
+    return Status::kReadFileError;
+  }
+  uint32_t mipLevelCount = 1;
+  if (ReadUInt32LE(header + kDDSFlagsOffset) & kDDSFlagMipMapCount)
+    mipLevelCount = std::max<uint32_t>(1, ReadUInt32LE(header + kDDSMipMapCountOffset));
+
+  // Determine mip chain layout
+  m_mipLevels.clear();
+  std::size_t dataSize = 0;
+  uint32_t mipWidth = m_texWidth;
+  uint32_t mipHeight = m_texHeight;
+  for (uint32_t mipLevel = 0; mipLevel < mipLevelCount; ++mipLevel)
+  {
+    const std::size_t mipSize = CompressedLevelSize(m_texFormat, mipWidth, mipHeight);
+    m_mipLevels.push_back(TextureMipLevel{mipWidth, mipHeight, dataSize, mipSize});
+    dataSize += mipSize;
+    if (1 == mipWidth && 1 == mipHeight)
+      break;
+    mipWidth = std::max<uint32_t>(1, mipWidth/2);
+    mipHeight = std::max<uint32_t>(1, mipHeight/2);
+  }
+
+  // Read block data of all levels; drop levels missing from a truncated file
+  m_compressedTexData.resize(dataSize);
+  const std::size_t readSize = fread(m_compressedTexData.data(), 1, dataSize, a_textureFile);
+  while (!m_mipLevels.empty() && m_mipLevels.back().offset + m_mipLevels.back().size > readSize)
+    m_mipLevels.pop_back();
+  if (m_mipLevels.empty())
+  {
+    FLURR_LOG_ERROR("Failed to read texture data from file %s!", a_fullPath.c_str());
+    destroyTextureData();
+    return Status::kReadFileError;
+  }
+  if (m_mipLevels.size() < mipLevelCount)
+    FLURR_LOG_WARN("File %s is truncated, using %u of %u mip levels.", a_fullPath.c_str(),
+      static_cast<uint32_t>(m_mipLevels.size()), mipLevelCount);
+  m_compressedTexData.resize(m_mipLevels.back().offset + m_mipLevels.back().size);
+  m_texData = m_compressedTexData.data();
+
+  return Status::kSuccess;
+}
+
 void TextureResource::onUnload()
 {
   destroyTextureData();
@@ -142,9 +351,12 @@ void TextureResource::onUnload()
 
 void TextureResource::destroyTextureData()
 {
-  if (m_texData)
+  if (m_texData && m_texData != m_compressedTexData.data())
     stbi_image_free(m_texData);
   m_texData = nullptr;
+  m_compressedTexData.clear();
+  m_compressedTexData.shrink_to_fit();
+  m_mipLevels.clear();
   m_texWidth = 0;
   m_texHeight = 0;
 }
@@ -161,4 +373,37 @@ void TextureResource::FlipY()
   }
 }
 
+void TextureResource::FlipCompressedY()
+{
+  // Swap block rows, then flip pixel rows within each block
+  const uint32_t blockSize = BlockSize(m_texFormat);
+  for (const auto& mipLevel : m_mipLevels)
+  {
+    // Rows can only be moved within their blocks, so partial blocks must be the only block row
+    if (mipLevel.height > 4 && 0 != mipLevel.height%4)
+    {
+      FLURR_LOG_WARN("Unable to flip compressed texture level of height %u, leaving it upside down!", mipLevel.height);
+      continue;
+    }
+
+    const uint32_t blockCountX = std::max<uint32_t>(1, (mipLevel.width + 3)/4);
+    const uint32_t blockCountY = std::max<uint32_t>(1, (mipLevel.height + 3)/4);
+    const uint32_t blockRowSize = blockCountX*blockSize;
+    uint8_t* levelData = m_texData + mipLevel.offset;
+    std::vector<uint8_t> tempBlockRow(blockRowSize, 0);
+    for (uint32_t blockRowIndex = 0; blockRowIndex < blockCountY/2; ++blockRowIndex)
+    {
+      uint8_t* blockRow = levelData + blockRowIndex*blockRowSize;
+      uint8_t* flippedBlockRow = levelData + (blockCountY-blockRowIndex-1)*blockRowSize;
+      memcpy(tempBlockRow.data(), blockRow, blockRowSize);
+      memcpy(blockRow, flippedBlockRow, blockRowSize);
+      memcpy(flippedBlockRow, tempBlockRow.data(), blockRowSize);
+    }
+
+    const uint32_t rowCount = std::min<uint32_t>(4, mipLevel.height);
+    for (uint32_t blockIndex = 0; blockIndex < blockCountX*blockCountY; ++blockIndex)
+      FlipBlockY(levelData + blockIndex*blockSize, m_texFormat, rowCount);
+  }
+}
+
 } // namespace flurr
@@ -10,7 +10,7 @@ namespace flurr
 {
 
 CameraComponent::CameraComponent(FlurrHandle a_componentHandle, FlurrHandle a_containingNodeHandle, SceneManager* a_owningManager)
-  : NodeComponent(a_componentHandle, a_containingNodeHandle, a_owningManager), m_projTransfDirty(true)
+  : NodeComponent(a_componentHandle, a_containingNodeHandle, a_owningManager), m_projTransfDirty(true), m_viewTransfValid(false)
 {
 }
 
@@ -42,34 +42,6 @@ void CameraComponent::applyRendererViewport()
   renderer->setViewport(m_vpx, m_vpy, m_vpw, m_vph);
 }
 
-void CameraComponent::applyShaderViewProjectionMatrix(FlurrHandle a_shaderProgramHandle)
-{
-  if (m_projTransfDirty) {
-    // Compute projection transform    
-    m_projTransf = getCameraType() == CameraType::kPerspective ?
-      glm::perspective(getFieldOfView(), getAspectRatio(), getNearClipDistance(), getFarClipDistance()) :
-      glm::ortho(m_vpx, m_vpx + m_vpw, m_vpy, m_vpy + m_vph);
-    m_projTransfDirty = false;
-  }
-
-  // Compute view-projection transform
-  auto* cameraNode = getContainingNode();
-  const auto invCameraRot = glm::conjugate(cameraNode->getWorldRotation());
-  const auto viewTransf = glm::translate(glm::toMat4(invCameraRot), -cameraNode->getWorldPosition());
-  const auto viewProjTransf = m_projTransf * viewTransf;
-
-  // Set view-projection transform
-  auto* renderer = FlurrCore::Get().getRenderer();
-  FLURR_ASSERT(renderer->hasShaderProgram(a_shaderProgramHandle), "Shader program %u does not exist!", a_shaderProgramHandle);  
-  auto* program = renderer->getShaderProgram(a_shaderProgramHandle);
-  // TODO: need to assert this is the currently used shader program
-  if (!program->setMat4Value(VIEW_PROJECTION_TRANSFORM_UNIFORM_NAME, viewProjTransf))
-  {
-    FLURR_LOG_WARN("Unable to set view-projection transform on shader program %u; failed to resolve uniform %s!",
-      program->getProgramHandle(), VIEW_PROJECTION_TRANSFORM_UNIFORM_NAME);
-  }
-}
-
 Status CameraComponent::onInitComponent(const NodeComponentInitArgs& a_initArgs)
 {
   const auto& cameraInitArgs = static_cast<const CameraComponentInitArgs&>(a_initArgs);
@@ -91,4 +63,34 @@ Status CameraComponent::onUpdateComponent(float a_deltaTime)
   return Status::kSuccess;
 }
 
+void CameraComponent::updateTransforms() const
+{
+  bool viewProjTransfDirty = false;
+  if (m_projTransfDirty) {
+    // Compute projection transform    
+    m_projTransf = getCameraType() == CameraType::kPerspective ?
+      glm::perspective(getFieldOfView(), getAspectRatio(), getNearClipDistance(), getFarClipDistance()) :
+      glm::ortho(m_vpx, m_vpx + m_vpw, m_vpy, m_vpy + m_vph);
+    m_projTransfDirty = false;
+    viewProjTransfDirty = true;
+  }
+
+  // Compute view transform if the camera node has moved
+  auto* cameraNode = getContainingNode();
+  const auto& cameraWorldPosition = cameraNode->getWorldPosition();
+  const auto& cameraWorldRotation = cameraNode->getWorldRotation();
+  if (!m_viewTransfValid || cameraWorldPosition != m_viewWorldPosition || cameraWorldRotation != m_viewWorldRotation)
+  {
+    m_viewTransf = glm::translate(glm::toMat4(glm::conjugate(cameraWorldRotation)), -cameraWorldPosition);
+    m_viewWorldPosition = cameraWorldPosition;
+    m_viewWorldRotation = cameraWorldRotation;
+    m_viewTransfValid = true;
+    viewProjTransfDirty = true;
+  }
+
+  // Compute view-projection transform
+  if (viewProjTransfDirty)
+    m_viewProjTransf = m_projTransf * m_viewTransf;
+}
+
 } // namespace flurr
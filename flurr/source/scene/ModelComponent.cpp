@@ -0,0 +1,77 @@
+#include "flurr/scene/ModelComponent.h"
+#include "flurr/scene/Node.h"
+#include "flurr/renderer/RenderCommandList.h"
+#include "flurr/FlurrCore.h"
+#include "flurr/FlurrLog.h"
+
+namespace flurr
+{
+
+ModelComponent::ModelComponent(FlurrHandle a_componentHandle, FlurrHandle a_containingNodeHandle, SceneManager* a_owningManager)
+  : NodeComponent(a_componentHandle, a_containingNodeHandle, a_owningManager),
+  m_programHandle(INVALID_HANDLE),
+  m_geometryHandle(INVALID_HANDLE),
+  m_texHandle(INVALID_HANDLE),
+  m_isStatic(false),
+  m_visible(true),
+  m_staticBatchIndex(kNoStaticBatch),
+  m_staticBatchRangeIndex(0)
+{
+}
+
+ModelComponent::~ModelComponent()
+{
+}
+
+void ModelComponent::setVisible(bool a_visible)
+{
+  m_visible = a_visible;
+  if (isStaticBatched())
+    getOwningManager()->setStaticBatchRangeVisible(m_staticBatchIndex, m_staticBatchRangeIndex, a_visible);
+}
+
+Status ModelComponent::onInitComponent(const NodeComponentInitArgs& a_initArgs)
+{
+  const auto& modelInitArgs = static_cast<const ModelComponentInitArgs&>(a_initArgs);
+  m_programHandle = modelInitArgs.programHandle;
+  m_geometryHandle = modelInitArgs.geometryHandle;
+  m_texHandle = modelInitArgs.texHandle;
+  m_isStatic = modelInitArgs.isStatic;
+  m_meshData = modelInitArgs.meshData;
+
+  return Status::kSuccess;
+}
+
+void ModelComponent::onDestroyComponent()
+{
+  // Remove model from its static batch
+  if (isStaticBatched())
+    getOwningManager()->setStaticBatchRangeVisible(m_staticBatchIndex, m_staticBatchRangeIndex, false);
+  m_staticBatchIndex = kNoStaticBatch;
+}
+
+Status ModelComponent::onUpdateComponent(float a_deltaTime)
+{
+  return Status::kSuccess;
+}
+
+Status ModelComponent::onDrawComponent()
+{
+  // Batched models are drawn by their batch
+  if (!m_visible || isStaticBatched())
+    return Status::kSuccess;
+
+  auto* commandList = getOwningManager()->getDrawCommandList();
+  if (!commandList)
+  {
+    FLURR_LOG_ERROR("Model components can only be drawn by SceneManager::draw!");
+    return Status::kInvalidState;
+  }
+
+  auto* node = getContainingNode();
+  commandList->addDraw(m_programHandle, m_geometryHandle, node->getWorldTransform(), m_texHandle,
+    getOwningManager()->getViewDepth(node->getWorldPosition()));
+  return Status::kSuccess;
+}
+
+} // namespace flurr
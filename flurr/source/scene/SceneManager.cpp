@@ -1,7 +1,10 @@
 #include "flurr/scene/SceneManager.h"
 #include "flurr/scene/CameraComponent.h"
+#include "flurr/scene/ModelComponent.h"
 #include "flurr/scene/Node.h"
 #include "flurr/scene/NodeComponent.h"
+#include "flurr/renderer/FramePacket.h"
+#include "flurr/FlurrCore.h"
 #include "flurr/FlurrLog.h"
 #include "flurr/utils/TypeCasts.h"
 
@@ -12,10 +15,11 @@ namespace flurr
 
 SceneManager::SceneManager()
   : m_initialized(false),
-  m_nextNodeHandle(ROOT_NODE_HANDLE + 1),
   m_nextNodeNameIndex(0),
-  m_nextComponentHandle(1),
-  m_activeCameraHandle(INVALID_HANDLE)
+  m_activeCameraHandle(INVALID_HANDLE),
+  m_drawCommandList(nullptr),
+  m_time(0.0f),
+  m_deltaTime(0.0f)
 {
 }
 
@@ -34,7 +38,8 @@ Status SceneManager::init()
     return Status::kSuccess;
   }
 
-  // Create root node
+  // Create root node (first handle issued by an empty node table)
+  FLURR_ASSERT(m_nodes.getNextHandle() == ROOT_NODE_HANDLE, "Root node must have handle %u!", ROOT_NODE_HANDLE);
   Status result = createNodeWithHandle(ROOT_NODE_HANDLE, ROOT_NODE_NAME, INVALID_HANDLE);
   if (Status::kSuccess != result)
   {
@@ -56,12 +61,15 @@ void SceneManager::shutdown()
     return;
   }
 
-  // Delete all the nodes and components
+  // Delete static batches, then all the nodes and components
+  destroyStaticBatches();
   destroyAllNodes();
   destroyEmptyNode(ROOT_NODE_HANDLE);
-  m_nextComponentHandle = 1;
-  m_nextNodeHandle = ROOT_NODE_HANDLE + 1;
+  m_components.clear();
+  m_nodes.clear();
   m_nextNodeNameIndex = 0;
+  m_time = 0.0f;
+  m_deltaTime = 0.0f;
 
   m_initialized = false;
   FLURR_LOG_INFO("SceneManager shutdown complete.");
@@ -75,10 +83,13 @@ Status SceneManager::update(float a_deltaTime)
     return Status::kNotInitialized;
   }
 
+  m_time += a_deltaTime;
+  m_deltaTime = a_deltaTime;
+
   return getRootNode()->updateNode(a_deltaTime);
 }
 
-Status SceneManager::draw()
+Status SceneManager::draw(FramePacket& a_framePacket)
 {
   if (!isInitialized())
   {
@@ -86,7 +97,61 @@ Status SceneManager::draw()
     return Status::kNotInitialized;
   }
 
-  // TODO: render the scene
+  // Write static batch ranges shown or hidden since the last draw;
+  // hidden ranges become degenerate triangles, restoring the indices shows them again
+  std::vector<uint32_t> hiddenIndices;
+  for (auto& batch : m_staticBatches)
+  {
+    for (const std::size_t rangeIndex : batch.dirtyRangeIndices)
+    {
+      const auto& range = batch.ranges[rangeIndex];
+      const uint32_t* rangeIndices = &batch.indices[range.firstIndex];
+      if (!range.visible)
+      {
+        hiddenIndices.assign(range.indexCount, 0);
+        rangeIndices = hiddenIndices.data();
+      }
+      a_framePacket.addBufferUpdate(batch.indexBufferHandle, rangeIndices, range.indexCount * sizeof(uint32_t), range.firstIndex * sizeof(uint32_t));
+    }
+    batch.dirtyRangeIndices.clear();
+  }
+
+  // Record the active camera's per-frame uniforms
+  auto* camera = getActiveCamera();
+  if (!camera)
+    return Status::kSuccess;
+  FrameUniforms frameUniforms;
+  frameUniforms.viewTransf = camera->getViewTransform();
+  frameUniforms.projTransf = camera->getProjectionTransform();
+  frameUniforms.viewProjTransf = camera->getViewProjectionTransform();
+  frameUniforms.cameraPosition = glm::vec4(camera->getContainingNode()->getWorldPosition(), 1.0f);
+  frameUniforms.time = glm::vec4(m_time, m_deltaTime, 0.0f, 0.0f);
+  a_framePacket.setFrameUniforms(frameUniforms);
+
+  // Record models that are drawn on their own
+  auto& commandList = a_framePacket.getCommandList();
+  m_drawCommandList = &commandList;
+  auto modelHandleRange = m_componentHandlesByType.equal_range(NodeComponentType::kModel);
+  for (auto modelHandleIt = modelHandleRange.first; modelHandleIt != modelHandleRange.second; ++modelHandleIt)
+  {
+    const Status result = getComponent(modelHandleIt->second)->drawComponent();
+    if (Status::kSuccess != result)
+    {
+      FLURR_LOG_ERROR("Failed to draw model component %u!", modelHandleIt->second);
+      m_drawCommandList = nullptr;
+      return result;
+    }
+  }
+  m_drawCommandList = nullptr;
+
+  // Record static batches with one draw each
+  for (const auto& batch : m_staticBatches)
+  {
+    if (0 == batch.visibleRangeCount)
+      continue;
+
+    commandList.addDraw(batch.programHandle, batch.geometryHandle, glm::mat4(1.0f), batch.texHandle, getViewDepth(batch.center));
+  }
 
   return Status::kSuccess;
 }
@@ -137,7 +202,7 @@ Status SceneManager::createNode(FlurrHandle& a_nodeHandle, const std::string& a_
   }
 
   // Generate node handle
-  a_nodeHandle = GenerateHandle(m_nextNodeHandle, [this](FlurrHandle a_h) { return hasNode(a_h); });
+  a_nodeHandle = m_nodes.getNextHandle();
 
   return createNodeWithHandle(a_nodeHandle, nodeName, parentNodeHandle, a_position, a_rotation, a_scale);
 }
@@ -226,7 +291,7 @@ void SceneManager::destroyAllNodes()
 
 bool SceneManager::hasNode(FlurrHandle a_nodeHandle) const
 {
-  return m_nodes.find(a_nodeHandle) != m_nodes.end();
+  return m_nodes.contains(a_nodeHandle);
 }
 
 bool SceneManager::hasNode(const std::string& a_nodeName) const
@@ -236,8 +301,8 @@ bool SceneManager::hasNode(const std::string& a_nodeName) const
 
 Node* SceneManager::getNode(FlurrHandle a_nodeHandle) const
 {
-  const auto nodeIt = m_nodes.find(a_nodeHandle);
-  return nodeIt != m_nodes.end() ? nodeIt->second.get() : nullptr;
+  const auto* node = m_nodes.get(a_nodeHandle);
+  return node ? node->get() : nullptr;
 }
 
 Node* SceneManager::getNode(const std::string& a_nodeName) const
@@ -248,12 +313,7 @@ Node* SceneManager::getNode(const std::string& a_nodeName) const
 
 std::vector<FlurrHandle> SceneManager::getAllNodeHandles() const
 {
-  std::vector<FlurrHandle> nodeHandles;
-  nodeHandles.reserve(m_nodes.size());
-  for (const auto& nodeKvp : m_nodes)
-    nodeHandles.push_back(nodeKvp.first);
-
-  return nodeHandles;
+  return m_nodes.getHandles();
 }
 
 Status SceneManager::createComponent(FlurrHandle& a_componentHandle, FlurrHandle a_nodeHandle, const NodeComponentInitArgs& a_initArgs)
@@ -278,13 +338,10 @@ Status SceneManager::createComponent(FlurrHandle& a_componentHandle, FlurrHandle
     return Status::kInvalidHandle;
   }
 
-  // Generate component handle
-  a_componentHandle = GenerateHandle(m_nextComponentHandle, [this](FlurrHandle a_h) { return hasComponent(a_h); });
-
   // Create component
   const NodeComponentType componentType = a_initArgs.componentType();
-  auto* component = createComponentOfType(a_componentHandle, a_nodeHandle, componentType);
-  m_components[a_componentHandle] = std::unique_ptr<NodeComponent>(component);
+  auto* component = createComponentOfType(m_components.getNextHandle(), a_nodeHandle, componentType);
+  a_componentHandle = m_components.insert(std::unique_ptr<NodeComponent>(component));
   m_componentHandlesByType.emplace(a_initArgs.componentType(), a_componentHandle);
 
   // Add component to node
@@ -390,23 +447,18 @@ void SceneManager::destroyAllComponentsOfNode(FlurrHandle a_nodeHandle)
 
 bool SceneManager::hasComponent(FlurrHandle a_componentHandle) const
 {
-  return m_components.find(a_componentHandle) != m_components.end();
+  return m_components.contains(a_componentHandle);
 }
 
 NodeComponent* SceneManager::getComponent(FlurrHandle a_componentHandle) const
 {
-  const auto componentIt = m_components.find(a_componentHandle);
-  return componentIt != m_components.end() ? componentIt->second.get() : nullptr;
+  const auto* component = m_components.get(a_componentHandle);
+  return component ? component->get() : nullptr;
 }
 
 std::vector<FlurrHandle> SceneManager::getAllComponentHandles() const
 {
-  std::vector<FlurrHandle> componentHandles;
-  componentHandles.reserve(m_components.size());
-  for (const auto& componentKvp : m_components)
-    componentHandles.push_back(componentKvp.first);
-
-  return componentHandles;
+  return m_components.getHandles();
 }
 
 std::vector<FlurrHandle> SceneManager::getAllComponentHandlesOfType(NodeComponentType a_componentType) const
@@ -441,12 +493,110 @@ void SceneManager::setActiveCameraHandle(FlurrHandle cameraHandle)
   FLURR_LOG_INFO("Active camera set to %u.", cameraHandle);
 }
 
+Status SceneManager::buildStaticBatches()
+{
+  if (!isInitialized())
+  {
+    FLURR_LOG_WARN("SceneManager not initialized!");
+    return Status::kNotInitialized;
+  }
+
+  auto* renderer = FlurrCore::Get().getRenderer();
+  if (!renderer || !renderer->isInitialized())
+  {
+    FLURR_LOG_ERROR("Unable to build static batches; renderer not initialized!");
+    return Status::kNotInitialized;
+  }
+
+  destroyStaticBatches();
+
+  // Group static models by shader program, texture and vertex format
+  std::vector<std::vector<ModelComponent*>> modelGroups;
+  auto modelHandleRange = m_componentHandlesByType.equal_range(NodeComponentType::kModel);
+  for (auto modelHandleIt = modelHandleRange.first; modelHandleIt != modelHandleRange.second; ++modelHandleIt)
+  {
+    auto* model = static_cast<ModelComponent*>(getComponent(modelHandleIt->second));
+    if (!model->isStatic())
+      continue;
+
+    if (!model->getMeshData())
+    {
+      FLURR_LOG_WARN("Unable to batch static model %u; no mesh data!", modelHandleIt->second);
+      continue;
+    }
+
+    auto modelGroupIt = std::find_if(modelGroups.begin(), modelGroups.end(), [model](const std::vector<ModelComponent*>& a_modelGroup)
+      {
+        const auto* groupModel = a_modelGroup.front();
+        return groupModel->getProgramHandle() == model->getProgramHandle() &&
+          groupModel->getTextureHandle() == model->getTextureHandle() &&
+          IsStaticBatchCompatible(*groupModel->getMeshData(), *model->getMeshData());
+      });
+    if (modelGroups.end() != modelGroupIt)
+      modelGroupIt->push_back(model);
+    else
+      modelGroups.push_back({model});
+  }
+
+  // Merge each group of two or more models into a batch
+  std::size_t batchedModelCount = 0;
+  for (const auto& modelGroup : modelGroups)
+  {
+    if (modelGroup.size() < 2)
+      continue;
+
+    Status result = createStaticBatch(modelGroup);
+    if (Status::kSuccess != result)
+    {
+      FLURR_LOG_ERROR("Failed to create static batch of %u models!", static_cast<uint32_t>(modelGroup.size()));
+      return result;
+    }
+    batchedModelCount += modelGroup.size();
+  }
+
+  FLURR_LOG_INFO("Merged %u static models into %u batches.", static_cast<uint32_t>(batchedModelCount), static_cast<uint32_t>(m_staticBatches.size()));
+  return Status::kSuccess;
+}
+
+void SceneManager::destroyStaticBatches()
+{
+  // Batched models go back to being drawn on their own
+  for (const auto& batch : m_staticBatches)
+  {
+    for (const auto& range : batch.ranges)
+    {
+      auto* model = static_cast<ModelComponent*>(getComponent(range.componentHandle));
+      if (model)
+        model->m_staticBatchIndex = ModelComponent::kNoStaticBatch;
+    }
+  }
+
+  // Renderer may have already released the batch geometry on shutdown
+  auto* renderer = FlurrCore::Get().getRenderer();
+  if (renderer && renderer->isInitialized())
+  {
+    for (const auto& batch : m_staticBatches)
+    {
+      renderer->destroyIndexedGeometry(batch.geometryHandle);
+      renderer->destroyVertexBuffer(batch.vertexBufferHandle);
+      renderer->destroyVertexBuffer(batch.indexBufferHandle);
+    }
+  }
+  m_staticBatches.clear();
+}
+
+const StaticBatch* SceneManager::getStaticBatch(std::size_t a_batchIndex) const
+{
+  return a_batchIndex < m_staticBatches.size() ? &m_staticBatches[a_batchIndex] : nullptr;
+}
+
 Status SceneManager::createNodeWithHandle(FlurrHandle a_nodeHandle, const std::string& a_nodeName, FlurrHandle a_parentNodeHandle,
   const glm::vec3& a_position, const glm::quat& a_rotation, const glm::vec3& a_scale)
 {
   // Create node
+  FLURR_ASSERT(a_nodeHandle == m_nodes.getNextHandle(), "Node handle %u must be the next free handle!", a_nodeHandle);
   auto* node = new Node(a_nodeHandle, a_nodeName, a_parentNodeHandle, a_position, a_rotation, a_scale, this);
-  m_nodes[a_nodeHandle] = std::unique_ptr<Node>(node);
+  m_nodes.insert(std::unique_ptr<Node>(node));
   m_nodeHandlesByName[a_nodeName] = a_nodeHandle;
 
   // Parent node
@@ -536,6 +686,10 @@ NodeComponent* SceneManager::createComponentOfType(FlurrHandle a_componentHandle
     {
       return new CameraComponent(a_componentHandle, a_nodeHandle, this);
     }
+    case NodeComponentType::kModel:
+    {
+      return new ModelComponent(a_componentHandle, a_nodeHandle, this);
+    }
     default:
     {
       FLURR_ASSERT(false, "Unhandled node component type %u!", FromEnum(a_componentType));
@@ -543,4 +697,82 @@ NodeComponent* SceneManager::createComponentOfType(FlurrHandle a_componentHandle
   }
 }
 
+Status SceneManager::createStaticBatch(const std::vector<ModelComponent*>& a_models)
+{
+  StaticBatch batch;
+  batch.programHandle = a_models.front()->getProgramHandle();
+  batch.texHandle = a_models.front()->getTextureHandle();
+  const auto& meshData = *a_models.front()->getMeshData();
+
+  // Pre-transform model vertices to world space and merge them, recording each model's index range
+  std::vector<uint8_t> vertexData;
+  for (auto* model : a_models)
+  {
+    const std::size_t firstIndex = batch.indices.size();
+    auto* node = model->getContainingNode();
+    Status result = AppendStaticMesh(*model->getMeshData(), node->getWorldTransform(), vertexData, batch.indices);
+    if (Status::kSuccess != result)
+      return result;
+
+    batch.ranges.push_back(StaticBatchRange{model->getComponentHandle(), firstIndex, batch.indices.size() - firstIndex, true});
+    batch.center += node->getWorldPosition();
+  }
+  batch.center /= static_cast<float>(a_models.size());
+  batch.visibleRangeCount = batch.ranges.size();
+
+  // Create merged geometry; indices are dynamic, so ranges can be hidden
+  auto* renderer = FlurrCore::Get().getRenderer();
+  Status result = renderer->createVertexBuffer(batch.vertexBufferHandle, VertexBufferType::kVertexAttribute, vertexData.size(), vertexData.data(), meshData.vertexStride);
+  if (Status::kSuccess == result)
+    result = renderer->createIndexBuffer(batch.indexBufferHandle, batch.indices.size() * sizeof(uint32_t), batch.indices.data(), VertexDataUsage::kDynamic, IndexType::kUnsigned32);
+  if (Status::kSuccess == result)
+    result = renderer->createIndexedGeometry(batch.geometryHandle, {batch.vertexBufferHandle}, batch.indexBufferHandle, meshData.vertexLayout);
+  if (Status::kSuccess != result)
+  {
+    // Failed to create the batch geometry, clean up
+    if (INVALID_HANDLE != batch.vertexBufferHandle)
+      renderer->destroyVertexBuffer(batch.vertexBufferHandle);
+    if (INVALID_HANDLE != batch.indexBufferHandle)
+      renderer->destroyVertexBuffer(batch.indexBufferHandle);
+    return result;
+  }
+
+  // Hand models over to the batch, keeping hidden ones hidden
+  const std::size_t batchIndex = m_staticBatches.size();
+  m_staticBatches.push_back(std::move(batch));
+  for (std::size_t rangeIndex = 0; rangeIndex < a_models.size(); ++rangeIndex)
+  {
+    auto* model = a_models[rangeIndex];
+    model->m_staticBatchIndex = batchIndex;
+    model->m_staticBatchRangeIndex = rangeIndex;
+    if (!model->isVisible())
+      setStaticBatchRangeVisible(batchIndex, rangeIndex, false);
+  }
+
+  return Status::kSuccess;
+}
+
+void SceneManager::setStaticBatchRangeVisible(std::size_t a_batchIndex, std::size_t a_rangeIndex, bool a_visible)
+{
+  if (a_batchIndex >= m_staticBatches.size() || a_rangeIndex >= m_staticBatches[a_batchIndex].ranges.size())
+    return;
+
+  auto& batch = m_staticBatches[a_batchIndex];
+  auto& range = batch.ranges[a_rangeIndex];
+  if (range.visible == a_visible)
+    return;
+  range.visible = a_visible;
+  batch.visibleRangeCount = a_visible ? batch.visibleRangeCount + 1 : batch.visibleRangeCount - 1;
+
+  // Index buffer is written by the next frame packet, since it may be in use by the render thread
+  if (0 != range.indexCount && std::find(batch.dirtyRangeIndices.begin(), batch.dirtyRangeIndices.end(), a_rangeIndex) == batch.dirtyRangeIndices.end())
+    batch.dirtyRangeIndices.push_back(a_rangeIndex);
+}
+
+float SceneManager::getViewDepth(const glm::vec3& a_worldPosition) const
+{
+  auto* camera = getActiveCamera();
+  return camera ? -(camera->getViewTransform() * glm::vec4(a_worldPosition, 1.0f)).z : 0.0f;
+}
+
 } // namespace flurr
@@ -0,0 +1,112 @@
+#include "flurr/scene/StaticBatch.h"
+#include "flurr/FlurrLog.h"
+
+#include <cstring>
+
+namespace flurr
+{
+
+namespace
+{
+
+glm::vec3 ReadVec3(const uint8_t* a_vertex, std::size_t a_offset)
+{
+  glm::vec3 value;
+  std::memcpy(&value, a_vertex + a_offset, sizeof(glm::vec3));
+  return value;
+}
+
+void WriteVec3(uint8_t* a_vertex, std::size_t a_offset, const glm::vec3& a_value)
+{
+  std::memcpy(a_vertex + a_offset, &a_value, sizeof(glm::vec3));
+}
+
+} // namespace
+
+Status AppendStaticMesh(const StaticMeshData& a_mesh, const glm::mat4& a_worldTransf,
+  std::vector<uint8_t>& a_vertexData, std::vector<uint32_t>& a_indices)
+{
+  const std::size_t stride = a_mesh.vertexStride;
+  if (0 == stride || a_mesh.vertexData.size() % stride != 0 || a_vertexData.size() % stride != 0)
+  {
+    FLURR_LOG_ERROR("Static mesh vertex data must be a multiple of the vertex stride!");
+    return Status::kInvalidArgument;
+  }
+
+  if (a_mesh.positionOffset + sizeof(glm::vec3) > stride ||
+    (NO_VERTEX_ATTRIBUTE != a_mesh.normalOffset && a_mesh.normalOffset + sizeof(glm::vec3) > stride))
+  {
+    FLURR_LOG_ERROR("Static mesh positions and normals must lie within the vertex!");
+    return Status::kInvalidArgument;
+  }
+
+  const std::size_t vertexCount = a_mesh.vertexData.size() / stride;
+  const std::size_t baseVertex = a_vertexData.size() / stride;
+  if (baseVertex + vertexCount > UINT32_MAX)
+  {
+    FLURR_LOG_ERROR("Static batch exceeds 32-bit vertex indices!");
+    return Status::kIndexOutOfBounds;
+  }
+
+  for (const uint32_t index : a_mesh.indices)
+  {
+    if (index >= vertexCount)
+    {
+      FLURR_LOG_ERROR("Static mesh index %u out of bounds (vertex count is %u)!", index, static_cast<uint32_t>(vertexCount));
+      return Status::kIndexOutOfBounds;
+    }
+  }
+
+  // Copy vertices and transform positions and normals to world space
+  a_vertexData.insert(a_vertexData.end(), a_mesh.vertexData.begin(), a_mesh.vertexData.end());
+  const glm::mat3 normalTransf = glm::transpose(glm::inverse(glm::mat3(a_worldTransf)));
+  for (std::size_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+  {
+    uint8_t* vertex = &a_vertexData[(baseVertex + vertexIndex) * stride];
+    const glm::vec3 position = ReadVec3(vertex, a_mesh.positionOffset);
+    WriteVec3(vertex, a_mesh.positionOffset, glm::vec3(a_worldTransf * glm::vec4(position, 1.0f)));
+    if (NO_VERTEX_ATTRIBUTE == a_mesh.normalOffset)
+      continue;
+
+    const glm::vec3 normal = normalTransf * ReadVec3(vertex, a_mesh.normalOffset);
+    const float normalLength = glm::length(normal);
+    WriteVec3(vertex, a_mesh.normalOffset, normalLength > 0.0f ? normal / normalLength : normal);
+  }
+
+  // Rebase indices to the merged vertices
+  a_indices.reserve(a_indices.size() + a_mesh.indices.size());
+  for (const uint32_t index : a_mesh.indices)
+    a_indices.push_back(static_cast<uint32_t>(baseVertex) + index);
+
+  return Status::kSuccess;
+}
+
+bool IsStaticBatchCompatible(const StaticMeshData& a_mesh1, const StaticMeshData& a_mesh2)
+{
+  if (a_mesh1.vertexStride != a_mesh2.vertexStride ||
+    a_mesh1.positionOffset != a_mesh2.positionOffset ||
+    a_mesh1.normalOffset != a_mesh2.normalOffset)
+    return false;
+
+  const auto& layout1 = a_mesh1.vertexLayout;
+  const auto& layout2 = a_mesh2.vertexLayout;
+  if (layout1.getAttributeCount() != layout2.getAttributeCount())
+    return false;
+
+  for (std::size_t attributeIndex = 0; attributeIndex < layout1.getAttributeCount(); ++attributeIndex)
+  {
+    const auto& attribute1 = layout1.getAttribute(attributeIndex);
+    const auto& attribute2 = layout2.getAttribute(attributeIndex);
+    if (attribute1.location != attribute2.location ||
+      attribute1.type != attribute2.type ||
+      attribute1.componentCount != attribute2.componentCount ||
+      attribute1.normalized != attribute2.normalized ||
+      attribute1.streamIndex != attribute2.streamIndex ||
+      attribute1.offset != attribute2.offset)
+      return false;
+  }
+
+  return true;
+}
+
+} // namespace flurr
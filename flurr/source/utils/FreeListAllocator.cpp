@@ -0,0 +1,95 @@
+#include "flurr/utils/FreeListAllocator.h"
+#include "flurr/FlurrLog.h"
+
+#include <algorithm>
+
+namespace flurr
+{
+
+FreeListAllocator::FreeListAllocator(std::size_t a_capacity)
+  : m_capacity(0),
+  m_freeSize(0)
+{
+  reset(a_capacity);
+}
+
+void FreeListAllocator::reset(std::size_t a_capacity)
+{
+  m_capacity = a_capacity;
+  m_freeSize = a_capacity;
+  m_freeBlocks.clear();
+  if (a_capacity > 0)
+    m_freeBlocks.push_back(FreeBlock{0, a_capacity});
+}
+
+std::size_t FreeListAllocator::allocate(std::size_t a_size)
+{
+  if (0 == a_size)
+    return kInvalidOffset;
+
+  // Find the first free block large enough and take the allocation from its start
+  for (auto blockIt = m_freeBlocks.begin(); blockIt != m_freeBlocks.end(); ++blockIt)
+  {
+    if (blockIt->size < a_size)
+      continue;
+
+    const std::size_t offset = blockIt->offset;
+    blockIt->offset += a_size;
+    blockIt->size -= a_size;
+    if (0 == blockIt->size)
+      m_freeBlocks.erase(blockIt);
+    m_freeSize -= a_size;
+
+    return offset;
+  }
+
+  return kInvalidOffset;
+}
+
+void FreeListAllocator::free(std::size_t a_offset, std::size_t a_size)
+{
+  if (0 == a_size)
+    return;
+  FLURR_ASSERT(a_offset + a_size <= m_capacity, "Freed block [%u, %u) out of allocator bounds!",
+    static_cast<uint32_t>(a_offset), static_cast<uint32_t>(a_offset + a_size));
+
+  // Insert block in offset order
+  auto nextIt = std::lower_bound(m_freeBlocks.begin(), m_freeBlocks.end(), a_offset,
+    [](const FreeBlock& a_block, std::size_t a_blockOffset) { return a_block.offset < a_blockOffset; });
+  FLURR_ASSERT(nextIt == m_freeBlocks.end() || a_offset + a_size <= nextIt->offset, "Freed block at %u overlaps a free block!",
+    static_cast<uint32_t>(a_offset));
+  FLURR_ASSERT(nextIt == m_freeBlocks.begin() || (nextIt - 1)->offset + (nextIt - 1)->size <= a_offset, "Freed block at %u overlaps a free block!",
+    static_cast<uint32_t>(a_offset));
+  auto blockIt = m_freeBlocks.insert(nextIt, FreeBlock{a_offset, a_size});
+  m_freeSize += a_size;
+
+  // Merge with next block
+  auto mergeIt = blockIt + 1;
+  if (mergeIt != m_freeBlocks.end() && blockIt->offset + blockIt->size == mergeIt->offset)
+  {
+    blockIt->size += mergeIt->size;
+    m_freeBlocks.erase(mergeIt);
+  }
+
+  // Merge with previous block
+  if (blockIt != m_freeBlocks.begin())
+  {
+    auto prevIt = blockIt - 1;
+    if (prevIt->offset + prevIt->size == blockIt->offset)
+    {
+      prevIt->size += blockIt->size;
+      m_freeBlocks.erase(blockIt);
+    }
+  }
+}
+
+std::size_t FreeListAllocator::getLargestFreeBlockSize() const
+{
+  std::size_t largestSize = 0;
+  for (const auto& block : m_freeBlocks)
+    largestSize = std::max(largestSize, block.size);
+
+  return largestSize;
+}
+
+} // namespace flurr
@@ -179,23 +179,16 @@ bool HelloTexturesApplication::onInit()
 
 bool HelloTexturesApplication::onUpdate(float a_deltaTime)
 {
+  // Record geometry into this frame's packet, so draws also reach the renderer in render thread mode
+  auto& commandList = FlurrCore::Get().getFrameCommandList();
+  commandList.addDraw(m_spHandle, m_geo1Handle, glm::mat4(1.0f), m_tex1Handle);
+  commandList.addDraw(m_spHandle, m_geo2Handle, glm::mat4(1.0f), m_tex2Handle);
+
   return true;
 }
 
 void HelloTexturesApplication::onDraw()
 {
-  // Draw geometry 1
-  auto* renderer = FlurrCore::Get().getRenderer();
-  renderer->useShaderProgram(m_spHandle);
-  auto* sp = renderer->getShaderProgram(m_spHandle);
-  sp->setMat4Value(MODEL_TRANSFORM_UNIFORM_NAME, glm::mat4());
-  getActiveCamera()->applyShaderViewProjectionMatrix(m_spHandle);
-  renderer->useTexture(m_tex1Handle);
-  renderer->drawIndexedGeometry(m_geo1Handle);
-
-  // Draw geometry 2
-  renderer->useTexture(m_tex2Handle);
-  renderer->drawIndexedGeometry(m_geo2Handle);
 }
 
 void HelloTexturesApplication::onQuit()
@@ -195,14 +195,12 @@ void HelloTriangleApplication::onDraw()
   renderer->useShaderProgram(m_sp1Handle);  
   auto* sp1 = renderer->getShaderProgram(m_sp1Handle);
   sp1->setMat4Value(MODEL_TRANSFORM_UNIFORM_NAME, glm::mat4());
-  getActiveCamera()->applyShaderViewProjectionMatrix(m_sp1Handle);
   renderer->drawIndexedGeometry(m_geo1Handle);
 
   // Draw geometry 2
   renderer->useShaderProgram(m_sp2Handle);
   auto* sp2 = renderer->getShaderProgram(m_sp2Handle);
   sp2->setMat4Value(MODEL_TRANSFORM_UNIFORM_NAME, glm::mat4());
-  getActiveCamera()->applyShaderViewProjectionMatrix(m_sp2Handle);
   const glm::vec4 diffuseColor(
     sin(m_albedoTime*glm::pi<float>()/2.0f)/2.0f + 0.5f,
     sin((m_albedoTime/2.0f + 0.25f)*glm::pi<float>())/2.0f + 0.5f,
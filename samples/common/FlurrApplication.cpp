@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <chrono>
 #include <iostream>
+#include <thread>
 
 namespace flurr
 {
@@ -13,7 +14,9 @@ FlurrApplication::FlurrApplication(int a_windowWidth, int a_windowHeight, const
   m_fullscreen(a_windowWidth <= 0 || a_windowHeight <= 0),
   m_windowTitle(a_windowTitle),
   m_window(nullptr),
-  m_shutdown(false)
+  m_shutdown(false),
+  m_renderThreadMode(false),
+  m_targetFrameRate(0.0f)
 {
 }
 
@@ -64,9 +67,13 @@ int FlurrApplication::run()
   if (!initApp())
     return -1;
 
+  if (!startRenderThread())
+    return -1;
+
   // Enter main loop
   updateLoop();
 
+  stopRenderThread();
   shutdownApp();
   shutdownFlurr();
   shutdownGlfw();
@@ -201,6 +208,32 @@ bool FlurrApplication::initApp()
   return true;
 }
 
+bool FlurrApplication::startRenderThread()
+{
+  if (!isRenderThreadMode())
+    return true;
+
+  // Hand the GL context over to the render thread, which also presents frames
+  FLURR_LOG_INFO("Starting render thread...");
+  glfwMakeContextCurrent(nullptr);
+  RenderThreadCallbacks callbacks;
+  callbacks.onStart = [this]() { glfwMakeContextCurrent(m_window); };
+  callbacks.onFrame = [this]() { glfwSwapBuffers(m_window); };
+  callbacks.onStop = []() { glfwMakeContextCurrent(nullptr); };
+  const Status result = FlurrCore::Get().startRenderThread(callbacks);
+  if (Status::kSuccess != result)
+  {
+    FLURR_LOG_ERROR("Failed to start render thread (error: %u)!", FromEnum(result));
+    glfwMakeContextCurrent(m_window);
+    shutdownApp();
+    shutdownFlurr();
+    shutdownGlfw();
+    return false;
+  }
+
+  return true;
+}
+
 void FlurrApplication::updateLoop()
 {
   // Start timing
@@ -226,11 +259,12 @@ void FlurrApplication::updateLoop()
       continue;
     }
 
-    // Application-specific drawing
-    onDraw();
-
-    // Swap front and back buffers
-    glfwSwapBuffers(m_window);
+    // Application-specific drawing and buffer swap, unless the render thread owns the context
+    if (!FlurrCore::Get().isRenderThreadRunning())
+    {
+      onDraw();
+      glfwSwapBuffers(m_window);
+    }
 
     // Process events
     glfwPollEvents();
@@ -238,9 +272,43 @@ void FlurrApplication::updateLoop()
     // Has user closed window?
     if (glfwWindowShouldClose(m_window) != 0)
       quit();
+
+    // Wait out the rest of the frame
+    limitFrameRate();
   }
 }
 
+void FlurrApplication::limitFrameRate()
+{
+  if (m_targetFrameRate <= 0.0f)
+    return;
+
+  // Frames start at fixed intervals; if we fall more than a frame behind, start over instead of catching up
+  using Clock = std::chrono::steady_clock;
+  const auto framePeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(1.0f / m_targetFrameRate));
+  const auto spinTime = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(kFrameLimiterSpinTime));
+  auto timeCurrent = Clock::now();
+  if (timeCurrent - m_nextFrameTime > framePeriod)
+    m_nextFrameTime = timeCurrent;
+
+  // Sleep through most of the wait, then spin until the frame starts
+  if (m_nextFrameTime - timeCurrent > spinTime)
+    std::this_thread::sleep_for(m_nextFrameTime - timeCurrent - spinTime);
+  while (Clock::now() < m_nextFrameTime)
+    std::this_thread::yield();
+  m_nextFrameTime += framePeriod;
+}
+
+void FlurrApplication::stopRenderThread()
+{
+  if (!FlurrCore::Get().isRenderThreadRunning())
+    return;
+
+  // Take the GL context back, so resources can be released on this thread
+  FlurrCore::Get().stopRenderThread();
+  glfwMakeContextCurrent(m_window);
+}
+
 void FlurrApplication::shutdownApp()
 {
   // Application-specific cleanup
@@ -313,7 +381,10 @@ void FlurrApplication::glfwFramebufferSizeCallback(GLFWwindow* a_window, int a_w
   auto* sceneManager = FlurrCore::Get().getSceneManager();
   auto* activeCamera = sceneManager->getActiveCamera();
   activeCamera->setViewport(0, 0, a_width, a_height);
-  activeCamera->applyRendererViewport();
+  if (FlurrCore::Get().isRenderThreadRunning())
+    FlurrCore::Get().getFramePacket()->setViewport(0, 0, a_width, a_height);
+  else
+    activeCamera->applyRendererViewport();
 
   // Update application window size
   app->m_windowWidth = a_width;
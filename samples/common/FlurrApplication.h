@@ -2,6 +2,7 @@
 #include <flurr.h>
 #include <GLFW/glfw3.h>
 
+#include <chrono>
 #include <string>
 
 namespace flurr
@@ -24,6 +25,10 @@ public:
   bool isFullScreen() const;
   const std::string& getWindowTitle() const;
   GLFWwindow* getWindow() const;
+  bool isRenderThreadMode() const { return m_renderThreadMode; }
+  void setRenderThreadMode(bool a_renderThreadMode) { m_renderThreadMode = a_renderThreadMode; } // call before run; onDraw is not called, record draws into FlurrCore::getFrameCommandList
+  float getTargetFrameRate() const { return m_targetFrameRate; }
+  void setTargetFrameRate(float a_targetFrameRate) { m_targetFrameRate = a_targetFrameRate; } // frames per second, 0 = unlimited
   int run();
   void quit();
 
@@ -50,7 +55,10 @@ private:
   bool initFlurr();
   bool initCamera();
   bool initApp();
+  bool startRenderThread();
   void updateLoop();
+  void limitFrameRate();
+  void stopRenderThread();
   void shutdownApp();
   void shutdownFlurr();
   void shutdownGlfw();
@@ -90,6 +98,9 @@ private:
   static constexpr float kCameraZoomSpeed = 0.01f;
   static constexpr float kCameraZoomSpeedScroll = 1.0f;
 
+  // Frame limiter constants
+  static constexpr float kFrameLimiterSpinTime = 0.002f; // s, end of each wait is spent spinning, since sleeps can overshoot
+
   // Application window
   int m_windowWidth;
   int m_windowHeight;
@@ -99,6 +110,11 @@ private:
 
   // Application state
   bool m_shutdown;
+  bool m_renderThreadMode;
+
+  // Frame limiter
+  float m_targetFrameRate;
+  std::chrono::steady_clock::time_point m_nextFrameTime;
 
   // Camera control
   FlurrHandle m_camNodeHandle;
@@ -1,9 +1,15 @@
 #include <gtest/gtest.h>
 #include <flurr.h>
+#include <FlurrApplication.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdio>
+#include <cstring>
 #include <map>
 #include <memory>
+#include <set>
 #include <thread>
 
 using flurr::CurrentTime;
@@ -14,7 +20,40 @@ using flurr::ToString;
 using flurr::ConfigFile;
 using flurr::Status;
 using flurr::ObjectFactory;
+using flurr::SlotMap;
+using flurr::FreeListAllocator;
+using flurr::RenderQueue;
+using flurr::RenderCommandList;
+using flurr::Renderer;
+using flurr::NullRenderBackend;
+using flurr::RenderBackendCallType;
+using flurr::VertexBufferType;
+using flurr::VertexDataUsage;
+using flurr::InstanceData;
+using flurr::SamplerCache;
+using flurr::SamplerDesc;
+using flurr::TextureFilteringQuality;
+using flurr::TextureWrapMode;
+using flurr::TextureMinFilterMode;
+using flurr::TextureMagFilterMode;
+using flurr::VertexLayout;
+using flurr::VertexAttributeType;
+using flurr::IndexType;
+using flurr::AnalyzeVertexCache;
+using flurr::OptimizeMesh;
+using flurr::MeshOptimizationSettings;
+using flurr::MeshOptimizationStats;
+using flurr::MeshVertexStream;
+using flurr::StaticMeshData;
+using flurr::AppendStaticMesh;
+using flurr::IsStaticBatchCompatible;
+using flurr::FramePacket;
+using flurr::FramePacketExchange;
 using flurr::FlurrCore;
+using flurr::FlurrApplication;
+using flurr::RenderThreadCallbacks;
+using flurr::RenderBackend;
+using flurr::RenderBackendType;
 using flurr::FlurrHandle;
 using flurr::INVALID_HANDLE;
 using flurr::ResourceListener;
@@ -55,6 +94,28 @@ protected:
     // Code here will be called immediately after each test (right
     // before the destructor).
   }
+
+  // Create vertex and index buffers and an indexed geometry for a single triangle
+  void createTriangle(Renderer& a_renderer, FlurrHandle& a_geometryHandle)
+  {
+    float positions[9] = {};
+    uint32_t indices[3] = {0, 1, 2};
+    FlurrHandle vertexBufferHandle = INVALID_HANDLE, indexBufferHandle = INVALID_HANDLE;
+    ASSERT_TRUE(a_renderer.createVertexBuffer(vertexBufferHandle, VertexBufferType::kVertexAttribute, sizeof(positions), positions, 3 * sizeof(float)) == Status::kSuccess);
+    ASSERT_TRUE(a_renderer.createIndexBuffer(indexBufferHandle, sizeof(indices), indices) == Status::kSuccess);
+    ASSERT_TRUE(a_renderer.createIndexedGeometry(a_geometryHandle, {vertexBufferHandle}, indexBufferHandle) == Status::kSuccess);
+  }
+
+  // Initialize a renderer on the null backend, with a shader program and a triangle to draw
+  void createNullRendererWithTriangle(Renderer& a_renderer, NullRenderBackend*& a_nullBackend, FlurrHandle& a_programHandle, FlurrHandle& a_geometryHandle)
+  {
+    auto backend = std::make_unique<NullRenderBackend>();
+    a_nullBackend = backend.get();
+    ASSERT_TRUE(a_renderer.setBackend(std::move(backend)) == Status::kSuccess);
+    ASSERT_TRUE(a_renderer.init() == Status::kSuccess);
+    ASSERT_TRUE(a_renderer.createShaderProgram(a_programHandle) == Status::kSuccess);
+    createTriangle(a_renderer, a_geometryHandle);
+  }
 };
 
 // Test time utils
@@ -230,6 +291,694 @@ TEST_F(FlurrTest, FlurrObjectFactories)
   EXPECT_TRUE(test2Obj3->ObjectId() == 3);
 }
 
+// Test slot map handle tables
+TEST_F(FlurrTest, FlurrSlotMaps)
+{
+  SlotMap<std::string> slotMap;
+  EXPECT_TRUE(slotMap.empty());
+  EXPECT_TRUE(slotMap.getNextHandle() == 1);
+  EXPECT_FALSE(slotMap.contains(INVALID_HANDLE));
+  EXPECT_TRUE(slotMap.get(INVALID_HANDLE) == nullptr);
+
+  // Test insertion
+  const FlurrHandle handle1 = slotMap.insert("Value1");
+  const FlurrHandle handle2 = slotMap.insert("Value2");
+  const FlurrHandle handle3 = slotMap.insert("Value3");
+  EXPECT_TRUE(handle1 == 1 && handle2 == 2 && handle3 == 3);
+  ASSERT_TRUE(slotMap.size() == 3);
+  ASSERT_TRUE(slotMap.get(handle2) != nullptr);
+  EXPECT_TRUE(*slotMap.get(handle2) == "Value2");
+  EXPECT_FALSE(slotMap.contains(4));
+
+  // Test removal and stale handles
+  EXPECT_TRUE(slotMap.erase(handle1));
+  EXPECT_FALSE(slotMap.erase(handle1));
+  EXPECT_FALSE(slotMap.contains(handle1));
+  EXPECT_TRUE(slotMap.size() == 2);
+  EXPECT_TRUE(*slotMap.get(handle3) == "Value3");
+  EXPECT_TRUE(slotMap.getHandleByIndex(0) == handle3);
+  const FlurrHandle nextHandle = slotMap.getNextHandle();
+  EXPECT_FALSE(slotMap.contains(nextHandle));
+  const FlurrHandle handle4 = slotMap.insert("Value4");
+  EXPECT_TRUE(handle4 == nextHandle);
+  EXPECT_TRUE(handle4 != handle1);
+  EXPECT_TRUE(SlotMap<std::string>::SlotIndexOf(handle4) == SlotMap<std::string>::SlotIndexOf(handle1));
+  EXPECT_FALSE(slotMap.contains(handle1));
+  EXPECT_TRUE(*slotMap.get(handle4) == "Value4");
+
+  // Test dense iteration
+  std::size_t valueCount = 0;
+  for (const auto& value : slotMap)
+    valueCount += value.empty() ? 0 : 1;
+  EXPECT_TRUE(valueCount == 3);
+  for (std::size_t valueIndex = 0; valueIndex < slotMap.size(); ++valueIndex)
+    EXPECT_TRUE(slotMap.get(slotMap.getHandleByIndex(valueIndex)) == &slotMap.getByIndex(valueIndex));
+
+  // Test clear
+  slotMap.clear();
+  EXPECT_TRUE(slotMap.empty());
+  EXPECT_FALSE(slotMap.contains(handle2));
+  EXPECT_TRUE(slotMap.getNextHandle() == 1);
+}
+
+// Test free list allocation of arena ranges
+TEST_F(FlurrTest, FlurrFreeListAllocator)
+{
+  FreeListAllocator allocator(100);
+  EXPECT_TRUE(allocator.getFreeSize() == 100);
+
+  // Allocate blocks back to back
+  EXPECT_TRUE(allocator.allocate(30) == 0);
+  EXPECT_TRUE(allocator.allocate(30) == 30);
+  EXPECT_TRUE(allocator.allocate(30) == 60);
+  EXPECT_TRUE(allocator.allocate(20) == FreeListAllocator::kInvalidOffset);
+  EXPECT_TRUE(allocator.getFreeSize() == 10);
+
+  // Freed block is reused first fit
+  allocator.free(0, 30);
+  EXPECT_TRUE(allocator.getFreeBlockCount() == 2);
+  EXPECT_TRUE(allocator.allocate(20) == 0);
+  EXPECT_TRUE(allocator.getLargestFreeBlockSize() == 10);
+
+  // Freed neighbours merge into one block
+  allocator.free(30, 30);
+  allocator.free(60, 30);
+  EXPECT_TRUE(allocator.getFreeBlockCount() == 1);
+  EXPECT_TRUE(allocator.getLargestFreeBlockSize() == 80);
+  allocator.free(0, 20);
+  EXPECT_TRUE(allocator.getFreeBlockCount() == 1);
+  EXPECT_TRUE(allocator.getFreeSize() == 100);
+
+  allocator.reset(50);
+  EXPECT_TRUE(allocator.getCapacity() == 50);
+  EXPECT_TRUE(allocator.allocate(50) == 0);
+  EXPECT_TRUE(allocator.getFreeSize() == 0);
+}
+
+// Test render command sorting
+TEST_F(FlurrTest, FlurrRenderQueue)
+{
+  RenderQueue renderQueue;
+  EXPECT_TRUE(renderQueue.isEmpty());
+
+  // Key ordering: program, then texture, then geometry, then depth
+  EXPECT_TRUE(RenderQueue::MakeSortKey(1, 9, 9, 100.0f) < RenderQueue::MakeSortKey(2, 1, 1, 0.0f));
+  EXPECT_TRUE(RenderQueue::MakeSortKey(1, 1, 9, 100.0f) < RenderQueue::MakeSortKey(1, 2, 1, 0.0f));
+  EXPECT_TRUE(RenderQueue::MakeSortKey(1, 1, 1, 100.0f) < RenderQueue::MakeSortKey(1, 1, 2, 0.0f));
+  EXPECT_TRUE(RenderQueue::MakeSortKey(1, 1, 1, 1.0f) < RenderQueue::MakeSortKey(1, 1, 1, 2.0f));
+  EXPECT_TRUE(RenderQueue::MakeSortKey(1, 1, 1, -1.0f) == RenderQueue::MakeSortKey(1, 1, 1, 0.0f));
+
+  // Queue commands in scrambled order
+  const glm::mat4 modelTransf(1.0f);
+  for (uint32_t commandIndex = 0; commandIndex < 1000; ++commandIndex)
+  {
+    const FlurrHandle programHandle = 1 + (commandIndex * 7) % 3;
+    const FlurrHandle texHandle = 1 + (commandIndex * 13) % 5;
+    const FlurrHandle geometryHandle = 1 + (commandIndex * 31) % 11;
+    renderQueue.addCommand(programHandle, texHandle, geometryHandle, modelTransf, static_cast<float>(commandIndex % 17));
+  }
+  ASSERT_TRUE(renderQueue.getCommandCount() == 1000);
+  EXPECT_TRUE(renderQueue.getCommand(1).programHandle == 2);
+
+  // Sort and check the commands are ordered by key and grouped by program
+  renderQueue.sort();
+  uint32_t programSwitchCount = 1;
+  for (std::size_t commandIndex = 1; commandIndex < renderQueue.getCommandCount(); ++commandIndex)
+  {
+    const auto& prevCommand = renderQueue.getSortedCommand(commandIndex - 1);
+    const auto& command = renderQueue.getSortedCommand(commandIndex);
+    EXPECT_TRUE(prevCommand.sortKey <= command.sortKey);
+    programSwitchCount += prevCommand.programHandle != command.programHandle ? 1 : 0;
+  }
+  EXPECT_TRUE(programSwitchCount == 3);
+
+  // Textures in the same array sort together, regardless of their own handles
+  renderQueue.clear();
+  EXPECT_TRUE(renderQueue.isEmpty());
+  renderQueue.addCommand(1, 1, 1, modelTransf, 0.0f, 1);
+  renderQueue.addCommand(1, 2, 1, modelTransf, 0.0f);
+  renderQueue.addCommand(1, 3, 1, modelTransf, 0.0f, 1);
+  renderQueue.sort();
+  EXPECT_TRUE(renderQueue.getSortedCommand(0).textureHandle == 2);
+  EXPECT_TRUE(renderQueue.getSortedCommand(1).sortKey == renderQueue.getSortedCommand(2).sortKey);
+
+  // Array handles never collide with texture handles, even with the top handle bit set
+  EXPECT_TRUE(RenderQueue::MakeSortKey(1, 1, 1, 0.0f, true) != RenderQueue::MakeSortKey(1, 1, 1, 0.0f));
+  EXPECT_TRUE(RenderQueue::MakeSortKey(1, 0x8001, 1, 0.0f) != RenderQueue::MakeSortKey(1, 1, 1, 0.0f, true));
+
+  renderQueue.clear();
+  EXPECT_TRUE(renderQueue.isEmpty());
+}
+
+// Test renderer logic against the null backend
+TEST_F(FlurrTest, FlurrNullRenderBackend)
+{
+  // Create programs and geometries without a GPU context
+  Renderer renderer;
+  NullRenderBackend* nullBackend = nullptr;
+  FlurrHandle programHandles[2] = {INVALID_HANDLE, INVALID_HANDLE};
+  FlurrHandle geometryHandles[3] = {INVALID_HANDLE, INVALID_HANDLE, INVALID_HANDLE};
+  ASSERT_NO_FATAL_FAILURE(createNullRendererWithTriangle(renderer, nullBackend, programHandles[0], geometryHandles[0]));
+  EXPECT_TRUE(renderer.setBackend(std::make_unique<NullRenderBackend>()) == Status::kInvalidState);
+  ASSERT_TRUE(renderer.createShaderProgram(programHandles[1]) == Status::kSuccess);
+  ASSERT_NO_FATAL_FAILURE(createTriangle(renderer, geometryHandles[1]));
+  ASSERT_NO_FATAL_FAILURE(createTriangle(renderer, geometryHandles[2]));
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kInitGeometry) == 3);
+
+  // Invalid input is rejected before it reaches the backend
+  float positions[9] = {};
+  FlurrHandle invalidHandle = INVALID_HANDLE;
+  uint32_t outOfBoundsIndices[3] = {0, 1, 3};
+  FlurrHandle vertexBufferHandle = INVALID_HANDLE, indexBufferHandle = INVALID_HANDLE;
+  EXPECT_TRUE(renderer.createVertexBuffer(invalidHandle, VertexBufferType::kVertexAttribute, sizeof(positions), nullptr, 3 * sizeof(float)) == Status::kNullArgument);
+  ASSERT_TRUE(renderer.createVertexBuffer(vertexBufferHandle, VertexBufferType::kVertexAttribute, sizeof(positions), positions, 3 * sizeof(float)) == Status::kSuccess);
+  ASSERT_TRUE(renderer.createIndexBuffer(indexBufferHandle, sizeof(outOfBoundsIndices), outOfBoundsIndices) == Status::kSuccess);
+  EXPECT_TRUE(renderer.createIndexedGeometry(invalidHandle, {}, INVALID_HANDLE) == Status::kInvalidHandle);
+  EXPECT_TRUE(renderer.createIndexedGeometry(invalidHandle, {vertexBufferHandle}, indexBufferHandle) == Status::kIndexOutOfBounds);
+  EXPECT_TRUE(renderer.linkShaderProgram(programHandles[0]) == Status::kInvalidState);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kInitGeometry) == 3);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kLinkProgram) == 0);
+
+  // Submit interleaved draws and check they are batched by program
+  const glm::mat4 modelTransf(1.0f);
+  for (uint32_t drawIndex = 0; drawIndex < 12; ++drawIndex)
+    ASSERT_TRUE(renderer.submitDraw(programHandles[drawIndex % 2], geometryHandles[drawIndex % 3], modelTransf) == Status::kSuccess);
+  nullBackend->clearCalls();
+  ASSERT_TRUE(renderer.update(0.0f) == Status::kSuccess);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kBeginFrame) == 1);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kUseProgram) == 2);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kDrawGeometry) == 12);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kEndFrame) == 1);
+  ASSERT_FALSE(nullBackend->getCalls().empty());
+  EXPECT_TRUE(nullBackend->getCalls().front().callType == RenderBackendCallType::kBeginFrame);
+
+  // Queue is consumed by the update
+  nullBackend->clearCalls();
+  renderer.update(0.0f);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kDrawGeometry) == 0);
+
+  renderer.shutdown();
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kDestroyGeometry) == 3);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kDestroyProgram) == 2);
+}
+
+// Test geometry arenas against the null backend
+TEST_F(FlurrTest, FlurrGeometryArenas)
+{
+  Renderer renderer;
+  auto backend = std::make_unique<NullRenderBackend>();
+  auto* nullBackend = backend.get();
+  ASSERT_TRUE(renderer.setBackend(std::move(backend)) == Status::kSuccess);
+  ASSERT_TRUE(renderer.init() == Status::kSuccess);
+
+  // Invalid layouts and capacities are rejected before they reach the backend
+  VertexLayout twoStreamLayout;
+  twoStreamLayout.addAttribute(0, VertexAttributeType::kFloat, 3).addAttribute(1, VertexAttributeType::kFloat, 2, false, 1);
+  VertexLayout invalidLayout;
+  invalidLayout.addAttribute(0, VertexAttributeType::kFloat, 3).addAttribute(0, VertexAttributeType::kFloat, 2);
+  VertexLayout vertexLayout;
+  vertexLayout.addAttribute(0, VertexAttributeType::kFloat, 3).addAttribute(1, VertexAttributeType::kFloat, 2);
+  FlurrHandle arenaHandle = INVALID_HANDLE;
+  EXPECT_TRUE(renderer.createGeometryArena(arenaHandle, twoStreamLayout, 64, 96) == Status::kInvalidArgument);
+  EXPECT_TRUE(renderer.createGeometryArena(arenaHandle, invalidLayout, 64, 96) == Status::kInvalidArgument);
+  EXPECT_TRUE(renderer.createGeometryArena(arenaHandle, vertexLayout, 0, 96) == Status::kInvalidArgument);
+  EXPECT_TRUE(arenaHandle == INVALID_HANDLE);
+  EXPECT_TRUE(renderer.getGeometryArenaCount() == 0);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kInitArena) == 0);
+
+  // Valid arena keeps its properties
+  ASSERT_TRUE(renderer.createGeometryArena(arenaHandle, vertexLayout, 64, 96, IndexType::kUnsigned16) == Status::kSuccess);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kInitArena) == 1);
+  auto* arena = renderer.getGeometryArena(arenaHandle);
+  ASSERT_TRUE(arena != nullptr);
+  EXPECT_TRUE(arena->getVertexStride() == 5 * sizeof(float));
+  EXPECT_TRUE(arena->getIndexType() == IndexType::kUnsigned16);
+  EXPECT_TRUE(arena->getVertexCapacity() == 64);
+  EXPECT_TRUE(arena->getFreeIndexCount() == 96);
+
+  // Mesh uploads and draws go through the backend
+  float vertices[4 * 5] = {};
+  uint32_t indices[6] = {0, 1, 2, 2, 3, 0};
+  FlurrHandle meshHandles[3] = {INVALID_HANDLE, INVALID_HANDLE, INVALID_HANDLE};
+  for (auto& meshHandle : meshHandles)
+    ASSERT_TRUE(arena->addMesh(meshHandle, vertices, 4, indices, 6) == Status::kSuccess);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kUpdateArena) == 3);
+  EXPECT_TRUE(nullBackend->getCalls().back().arg == sizeof(vertices));
+  EXPECT_TRUE(arena->getFreeVertexCount() == 52);
+  ASSERT_TRUE(arena->drawMesh(meshHandles[0]) == Status::kSuccess);
+  ASSERT_TRUE(arena->drawMeshes({meshHandles[0], meshHandles[1], meshHandles[2]}) == Status::kSuccess);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kDrawArena) == 2);
+  EXPECT_TRUE(nullBackend->getCalls().back().arg == 3);
+  EXPECT_TRUE(arena->drawMeshes({meshHandles[1], INVALID_HANDLE}) == Status::kInvalidHandle);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kDrawArena) == 2);
+
+  // Defragmentation closes the hole left by a removed mesh
+  arena->removeMesh(meshHandles[0]);
+  ASSERT_TRUE(arena->defragment() == Status::kSuccess);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kCopyArena) == 1);
+  EXPECT_TRUE(arena->getMesh(meshHandles[1])->firstVertex == 0);
+  EXPECT_TRUE(arena->getMesh(meshHandles[2])->firstVertex == 4);
+  EXPECT_TRUE(arena->getMesh(meshHandles[2])->firstIndex == 6);
+  EXPECT_TRUE(arena->getFreeVertexCount() == 56);
+
+  renderer.shutdown();
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kDestroyArena) == 1);
+}
+
+// Test instanced drawing against the null backend
+TEST_F(FlurrTest, FlurrInstancing)
+{
+  Renderer renderer;
+  NullRenderBackend* nullBackend = nullptr;
+  FlurrHandle programHandle = INVALID_HANDLE, geometryHandle = INVALID_HANDLE;
+  ASSERT_NO_FATAL_FAILURE(createNullRendererWithTriangle(renderer, nullBackend, programHandle, geometryHandle));
+
+  // Per-instance data is uploaded as InstanceData
+  constexpr std::size_t kInstanceCount = 8;
+  std::vector<InstanceData> instances(kInstanceCount, InstanceData{glm::mat4(1.0f), glm::vec4(1.0f), glm::vec4(0.0f)});
+  FlurrHandle instanceBufferHandle = INVALID_HANDLE;
+  nullBackend->clearCalls();
+  ASSERT_TRUE(renderer.createVertexBuffer(instanceBufferHandle, VertexBufferType::kInstanceAttribute, kInstanceCount * sizeof(InstanceData), instances.data(),
+    sizeof(InstanceData), VertexDataUsage::kDynamic) == Status::kSuccess);
+  ASSERT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kInitVertexBuffer) == 1);
+  EXPECT_TRUE(nullBackend->getCalls().back().handle == instanceBufferHandle);
+  EXPECT_TRUE(nullBackend->getCalls().back().arg == kInstanceCount * sizeof(InstanceData));
+  instances[0].color = glm::vec4(0.5f);
+  std::size_t offset = 0;
+  ASSERT_TRUE(renderer.updateVertexBuffer(instanceBufferHandle, instances.data(), 2 * sizeof(InstanceData), offset) == Status::kSuccess);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kUpdateVertexBuffer) == 1);
+  EXPECT_TRUE(nullBackend->getCalls().back().arg == 2 * sizeof(InstanceData));
+
+  // Instance count defaults to, and is clamped to, the instances in the buffer
+  nullBackend->clearCalls();
+  ASSERT_TRUE(renderer.drawIndexedGeometryInstanced(geometryHandle, instanceBufferHandle, 5) == Status::kSuccess);
+  ASSERT_TRUE(renderer.drawIndexedGeometryInstanced(geometryHandle, instanceBufferHandle) == Status::kSuccess);
+  ASSERT_TRUE(renderer.drawIndexedGeometryInstanced(geometryHandle, instanceBufferHandle, 100) == Status::kSuccess);
+  std::vector<uint32_t> drawnInstanceCounts;
+  for (const auto& call : nullBackend->getCalls())
+  {
+    if (RenderBackendCallType::kDrawGeometryInstanced == call.callType && geometryHandle == call.handle)
+      drawnInstanceCounts.push_back(call.arg);
+  }
+  EXPECT_TRUE(drawnInstanceCounts == std::vector<uint32_t>({5, kInstanceCount, kInstanceCount}));
+
+  // Instance buffers must hold InstanceData, possibly without trailing members
+  float positions[9] = {};
+  FlurrHandle vertexBufferHandle = INVALID_HANDLE, wrongSizeBufferHandle = INVALID_HANDLE, transformBufferHandle = INVALID_HANDLE;
+  ASSERT_TRUE(renderer.createVertexBuffer(vertexBufferHandle, VertexBufferType::kVertexAttribute, sizeof(positions), positions, 3 * sizeof(float)) == Status::kSuccess);
+  ASSERT_TRUE(renderer.createVertexBuffer(wrongSizeBufferHandle, VertexBufferType::kInstanceAttribute, sizeof(positions), positions, 3 * sizeof(float)) == Status::kSuccess);
+  ASSERT_TRUE(renderer.createVertexBuffer(transformBufferHandle, VertexBufferType::kInstanceAttribute, kInstanceCount * sizeof(InstanceData), instances.data(),
+    sizeof(glm::mat4)) == Status::kSuccess);
+  EXPECT_TRUE(renderer.drawIndexedGeometryInstanced(geometryHandle, INVALID_HANDLE) == Status::kInvalidHandle);
+  EXPECT_TRUE(renderer.drawIndexedGeometryInstanced(geometryHandle, vertexBufferHandle) == Status::kUnsupportedType);
+  EXPECT_TRUE(renderer.drawIndexedGeometryInstanced(geometryHandle, wrongSizeBufferHandle) == Status::kInvalidArgument);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kDrawGeometryInstanced) == 3);
+  ASSERT_TRUE(renderer.drawIndexedGeometryInstanced(geometryHandle, transformBufferHandle) == Status::kSuccess);
+  EXPECT_TRUE(nullBackend->getCalls().back().arg == kInstanceCount * sizeof(InstanceData) / sizeof(glm::mat4));
+
+  renderer.shutdown();
+}
+
+// Test recording draws on worker threads
+TEST_F(FlurrTest, FlurrRenderCommandLists)
+{
+  Renderer renderer;
+  NullRenderBackend* nullBackend = nullptr;
+  FlurrHandle programHandles[2] = {INVALID_HANDLE, INVALID_HANDLE};
+  FlurrHandle geometryHandle = INVALID_HANDLE;
+  ASSERT_NO_FATAL_FAILURE(createNullRendererWithTriangle(renderer, nullBackend, programHandles[0], geometryHandle));
+  ASSERT_TRUE(renderer.createShaderProgram(programHandles[1]) == Status::kSuccess);
+
+  // Each thread fills its own list
+  constexpr std::size_t kThreadCount = 4;
+  constexpr uint32_t kDrawsPerThread = 1000;
+  std::vector<RenderCommandList> commandLists(kThreadCount);
+  std::vector<std::thread> threads;
+  for (std::size_t threadIndex = 0; threadIndex < kThreadCount; ++threadIndex)
+  {
+    threads.emplace_back([&, threadIndex]()
+      {
+        for (uint32_t drawIndex = 0; drawIndex < kDrawsPerThread; ++drawIndex)
+          commandLists[threadIndex].addDraw(programHandles[(drawIndex + threadIndex) % 2], geometryHandle, glm::mat4(1.0f), INVALID_HANDLE, static_cast<float>(drawIndex),
+            glm::vec4(static_cast<float>(threadIndex)));
+      });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  // Lists are merged and sorted together on submission
+  for (const auto& commandList : commandLists)
+  {
+    EXPECT_TRUE(commandList.getDrawCount() == kDrawsPerThread);
+    ASSERT_TRUE(renderer.submitCommandList(commandList) == Status::kSuccess);
+  }
+  EXPECT_TRUE(renderer.getRenderQueue().getCommandCount() == kThreadCount * kDrawsPerThread);
+  EXPECT_TRUE(renderer.getRenderQueue().getCommand(0).drawParams == glm::vec4(0.0f));
+  EXPECT_TRUE(renderer.getRenderQueue().getCommand(kThreadCount * kDrawsPerThread - 1).drawParams == glm::vec4(static_cast<float>(kThreadCount - 1)));
+  nullBackend->clearCalls();
+  renderer.update(0.0f);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kUseProgram) == 2);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kDrawGeometry) == kThreadCount * kDrawsPerThread);
+
+  // Draws referencing missing resources are rejected
+  RenderCommandList invalidList;
+  invalidList.addDraw(programHandles[0], geometryHandle + 1, glm::mat4(1.0f));
+  EXPECT_TRUE(renderer.submitCommandList(invalidList) == Status::kInvalidArgument);
+  EXPECT_TRUE(renderer.getRenderQueue().isEmpty());
+
+  renderer.shutdown();
+}
+
+// Test handing frame packets from a simulation thread to a render thread
+TEST_F(FlurrTest, FlurrFramePackets)
+{
+  // Writer never gets more than two packets ahead, reader sees them in order and drains them after closing
+  constexpr uint64_t kFrameCount = 1000;
+  FramePacketExchange exchange;
+  std::atomic<uint64_t> readFrameCount(0);
+  std::atomic<bool> inOrder(true);
+  std::thread renderThread([&]()
+    {
+      while (const auto* framePacket = exchange.waitRead())
+      {
+        if (framePacket->getFrameIndex() != readFrameCount.load() || framePacket->getCommandList().getDrawCount() != framePacket->getFrameIndex() % 8)
+          inOrder.store(false);
+        exchange.endRead();
+        readFrameCount.fetch_add(1);
+      }
+    });
+  bool neverAhead = true;
+  for (uint64_t frameIndex = 0; frameIndex < kFrameCount; ++frameIndex)
+  {
+    FramePacket* framePacket = exchange.waitWrite();
+    if (frameIndex - readFrameCount.load() > FramePacketExchange::kPacketCount)
+      neverAhead = false;
+    framePacket->reset(frameIndex);
+    for (uint64_t drawIndex = 0; drawIndex < frameIndex % 8; ++drawIndex)
+      framePacket->getCommandList().addDraw(1, 1, glm::mat4(1.0f));
+    exchange.endWrite();
+  }
+  exchange.close();
+  renderThread.join();
+  EXPECT_TRUE(readFrameCount.load() == kFrameCount);
+  EXPECT_TRUE(inOrder.load());
+  EXPECT_TRUE(neverAhead);
+  EXPECT_TRUE(exchange.beginRead() == nullptr);
+
+  // Submitting a packet applies its buffer updates before queuing its draws
+  Renderer renderer;
+  NullRenderBackend* nullBackend = nullptr;
+  FlurrHandle programHandle = INVALID_HANDLE, geometryHandle = INVALID_HANDLE;
+  ASSERT_NO_FATAL_FAILURE(createNullRendererWithTriangle(renderer, nullBackend, programHandle, geometryHandle));
+  uint32_t indices[3] = {0, 1, 2};
+  FramePacket framePacket;
+  framePacket.reset(0);
+  framePacket.addBufferUpdate(INVALID_HANDLE, indices, sizeof(indices), 0);
+  framePacket.getCommandList().addDraw(programHandle, geometryHandle, glm::mat4(1.0f));
+  EXPECT_TRUE(std::memcmp(framePacket.getBufferUpdateData(framePacket.getBufferUpdate(0)), indices, sizeof(indices)) == 0);
+  EXPECT_TRUE(renderer.submitFramePacket(framePacket) != Status::kSuccess);
+  EXPECT_TRUE(renderer.getRenderQueue().isEmpty());
+  framePacket.reset(1);
+  framePacket.getCommandList().addDraw(programHandle, geometryHandle, glm::mat4(1.0f));
+  ASSERT_TRUE(renderer.submitFramePacket(framePacket) == Status::kSuccess);
+  nullBackend->clearCalls();
+  renderer.update(0.0f);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kDrawGeometry) == 1);
+
+  renderer.shutdown();
+}
+
+// Test bounding frames in flight with frame fences
+TEST_F(FlurrTest, FlurrFramePacing)
+{
+  Renderer renderer;
+  NullRenderBackend* nullBackend = nullptr;
+  FlurrHandle programHandle = INVALID_HANDLE, geometryHandle = INVALID_HANDLE;
+  ASSERT_NO_FATAL_FAILURE(createNullRendererWithTriangle(renderer, nullBackend, programHandle, geometryHandle));
+  EXPECT_TRUE(renderer.setMaxFramesInFlight(0) == Status::kInvalidArgument);
+  EXPECT_TRUE(renderer.setMaxFramesInFlight(flurr::MAX_FRAMES_IN_FLIGHT + 1) == Status::kInvalidArgument);
+  ASSERT_TRUE(renderer.setMaxFramesInFlight(3) == Status::kSuccess);
+  nullBackend->clearCalls();
+
+  // Each frame fences its slot, then waits for the oldest frame before reusing its slot
+  constexpr uint32_t kFrameCount = 5;
+  for (uint32_t frameIndex = 0; frameIndex < kFrameCount; ++frameIndex)
+    ASSERT_TRUE(renderer.update(0.0f) == Status::kSuccess);
+  EXPECT_TRUE(renderer.getFrameIndex() == kFrameCount);
+  EXPECT_TRUE(renderer.getFrameSlot() == kFrameCount % 3);
+  std::vector<uint32_t> insertSlots;
+  std::vector<uint32_t> waitSlots;
+  for (const auto& call : nullBackend->getCalls())
+  {
+    if (RenderBackendCallType::kInsertFrameFence == call.callType)
+      insertSlots.push_back(call.arg);
+    else if (RenderBackendCallType::kWaitFrameFence == call.callType)
+      waitSlots.push_back(call.arg);
+  }
+  EXPECT_TRUE(insertSlots == std::vector<uint32_t>({0, 1, 2, 0, 1}));
+  EXPECT_TRUE(waitSlots == std::vector<uint32_t>({1, 2, 0, 1, 2}));
+
+  // Changing the limit waits for all frames in flight
+  nullBackend->clearCalls();
+  ASSERT_TRUE(renderer.setMaxFramesInFlight(1) == Status::kSuccess);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kWaitFrameFence) == 3);
+  EXPECT_TRUE(renderer.getFrameSlot() == 0);
+
+  renderer.shutdown();
+}
+
+// Application that is never run, for testing its settings
+class TestApplication : public FlurrApplication
+{
+
+private:
+
+  bool onInit() override { return true; }
+  bool onUpdate(float a_deltaTime) override { return true; }
+  void onQuit() override {}
+};
+
+// Test rendering frame packets on the render thread
+TEST_F(FlurrTest, FlurrRenderThread)
+{
+  // Applications opt into render thread mode before running
+  TestApplication application;
+  EXPECT_FALSE(application.isRenderThreadMode());
+  application.setRenderThreadMode(true);
+  EXPECT_TRUE(application.isRenderThreadMode());
+
+  // Render thread needs an initialized core
+  auto& flurrCore = FlurrCore::Get();
+  EXPECT_TRUE(flurrCore.startRenderThread() == Status::kNotInitialized);
+  auto backend = std::make_unique<NullRenderBackend>();
+  auto* nullBackend = backend.get();
+  ASSERT_TRUE(flurrCore.getRenderer()->setBackend(std::move(backend)) == Status::kSuccess);
+  ASSERT_TRUE(flurrCore.init() == Status::kSuccess);
+  FlurrHandle programHandle = INVALID_HANDLE, geometryHandle = INVALID_HANDLE;
+  ASSERT_TRUE(flurrCore.getRenderer()->createShaderProgram(programHandle) == Status::kSuccess);
+  ASSERT_NO_FATAL_FAILURE(createTriangle(*flurrCore.getRenderer(), geometryHandle));
+
+  // Packets recorded on this thread are rendered on the render thread, all of them before it stops
+  std::atomic<uint32_t> startCount(0), frameCount(0), stopCount(0);
+  RenderThreadCallbacks callbacks;
+  callbacks.onStart = [&startCount]() { startCount.fetch_add(1); };
+  callbacks.onFrame = [&frameCount]() { frameCount.fetch_add(1); };
+  callbacks.onStop = [&stopCount]() { stopCount.fetch_add(1); };
+  nullBackend->clearCalls();
+  ASSERT_TRUE(flurrCore.startRenderThread(callbacks) == Status::kSuccess);
+  EXPECT_TRUE(flurrCore.isRenderThreadRunning());
+  constexpr uint32_t kFrameCount = 16;
+  for (uint32_t frameIndex = 0; frameIndex < kFrameCount; ++frameIndex)
+  {
+    flurrCore.getFrameCommandList().addDraw(programHandle, geometryHandle, glm::mat4(1.0f));
+    ASSERT_TRUE(flurrCore.update(0.0f) == Status::kSuccess);
+  }
+  flurrCore.stopRenderThread();
+  EXPECT_FALSE(flurrCore.isRenderThreadRunning());
+  EXPECT_TRUE(startCount.load() == 1);
+  EXPECT_TRUE(frameCount.load() == kFrameCount);
+  EXPECT_TRUE(stopCount.load() == 1);
+  EXPECT_TRUE(nullBackend->getCallCount(RenderBackendCallType::kDrawGeometry) == kFrameCount);
+
+  // Render failure is reported by a later update, at the latest once its packet has been returned
+  ASSERT_TRUE(flurrCore.startRenderThread(callbacks) == Status::kSuccess);
+  uint32_t indices[3] = {0, 1, 2};
+  flurrCore.getFramePacket()->addBufferUpdate(INVALID_HANDLE, indices, sizeof(indices), 0);
+  uint32_t failedUpdateCount = 0;
+  for (uint32_t frameIndex = 0; frameIndex <= FramePacketExchange::kPacketCount; ++frameIndex)
+  {
+    if (flurrCore.update(0.0f) != Status::kSuccess)
+      ++failedUpdateCount;
+  }
+  EXPECT_TRUE(failedUpdateCount == 1);
+  flurrCore.stopRenderThread();
+  EXPECT_TRUE(stopCount.load() == 2);
+
+  flurrCore.shutdown();
+  ASSERT_TRUE(flurrCore.getRenderer()->setBackend(RenderBackend::Create(RenderBackendType::kOpenGL)) == Status::kSuccess);
+}
+
+// Test sampler object caching
+TEST_F(FlurrTest, FlurrSamplerCache)
+{
+  // Sampler keys are unique per sampling state and round-trip to the same state
+  SamplerDesc samplerDesc;
+  samplerDesc.wrapMode = TextureWrapMode::kClampToEdge;
+  samplerDesc.minFilterMode = TextureMinFilterMode::kNearestMipmapLinear;
+  samplerDesc.magFilterMode = TextureMagFilterMode::kNearest;
+  samplerDesc.anisotropyLevel = 4;
+  const uint32_t samplerKey = SamplerCache::MakeSamplerKey(samplerDesc);
+  EXPECT_TRUE(samplerKey != SamplerCache::MakeSamplerKey(SamplerDesc()));
+  const SamplerDesc keyDesc = SamplerCache::GetSamplerDesc(samplerKey);
+  EXPECT_TRUE(keyDesc.wrapMode == samplerDesc.wrapMode);
+  EXPECT_TRUE(keyDesc.minFilterMode == samplerDesc.minFilterMode);
+  EXPECT_TRUE(keyDesc.magFilterMode == samplerDesc.magFilterMode);
+  EXPECT_TRUE(keyDesc.anisotropyLevel == samplerDesc.anisotropyLevel);
+
+  // Filtering quality config values
+  TextureFilteringQuality filteringQuality = TextureFilteringQuality::kBilinear;
+  EXPECT_TRUE(SamplerCache::ParseFilteringQuality("Anisotropic", filteringQuality));
+  EXPECT_TRUE(filteringQuality == TextureFilteringQuality::kAnisotropic);
+  EXPECT_TRUE(SamplerCache::ParseFilteringQuality(" Trilinear ", filteringQuality));
+  EXPECT_TRUE(filteringQuality == TextureFilteringQuality::kTrilinear);
+  EXPECT_FALSE(SamplerCache::ParseFilteringQuality("Bicubic", filteringQuality));
+}
+
+// Test vertex layout description and validation
+TEST_F(FlurrTest, FlurrVertexLayout)
+{
+  EXPECT_TRUE(VertexLayout::GetAttributeTypeSize(VertexAttributeType::kFloat, 3) == 12);
+  EXPECT_TRUE(VertexLayout::GetAttributeTypeSize(VertexAttributeType::kHalfFloat, 2) == 4);
+  EXPECT_TRUE(VertexLayout::GetAttributeTypeSize(VertexAttributeType::kUnsignedByte, 4) == 4);
+  EXPECT_TRUE(VertexLayout::GetAttributeTypeSize(VertexAttributeType::kInt2_10_10_10, 4) == 4);
+
+  // Interleave position, packed normal and UV in stream 0, color in stream 1
+  VertexLayout vertexLayout;
+  vertexLayout.addAttribute(0, VertexAttributeType::kFloat, 3)
+    .addAttribute(1, VertexAttributeType::kInt2_10_10_10, 4, true)
+    .addAttribute(2, VertexAttributeType::kHalfFloat, 2)
+    .addAttribute(3, VertexAttributeType::kUnsignedByte, 4, true, 1);
+  ASSERT_TRUE(vertexLayout.getAttributeCount() == 4);
+  EXPECT_TRUE(vertexLayout.getStreamCount() == 2);
+  EXPECT_TRUE(vertexLayout.getAttribute(1).offset == 12);
+  EXPECT_TRUE(vertexLayout.getAttribute(2).offset == 16);
+  EXPECT_TRUE(vertexLayout.getAttribute(3).offset == 0);
+  EXPECT_TRUE(vertexLayout.getStreamPackedSize(0) == 20);
+  EXPECT_TRUE(vertexLayout.getStreamPackedSize(1) == 4);
+  EXPECT_TRUE(vertexLayout.getStreamStride(0) == 0);
+  EXPECT_TRUE(vertexLayout.validate() == Status::kSuccess);
+
+  // Explicit stride must fit all attributes
+  vertexLayout.setStreamStride(0, 24);
+  EXPECT_TRUE(vertexLayout.getStreamStride(0) == 24);
+  EXPECT_TRUE(vertexLayout.validate() == Status::kSuccess);
+  vertexLayout.setStreamStride(0, 16);
+  EXPECT_TRUE(vertexLayout.validate() == Status::kInvalidArgument);
+
+  // Packed attributes must have 4 components, locations must be unique
+  VertexLayout invalidLayout;
+  invalidLayout.addAttribute(0, VertexAttributeType::kUnsignedInt2_10_10_10, 3);
+  EXPECT_TRUE(invalidLayout.validate() == Status::kInvalidArgument);
+  invalidLayout = VertexLayout();
+  invalidLayout.addAttribute(0, VertexAttributeType::kFloat, 3).addAttribute(0, VertexAttributeType::kFloat, 2);
+  EXPECT_TRUE(invalidLayout.validate() == Status::kInvalidArgument);
+}
+
+// Test vertex cache and fetch optimization of meshes
+TEST_F(FlurrTest, FlurrMeshOptimizer)
+{
+  // Build a grid mesh with triangles in scrambled order and an unused vertex
+  constexpr uint32_t kGridSize = 32;
+  constexpr uint32_t kVertexCount = (kGridSize + 1) * (kGridSize + 1) + 1;
+  std::vector<float> positions;
+  for (uint32_t y = 0; y <= kGridSize; ++y)
+    for (uint32_t x = 0; x <= kGridSize; ++x)
+      positions.insert(positions.end(), {static_cast<float>(x), static_cast<float>(y), 0.0f});
+  positions.insert(positions.end(), {-1.0f, -1.0f, -1.0f});
+  std::vector<uint32_t> vertexIds(kVertexCount);
+  for (uint32_t vertex = 0; vertex < kVertexCount; ++vertex)
+    vertexIds[vertex] = vertex;
+
+  std::vector<uint32_t> indices;
+  constexpr uint32_t kQuadCount = kGridSize * kGridSize;
+  for (uint32_t quadIndex = 0; quadIndex < kQuadCount; ++quadIndex)
+  {
+    const uint32_t quad = (quadIndex * 263) % kQuadCount;
+    const uint32_t v0 = (quad / kGridSize) * (kGridSize + 1) + quad % kGridSize;
+    indices.insert(indices.end(), {v0, v0 + 1, v0 + kGridSize + 2, v0, v0 + kGridSize + 2, v0 + kGridSize + 1});
+  }
+  std::vector<uint32_t> srcIndices = indices;
+
+  // Optimize and check cache efficiency improved
+  std::size_t vertexCount = kVertexCount;
+  MeshOptimizationStats stats;
+  const std::vector<MeshVertexStream> vertexStreams{{positions.data(), 3 * sizeof(float)}, {vertexIds.data(), sizeof(uint32_t)}};
+  ASSERT_TRUE(OptimizeMesh(indices.data(), indices.size(), vertexStreams, vertexCount, MeshOptimizationSettings(), &stats) == Status::kSuccess);
+  EXPECT_TRUE(vertexCount == kVertexCount - 1);
+  EXPECT_TRUE(stats.statsAfter.acmr < stats.statsBefore.acmr);
+  EXPECT_TRUE(stats.statsAfter.acmr < 1.0f);
+  EXPECT_TRUE(stats.statsAfter.atvr >= 1.0f);
+  EXPECT_TRUE(stats.statsAfter.vertexTransformCount == AnalyzeVertexCache(indices.data(), indices.size(), vertexCount).vertexTransformCount);
+
+  // Vertices are numbered in order of first use, and triangles still reference the same source vertices
+  EXPECT_TRUE(indices[0] == 0);
+  std::multiset<std::array<uint32_t, 3>> srcTris, tris;
+  for (std::size_t index = 0; index < indices.size(); index += 3)
+  {
+    std::array<uint32_t, 3> srcTri{srcIndices[index], srcIndices[index + 1], srcIndices[index + 2]};
+    std::array<uint32_t, 3> tri{vertexIds[indices[index]], vertexIds[indices[index + 1]], vertexIds[indices[index + 2]]};
+    std::rotate(srcTri.begin(), std::min_element(srcTri.begin(), srcTri.end()), srcTri.end());
+    std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+    srcTris.insert(srcTri);
+    tris.insert(tri);
+  }
+  EXPECT_TRUE(srcTris == tris);
+
+  // Out of bounds indices are rejected
+  indices[0] = static_cast<uint32_t>(vertexCount);
+  EXPECT_TRUE(OptimizeMesh(indices.data(), indices.size(), vertexStreams, vertexCount, MeshOptimizationSettings()) == Status::kIndexOutOfBounds);
+}
+
+// Test merging of static meshes
+TEST_F(FlurrTest, FlurrStaticBatch)
+{
+  // Triangle with interleaved float XYZ positions and normals
+  StaticMeshData mesh;
+  mesh.vertexLayout.addAttribute(0, VertexAttributeType::kFloat, 3).addAttribute(1, VertexAttributeType::kFloat, 3);
+  mesh.vertexStride = 6 * sizeof(float);
+  mesh.normalOffset = 3 * sizeof(float);
+  const float vertices[18] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+  mesh.vertexData.resize(sizeof(vertices));
+  std::memcpy(mesh.vertexData.data(), vertices, sizeof(vertices));
+  mesh.indices = {0, 1, 2};
+
+  // Merge an untransformed copy and a translated, scaled copy
+  std::vector<uint8_t> vertexData;
+  std::vector<uint32_t> indices;
+  ASSERT_TRUE(AppendStaticMesh(mesh, glm::mat4(1.0f), vertexData, indices) == Status::kSuccess);
+  glm::mat4 worldTransf(2.0f);
+  worldTransf[3] = glm::vec4(10.0f, 0.0f, 0.0f, 1.0f);
+  ASSERT_TRUE(AppendStaticMesh(mesh, worldTransf, vertexData, indices) == Status::kSuccess);
+  ASSERT_TRUE(vertexData.size() == 2 * sizeof(vertices));
+  EXPECT_TRUE(indices == std::vector<uint32_t>({0, 1, 2, 3, 4, 5}));
+
+  // Positions are pre-transformed, normals stay unit length
+  float mergedVertices[36];
+  std::memcpy(mergedVertices, vertexData.data(), sizeof(mergedVertices));
+  EXPECT_FLOAT_EQ(mergedVertices[6], 1.0f);
+  EXPECT_FLOAT_EQ(mergedVertices[24], 12.0f);
+  EXPECT_FLOAT_EQ(mergedVertices[31], 2.0f);
+  EXPECT_FLOAT_EQ(mergedVertices[23], 1.0f);
+
+  // Only meshes with matching vertex formats can be merged
+  StaticMeshData otherMesh = mesh;
+  EXPECT_TRUE(IsStaticBatchCompatible(mesh, otherMesh));
+  otherMesh.normalOffset = flurr::NO_VERTEX_ATTRIBUTE;
+  EXPECT_FALSE(IsStaticBatchCompatible(mesh, otherMesh));
+  mesh.indices[0] = 3;
+  EXPECT_TRUE(AppendStaticMesh(mesh, glm::mat4(1.0f), vertexData, indices) == Status::kIndexOutOfBounds);
+}
+
 class TestResourceListener : public ResourceListener
 {
 public: